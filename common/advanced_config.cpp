@@ -75,6 +75,11 @@ static const wxChar ExtraFillMargin[] = wxT( "ExtraFillMargin" );
  */
 static const wxChar DRCEpsilon[] = wxT( "DRCEpsilon" );
 
+/**
+ * When set, the DRC engine collects per-rule evaluation counts and timings.
+ */
+static const wxChar DRCProfileRules[] = wxT( "DRCProfileRules" );
+
 /**
  * Used to calculate the actual hole size from the finish hole size.
  * IPC-6012 says 0.015-0.018mm; Cadence says at least 0.020mm for a Class 2 board and at least
@@ -155,6 +160,8 @@ static const wxChar MinPlotPenWidth[] = wxT( "MinPlotPenWidth" );
 
 static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
 
+static const wxChar ZoneFillVerifyConnectivity[] = wxT( "ZoneFillVerifyConnectivity" );
+
 static const wxChar DebugPDFWriter[] = wxT( "DebugPDFWriter" );
 
 /**
@@ -175,6 +182,18 @@ static const wxChar Skip3DModelMemoryCache[] = wxT( "Skip3DModelMemoryCache" );
 
 static const wxChar HideVersionFromTitle[] = wxT( "HideVersionFromTitle" );
 
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+
+static const wxChar ParallelBoardSave[] = wxT( "ParallelBoardSave" );
+
+static const wxChar ZoneFillCache[] = wxT( "ZoneFillCache" );
+
+static const wxChar FootprintLibIndex[] = wxT( "FootprintLibIndex" );
+
+static const wxChar ParallelSchematicLoad[] = wxT( "ParallelSchematicLoad" );
+
+static const wxChar LazySymbolLibs[] = wxT( "LazySymbolLibs" );
+
 static const wxChar TraceMasks[] = wxT( "TraceMasks" );
 
 } // namespace KEYS
@@ -267,6 +286,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_ExtraClearance            = 0.0001;
     m_DRCEpsilon                = 0.0001;   // 0.1um is small enough not to materially violate
                                             // any constraints.
+    m_DRCProfileRules           = false;
 
     m_HoleWallThickness         = 0.020;    // IPC-6012 says 15-18um; Cadence says at least
                                             // 0.020 for a Class 2 board and at least 0.025
@@ -275,6 +295,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_MinPlotPenWidth           = 0.0212;   // 1 pixel at 1200dpi.
 
     m_DebugZoneFiller           = false;
+    m_ZoneFillVerifyConnectivity = false;
     m_DebugPDFWriter            = false;
     m_SmallDrillMarkSize        = 0.35;
     m_HotkeysDumper             = false;
@@ -283,6 +304,12 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_Skip3DModelFileCache      = false;
     m_Skip3DModelMemoryCache    = false;
     m_HideVersionFromTitle      = false;
+    m_ParallelBoardLoad         = true;
+    m_ParallelBoardSave         = true;
+    m_ZoneFillCache             = false;
+    m_FootprintLibIndex         = true;
+    m_ParallelSchematicLoad     = true;
+    m_LazySymbolLibs            = true;
 
     loadFromConfigFile();
 }
@@ -334,6 +361,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::DRCEpsilon,
                                                   &m_DRCEpsilon, 0.0005, 0.0, 1.0 ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DRCProfileRules,
+                                                &m_DRCProfileRules, false ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::HoleWallThickness,
                                                   &m_HoleWallThickness, 0.020, 0.0, 1.0 ) );
 
@@ -371,6 +401,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugZoneFiller,
                                                 &m_DebugZoneFiller, false ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillVerifyConnectivity,
+                                                &m_ZoneFillVerifyConnectivity, false ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugPDFWriter,
                                                 &m_DebugPDFWriter, false ) );
 
@@ -395,6 +428,24 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::HideVersionFromTitle,
                                                 &m_HideVersionFromTitle, false ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardLoad,
+                                                &m_ParallelBoardLoad, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardSave,
+                                                &m_ParallelBoardSave, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillCache,
+                                                &m_ZoneFillCache, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::FootprintLibIndex,
+                                                &m_FootprintLibIndex, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelSchematicLoad,
+                                                &m_ParallelSchematicLoad, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazySymbolLibs,
+                                                &m_LazySymbolLibs, true ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks = "";
@@ -36,11 +36,14 @@
 
 #include <base_units.h>
 #include <common.h>
+#include <locale_io.h>
 #include <string_utils.h>
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
 #include <title_block.h>
 
+#include <cmath>
+
 #if defined( PCBNEW ) || defined( CVPCB ) || defined( EESCHEMA ) || defined( GERBVIEW ) || defined( PL_EDITOR )
 #define IU_TO_MM( x )       ( x / IU_PER_MM )
 #define IU_TO_IN( x )       ( x / IU_PER_MILS / 1000 )
@@ -482,47 +485,107 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS aUnit, EDA_DATA_TYPE aType )
 }
 
 
-std::string FormatInternalUnits( int aValue )
+/**
+ * Append the decimal representation of \a aValue internal units in mm to \a aResult.
+ *
+ * IU_PER_MM is a power of ten for every application, so the value can be split into whole
+ * and fractional millimeters with integer math.  Trailing zeros of the fraction are dropped,
+ * which gives exactly what the former "%.10g" (or "%.10f" for tiny values) printf formats
+ * produced for any int, without going through the C library.
+ */
+static void appendInternalUnits( std::string& aResult, int aValue )
 {
-    char    buf[50];
-    double  engUnits = aValue;
-    int     len;
+    const long long iuPerMm = static_cast<long long>( IU_PER_MM );
 
-    engUnits /= IU_PER_MM;
+    char  buf[32];
+    char* end = buf + sizeof( buf );
+    char* p = end;
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
-    {
-        len = snprintf( buf, sizeof(buf), "%.10f", engUnits );
+    // Widen before negating so INT_MIN is handled.
+    unsigned long long value = aValue < 0 ? -static_cast<long long>( aValue ) : aValue;
+    unsigned long long whole = value / iuPerMm;
+    unsigned long long frac = value % iuPerMm;
 
-        // Make sure snprintf() didn't fail and the locale numeric separator is correct.
-        wxCHECK( len >= 0 && len < 50 && strchr( buf, ',' ) == nullptr, std::string( "" ) );
+    if( frac )
+    {
+        bool significant = false;
 
-        while( --len > 0 && buf[len] == '0' )
-            buf[len] = '\0';
+        for( long long digits = iuPerMm; digits > 1; digits /= 10 )
+        {
+            int digit = static_cast<int>( frac % 10 );
+            frac /= 10;
+
+            if( digit || significant )
+            {
+                *--p = '0' + digit;
+                significant = true;
+            }
+        }
 
-        if( buf[len] == '.' )
-            buf[len] = '\0';
-        else
-            ++len;
+        *--p = '.';
     }
-    else
+
+    do
     {
-        len = snprintf( buf, sizeof(buf), "%.10g", engUnits );
+        *--p = '0' + static_cast<int>( whole % 10 );
+        whole /= 10;
+    } while( whole );
 
-        // Make sure snprintf() didn't fail and the locale numeric separator is correct.
-        wxCHECK( len >= 0 && len < 50 && strchr( buf, ',' ) == nullptr , std::string( "" ) );
-    }
+    if( aValue < 0 )
+        *--p = '-';
 
-    return std::string( buf, len );
+    aResult.append( p, end );
+}
+
+
+std::string FormatInternalUnits( int aValue )
+{
+    std::string result;
+
+    appendInternalUnits( result, aValue );
+
+    return result;
 }
 
 
 std::string FormatAngle( double aAngle )
 {
+    // Angles are stored in tenths of a degree and nearly always integral, in which case the
+    // result is at most one decimal and does not need printf.
+    if( aAngle == std::trunc( aAngle ) && std::fabs( aAngle ) < 1e9
+            && !( aAngle == 0.0 && std::signbit( aAngle ) ) )
+    {
+        long long angle = static_cast<long long>( aAngle );
+        unsigned long long value = angle < 0 ? -angle : angle;
+        char  buf[32];
+        char* end = buf + sizeof( buf );
+        char* p = end;
+
+        int tenths = static_cast<int>( value % 10 );
+        value /= 10;
+
+        if( tenths )
+        {
+            *--p = '0' + tenths;
+            *--p = '.';
+        }
+
+        do
+        {
+            *--p = '0' + static_cast<int>( value % 10 );
+            value /= 10;
+        } while( value );
+
+        if( angle < 0 )
+            *--p = '-';
+
+        return std::string( p, end );
+    }
+
     char temp[50];
     int len;
 
-    len = snprintf( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
+    len = SnprintfC( temp, sizeof(temp), "%.10g", aAngle / 10.0 );
 
     return std::string( temp, len );
 }
@@ -530,17 +593,38 @@ std::string FormatAngle( double aAngle )
 
 std::string FormatInternalUnits( const wxPoint& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    std::string result;
+
+    result.reserve( 32 );
+    appendInternalUnits( result, aPoint.x );
+    result += ' ';
+    appendInternalUnits( result, aPoint.y );
+
+    return result;
 }
 
 
 std::string FormatInternalUnits( const VECTOR2I& aPoint )
 {
-    return FormatInternalUnits( aPoint.x ) + " " + FormatInternalUnits( aPoint.y );
+    std::string result;
+
+    result.reserve( 32 );
+    appendInternalUnits( result, aPoint.x );
+    result += ' ';
+    appendInternalUnits( result, aPoint.y );
+
+    return result;
 }
 
 
 std::string FormatInternalUnits( const wxSize& aSize )
 {
-    return FormatInternalUnits( aSize.GetWidth() ) + " " + FormatInternalUnits( aSize.GetHeight() );
+    std::string result;
+
+    result.reserve( 32 );
+    appendInternalUnits( result, aSize.GetWidth() );
+    result += ' ';
+    appendInternalUnits( result, aSize.GetHeight() );
+
+    return result;
 }
@@ -817,7 +817,7 @@ double DRAWING_SHEET_PARSER::parseDouble()
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    double val = strtod( CurText(), NULL );
+    double val = StrToDoubleC( CurText() );
 
     return val;
 }
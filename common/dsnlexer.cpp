@@ -612,7 +612,7 @@ L_read:
         // a quoted string, will return DSN_STRING
         if( *cur == stringDelimiter )
         {
-            // copy the token, character by character so we can remove doubled up quotes.
+            // copy the token, unescaping as we go.
             curText.clear();
 
             ++cur;  // skip over the leading delimiter, which is always " in non-specctraMode
@@ -644,7 +644,7 @@ L_read:
                     case 'v':   c = '\x0b';     break;
 
                     case 'x':   // 1 or 2 byte hex escape sequence
-                        for( i = 0; i < 2; ++i )
+                        for( i = 0; i < 2 && head + i < limit; ++i )
                         {
                             if( !isxdigit( head[i] ) )
                                 break;
@@ -665,7 +665,7 @@ L_read:
                     default:    // 1-3 byte octal escape sequence
                         --head;
 
-                        for( i=0; i<3; ++i )
+                        for( i=0; i<3 && head + i < limit; ++i )
                         {
                             if( head[i] < '0' || head[i] > '7' )
                                 break;
@@ -695,7 +695,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy up to the next escape or delimiter in one go
+                    const char* run = head;
+
+                    while( head<limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -776,11 +784,12 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
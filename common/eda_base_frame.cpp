@@ -120,6 +120,7 @@ void EDA_BASE_FRAME::commonInit( FRAME_T aFrameType )
     m_autoSaveState     = false;
     m_autoSaveInterval  = -1;
     m_undoRedoCountMax  = DEFAULT_MAX_UNDO_ITEMS;
+    m_undoRedoMemoryMax = DEFAULT_MAX_UNDO_MEMORY_MB * 1024 * 1024;
     m_userUnits         = EDA_UNITS::MILLIMETRES;
     m_isClosing         = false;
     m_isNonUserClose    = false;
@@ -758,6 +759,8 @@ void EDA_BASE_FRAME::LoadSettings( APP_SETTINGS_BASE* aCfg )
     m_fileHistory = new FILE_HISTORY( (unsigned) std::max( 0, fileHistorySize ),
                                       ID_FILE1, ID_FILE_LIST_CLEAR );
     m_fileHistory->Load( *aCfg );
+
+    m_undoRedoMemoryMax = (size_t) std::max( 0, aCfg->m_System.max_undo_memory ) * 1024 * 1024;
 }
 
 
@@ -785,6 +788,8 @@ void EDA_BASE_FRAME::SaveSettings( APP_SETTINGS_BASE* aCfg )
 
         m_fileHistory->Save( *aCfg );
     }
+
+    aCfg->m_System.max_undo_memory = (int) ( m_undoRedoMemoryMax / ( 1024 * 1024 ) );
 }
 
 
@@ -1139,31 +1144,79 @@ void EDA_BASE_FRAME::ClearUndoRedoList()
 
 void EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
 {
+    // Commands are re-pushed after being amended, so the estimate is refreshed on each push
+    aNewitem->SetEstimatedSize( EstimateUndoCommandSize( *aNewitem ) );
+
     m_undoList.PushCommand( aNewitem );
 
-    // Delete the extra items, if count max reached
-    if( m_undoRedoCountMax > 0 )
+    // Delete the extra items, if count max or memory budget reached
+    trimUndoRedoList( UNDO_LIST );
+}
+
+
+void EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
+{
+    // Commands are re-pushed after being amended, so the estimate is refreshed on each push
+    aNewitem->SetEstimatedSize( EstimateUndoCommandSize( *aNewitem ) );
+
+    m_redoList.PushCommand( aNewitem );
+
+    // Delete the extra items, if count max or memory budget reached
+    trimUndoRedoList( REDO_LIST );
+}
+
+
+size_t EDA_BASE_FRAME::EstimateUndoCommandSize( const PICKED_ITEMS_LIST& aCommand ) const
+{
+    // A picker and, for changed items, a copy of the item.  Deleted items are owned by the
+    // command too.  Items are typically a few hundred bytes.
+    const size_t itemCost = 512;
+    size_t       size = sizeof( PICKED_ITEMS_LIST ) + aCommand.GetCount() * sizeof( ITEM_PICKER );
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ++ii )
     {
-        int extraitems = GetUndoCommandCount() - m_undoRedoCountMax;
+        if( aCommand.GetPickedItemLink( ii ) )
+            size += itemCost;
 
-        if( extraitems > 0 )
-            ClearUndoORRedoList( UNDO_LIST, extraitems );
+        if( aCommand.GetPickedItemStatus( ii ) == UNDO_REDO::DELETED
+                && aCommand.GetPickedItem( ii ) )
+        {
+            size += itemCost;
+        }
     }
+
+    return size;
 }
 
 
-void EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aNewitem )
+void EDA_BASE_FRAME::trimUndoRedoList( UNDO_REDO_LIST aList )
 {
-    m_redoList.PushCommand( aNewitem );
+    UNDO_REDO_CONTAINER& list = aList == UNDO_LIST ? m_undoList : m_redoList;
+    int                  extraitems = 0;
 
-    // Delete the extra items, if count max reached
     if( m_undoRedoCountMax > 0 )
+        extraitems = std::max( 0, (int) list.m_CommandsList.size() - m_undoRedoCountMax );
+
+    if( m_undoRedoMemoryMax > 0 )
     {
-        int extraitems = GetRedoCommandCount() - m_undoRedoCountMax;
+        size_t total = 0;
+
+        // Walk from the newest command back, and drop everything older than the command
+        // which exceeds the budget.  The newest command is always kept.
+        for( int ii = (int) list.m_CommandsList.size() - 1; ii > extraitems; --ii )
+        {
+            total += list.m_CommandsList[ii]->GetEstimatedSize();
 
-        if( extraitems > 0 )
-            ClearUndoORRedoList( REDO_LIST, extraitems );
+            if( total > m_undoRedoMemoryMax )
+            {
+                extraitems = ii;
+                break;
+            }
+        }
     }
+
+    if( extraitems > 0 )
+        ClearUndoORRedoList( aList, extraitems );
 }
 
 
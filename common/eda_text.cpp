@@ -28,6 +28,7 @@
  */
 
 #include <algorithm>          // for max
+#include <mutex>
 #include <stddef.h>           // for NULL
 #include <type_traits>        // for swap
 #include <vector>             // for vector
@@ -201,8 +202,14 @@ void EDA_TEXT::cacheShownText()
 }
 
 
+// basic_gal is shared by all texts, and items are measured from several loader threads
+static std::mutex s_basicGalMutex;
+
+
 int EDA_TEXT::LenSize( const wxString& aLine, int aThickness ) const
 {
+    std::lock_guard<std::mutex> lock( s_basicGalMutex );
+
     basic_gal.SetFontItalic( IsItalic() );
     basic_gal.SetFontBold( IsBold() );
     basic_gal.SetFontUnderlined( false );
@@ -275,9 +282,14 @@ EDA_RECT EDA_TEXT::GetTextBox( int aLine, bool aInvertY ) const
     const auto& font = basic_gal.GetStrokeFont();
     VECTOR2D    fontSize( GetTextSize() );
     double      penWidth( thickness );
-    int         dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth ).x );
+    int         dx;
     int         dy = GetInterline();
 
+    {
+        std::lock_guard<std::mutex> lock( s_basicGalMutex );
+        dx = KiROUND( font.ComputeStringBoundaryLimits( text, fontSize, penWidth ).x );
+    }
+
     // Creates bounding box (rectangle) for horizontal, left and top justified text. The
     // bounding box will be moved later according to the actual text options
     wxSize textsize = wxSize( dx, dy );
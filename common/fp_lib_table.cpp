@@ -348,6 +348,19 @@ const FOOTPRINT* FP_LIB_TABLE::GetEnumeratedFootprint( const wxString& aNickname
 }
 
 
+bool FP_LIB_TABLE::GetFootprintInfo( const wxString& aNickname, const wxString& aFootprintName,
+                                     unsigned& aPadCount, unsigned& aUniquePadCount,
+                                     wxString& aKeywords, wxString& aDoc )
+{
+    const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+    wxASSERT( (PLUGIN*) row->plugin );
+
+    return row->plugin->GetFootprintInfo( row->GetFullURI( true ), aFootprintName, aPadCount,
+                                          aUniquePadCount, aKeywords, aDoc,
+                                          row->GetProperties() );
+}
+
+
 bool FP_LIB_TABLE::FootprintExists( const wxString& aNickname, const wxString& aFootprintName )
 {
     try
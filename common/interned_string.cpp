@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <interned_string.h>
+
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+
+/// A power of two, so the shard is picked by masking the hash.
+static const size_t SHARD_COUNT = 64;
+
+
+template <typename STRING>
+struct INTERNED<STRING>::SHARD
+{
+    std::mutex m_mutex;
+
+    // Node-based, so entries never move while strings point to them
+    std::unordered_map<std::string, ENTRY> m_entries;
+};
+
+
+static std::string poolKey( const wxString& aString )
+{
+    return std::string( aString.utf8_str() );
+}
+
+
+static const std::string& poolKey( const UTF8& aString )
+{
+    return aString;
+}
+
+
+template <typename STRING>
+typename INTERNED<STRING>::SHARD& INTERNED<STRING>::shard( const std::string& aKey )
+{
+    // Never destroyed: static strings may release their entries after they would have been
+    static SHARD* shards = new SHARD[SHARD_COUNT];
+
+    return shards[ std::hash<std::string>()( aKey ) & ( SHARD_COUNT - 1 ) ];
+}
+
+
+template <typename STRING>
+const STRING& INTERNED<STRING>::emptyString()
+{
+    static const STRING empty;
+    return empty;
+}
+
+
+template <typename STRING>
+typename INTERNED<STRING>::ENTRY* INTERNED<STRING>::acquire( const STRING& aString )
+{
+    // Empty strings are by far the most common; don't take a lock for them
+    if( aString.empty() )
+        return nullptr;
+
+    const std::string&          key = poolKey( aString );
+    SHARD&                      strings = shard( key );
+    std::lock_guard<std::mutex> lock( strings.m_mutex );
+
+    auto it = strings.m_entries.find( key );
+
+    if( it == strings.m_entries.end() )
+    {
+        it = strings.m_entries.emplace( std::piecewise_construct,
+                                        std::forward_as_tuple( key ),
+                                        std::forward_as_tuple( aString, &strings ) ).first;
+        it->second.m_key = &it->first;
+    }
+
+    it->second.m_refCount.fetch_add( 1, std::memory_order_relaxed );
+    return &it->second;
+}
+
+
+template <typename STRING>
+void INTERNED<STRING>::release( ENTRY* aEntry )
+{
+    if( !aEntry )
+        return;
+
+    // Dropping a reference which is not the last one needs no lock.  The last one is dropped
+    // under the lock so acquire() cannot hand out the entry while it is being erased.
+    int refCount = aEntry->m_refCount.load( std::memory_order_relaxed );
+
+    while( refCount > 1 )
+    {
+        if( aEntry->m_refCount.compare_exchange_weak( refCount, refCount - 1,
+                                                      std::memory_order_acq_rel ) )
+        {
+            return;
+        }
+    }
+
+    SHARD&                      strings = *aEntry->m_shard;
+    std::lock_guard<std::mutex> lock( strings.m_mutex );
+
+    if( aEntry->m_refCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+        strings.m_entries.erase( strings.m_entries.find( *aEntry->m_key ) );
+}
+
+
+template class INTERNED<wxString>;
+template class INTERNED<UTF8>;
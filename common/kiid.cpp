@@ -36,8 +36,9 @@
 #include <wx/log.h>
 
 
-// Create only once, as seeding is *very* expensive
-static boost::uuids::random_generator randomGenerator;
+// Create only once per thread, as seeding is *very* expensive (and a generator can't be shared
+// between threads, which may construct items concurrently when loading files)
+static thread_local boost::uuids::random_generator randomGenerator;
 
 // These don't have the same performance penalty, but might as well be consistent
 static boost::uuids::string_generator stringGenerator;
@@ -41,8 +41,8 @@ static inline int okLogical( const UTF8& aField )
 
 void LIB_ID::clear()
 {
-    m_libraryName.clear();
-    m_itemName.clear();
+    m_libraryName = INTERNED_UTF8();
+    m_itemName = INTERNED_UTF8();
 }
 
 
@@ -88,8 +88,8 @@ int LIB_ID::Parse( const UTF8& aId, bool aFix )
 
 
 LIB_ID::LIB_ID( const wxString& aLibraryName, const wxString& aItemName ) :
-        m_libraryName( aLibraryName ),
-        m_itemName( aItemName )
+        m_libraryName( UTF8( aLibraryName ) ),
+        m_itemName( UTF8( aItemName ) )
 {
 }
 
@@ -117,13 +117,13 @@ UTF8 LIB_ID::Format() const
 {
     UTF8    ret;
 
-    if( m_libraryName.size() )
+    if( !m_libraryName.IsEmpty() )
     {
-        ret += m_libraryName;
+        ret += m_libraryName.Get();
         ret += ':';
     }
 
-    ret += m_itemName;
+    ret += m_itemName.Get();
 
     return ret;
 }
@@ -161,12 +161,16 @@ int LIB_ID::compare( const LIB_ID& aLibId ) const
     if( this == &aLibId )
         return 0;
 
-    int retv = m_libraryName.compare( aLibId.m_libraryName );
+    // Interned names are equal when they share their pool entry.
+    if( m_libraryName == aLibId.m_libraryName && m_itemName == aLibId.m_itemName )
+        return 0;
+
+    int retv = m_libraryName.Get().compare( aLibId.m_libraryName.Get() );
 
     if( retv != 0 )
         return retv;
 
-    return m_itemName.compare( aLibId.m_itemName );
+    return m_itemName.Get().compare( aLibId.m_itemName.Get() );
 }
 
 
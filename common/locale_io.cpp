@@ -23,7 +23,15 @@
 
 #include <locale_io.h>
 #include <wx/intl.h>
+#include <algorithm>
 #include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <locale.h>
+
+#if defined( __APPLE__ ) || defined( __FreeBSD__ )
+#include <xlocale.h>
+#endif
 
 // When reading/writing files, we need to swtich to setlocale( LC_NUMERIC, "C" ).
 // Works fine to read/write files with floating point numbers.
@@ -115,3 +123,69 @@ LOCALE_IO::~LOCALE_IO()
 #endif
     }
 }
+
+
+// The "C" locale, used through the *_l() functions and uselocale(), which only affect the
+// calling thread (or call), instead of setlocale() which affects the whole process.
+#if defined( _WIN32 )
+static _locale_t cLocale()
+{
+    static _locale_t locale = _create_locale( LC_ALL, "C" );
+    return locale;
+}
+#else
+static locale_t cLocale()
+{
+    static locale_t locale = newlocale( LC_ALL_MASK, "C", (locale_t) 0 );
+    return locale;
+}
+#endif
+
+
+double StrToDoubleC( const char* aStr, char** aEndPtr )
+{
+#if defined( _WIN32 )
+    return _strtod_l( aStr, aEndPtr, cLocale() );
+#else
+    return strtod_l( aStr, aEndPtr, cLocale() );
+#endif
+}
+
+
+int VsnprintfC( char* aBuf, size_t aSize, const char* aFormat, va_list aArgs )
+{
+#if defined( _WIN32 )
+    // _vsnprintf_l() returns -1 instead of the needed length when the output is truncated,
+    // and doesn't nul-terminate it
+    va_list tmp;
+    va_copy( tmp, aArgs );
+    int len = _vscprintf_l( aFormat, cLocale(), tmp );
+    va_end( tmp );
+
+    if( aSize > 0 )
+    {
+        _vsnprintf_l( aBuf, aSize, aFormat, cLocale(), aArgs );
+        aBuf[ std::min( (size_t) std::max( len, 0 ), aSize - 1 ) ] = '\0';
+    }
+
+    return len;
+#else
+    locale_t previous = uselocale( cLocale() );
+    int      len = vsnprintf( aBuf, aSize, aFormat, aArgs );
+
+    uselocale( previous );
+    return len;
+#endif
+}
+
+
+int SnprintfC( char* aBuf, size_t aSize, const char* aFormat, ... )
+{
+    va_list args;
+
+    va_start( args, aFormat );
+    int len = VsnprintfC( aBuf, aSize, aFormat, args );
+    va_end( args );
+
+    return len;
+}
@@ -23,15 +23,29 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <ignore.h>
 #include <richio.h>
+#include <locale_io.h>
 #include <errno.h>
 
 #include <wx/file.h>
 #include <wx/translation.h>
+#include <wx/wfstream.h>
+#include <wx/zstream.h>
+
+#ifdef __WINDOWS__
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 
 // Fall back to getc() when getc_unlocked() is not available on the target platform.
@@ -51,7 +65,7 @@ static int vprint( std::string* result, const char* format, va_list ap )
     va_list tmp;
     va_copy( tmp, ap );
 
-    size_t  len = vsnprintf( msg, sizeof(msg), format, ap );
+    size_t  len = VsnprintfC( msg, sizeof(msg), format, ap );
 
     if( len < sizeof(msg) )     // the output fit into msg
     {
@@ -65,7 +79,7 @@ static int vprint( std::string* result, const char* format, va_list ap )
         std::vector<char>   buf;
         buf.reserve( len+1 );   // reserve(), not resize() which writes. +1 for trailing nul.
 
-        len = vsnprintf( &buf[0], len+1, format, tmp );
+        len = VsnprintfC( &buf[0], len+1, format, tmp );
 
         result->append( &buf[0], &buf[0] + len );
     }
@@ -245,6 +259,260 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+    LINE_READER( 0 ),       // no line buffer: lines point into the mapping
+    m_data( nullptr ),
+    m_size( 0 ),
+    m_pos( 0 ),
+    m_mapping( nullptr )
+{
+    m_source = aFileName;
+    m_maxLineLength = aMaxLineLength;
+
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    bool mapped = false;
+
+#ifdef __WINDOWS__
+    struct _stati64 st;
+
+    if( _fstati64( _fileno( fp ), &st ) == 0 )
+    {
+        m_size = (size_t) st.st_size;
+
+        if( m_size == 0 )
+        {
+            mapped = true;
+        }
+        else
+        {
+            HANDLE file = (HANDLE) _get_osfhandle( _fileno( fp ) );
+            HANDLE mapping = CreateFileMapping( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+            if( mapping )
+            {
+                m_data = (const char*) MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+
+                if( m_data )
+                {
+                    m_mapping = mapping;
+                    mapped = true;
+                }
+                else
+                {
+                    CloseHandle( mapping );
+                }
+            }
+        }
+    }
+#else
+    struct stat st;
+
+    if( fstat( fileno( fp ), &st ) == 0 )
+    {
+        m_size = (size_t) st.st_size;
+
+        if( m_size == 0 )
+        {
+            mapped = true;
+        }
+        else
+        {
+            void* data = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fileno( fp ), 0 );
+
+            if( data != MAP_FAILED )
+            {
+                madvise( data, m_size, MADV_SEQUENTIAL );
+                m_data = (const char*) data;
+                mapped = true;
+            }
+        }
+    }
+#endif
+
+    // The mapping keeps its own reference to the file
+    fclose( fp );
+
+    if( !mapped )
+    {
+        wxString msg = wxString::Format( _( "Unable to read %s." ), aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    if( m_data )
+    {
+#ifdef __WINDOWS__
+        UnmapViewOfFile( m_data );
+        CloseHandle( (HANDLE) m_mapping );
+#else
+        munmap( const_cast<char*>( m_data ), m_size );
+#endif
+    }
+
+    // m_line points into the mapping, it's not ours to delete
+    m_line = nullptr;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    const char* line = m_data + m_pos;
+    size_t      length = m_size - m_pos;
+
+    if( length )
+    {
+        const char* eol = (const char*) memchr( line, '\n', length );
+
+        if( eol )
+            length = eol + 1 - line;
+    }
+
+    if( length > m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    m_line = const_cast<char*>( line );
+    m_length = (unsigned) length;
+    m_pos += length;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+/// Size of the blocks a #GZIP_FILE_LINE_READER decompresses at a time.
+#define GZIP_BLOCK_SIZE     ( 256 * 1024 )
+
+
+GZIP_FILE_LINE_READER::GZIP_FILE_LINE_READER( const wxString& aFileName,
+                                              unsigned aMaxLineLength ) :
+    LINE_READER( aMaxLineLength ),
+    m_block( GZIP_BLOCK_SIZE ),
+    m_blockPos( 0 ),
+    m_blockEnd( 0 )
+{
+    m_source = aFileName;
+
+    open();
+}
+
+
+GZIP_FILE_LINE_READER::~GZIP_FILE_LINE_READER()
+{
+    // The decompressor must go before the file it reads from.
+    m_stream.reset();
+}
+
+
+void GZIP_FILE_LINE_READER::open()
+{
+    m_stream.reset();
+    m_file = std::make_unique<wxFFileInputStream>( m_source, wxT( "rb" ) );
+
+    if( !m_file->IsOk() )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         m_source.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_stream = std::make_unique<wxZlibInputStream>( *m_file, wxZLIB_GZIP );
+    m_blockPos = 0;
+    m_blockEnd = 0;
+}
+
+
+void GZIP_FILE_LINE_READER::Rewind()
+{
+    open();
+    m_lineNum = 0;
+}
+
+
+char* GZIP_FILE_LINE_READER::ReadLine()
+{
+    m_length = 0;
+
+    for( ;; )
+    {
+        if( m_blockPos == m_blockEnd )
+        {
+            m_stream->Read( m_block.data(), m_block.size() );
+            m_blockPos = 0;
+            m_blockEnd = m_stream->LastRead();
+
+            if( m_stream->GetLastError() == wxSTREAM_READ_ERROR )
+            {
+                wxString msg = wxString::Format( _( "Error decompressing %s." ),
+                                                 m_source.GetData() );
+                THROW_IO_ERROR( msg );
+            }
+
+            if( m_blockEnd == 0 )
+                break;
+        }
+
+        const char* start = &m_block[m_blockPos];
+        size_t      count = m_blockEnd - m_blockPos;
+        const char* eol = (const char*) memchr( start, '\n', count );
+
+        if( eol )
+            count = eol + 1 - start;
+
+        if( m_length + count > m_maxLineLength )
+            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+        if( m_length + count + 1 > m_capacity )
+            expandCapacity( std::max<unsigned>( m_capacity * 2, m_length + count + 1 ) );
+
+        memcpy( m_line + m_length, start, count );
+        m_length += count;
+        m_blockPos += count;
+
+        if( eol )
+            break;
+    }
+
+    m_line[ m_length ] = 0;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+bool GZIP_FILE_LINE_READER::IsGzipFile( const wxString& aFileName )
+{
+    FILE* fp = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( !fp )
+        return false;
+
+    unsigned char magic[2] = { 0, 0 };
+    bool          isGzip = fread( magic, 1, 2, fp ) == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+
+    fclose( fp );
+
+    return isGzip;
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -394,12 +662,12 @@ int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
     // we make a copy of va_list ap for the second call, if happens
     va_list tmp;
     va_copy( tmp, ap );
-    int ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, ap );
+    int ret = VsnprintfC( &m_buffer[0], m_buffer.size(), fmt, ap );
 
     if( ret >= (int) m_buffer.size() )
     {
         m_buffer.resize( ret + 1000 );
-        ret = vsnprintf( &m_buffer[0], m_buffer.size(), fmt, tmp );
+        ret = VsnprintfC( &m_buffer[0], m_buffer.size(), fmt, tmp );
     }
 
     va_end( tmp );      // Release the temporary va_list, initialised from ap
@@ -411,18 +679,6 @@ int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
 }
 
 
-int OUTPUTFORMATTER::sprint( const char* fmt, ... )
-{
-    va_list args;
-
-    va_start( args, fmt );
-    int ret = vprint( fmt, args);
-    va_end( args );
-
-    return ret;
-}
-
-
 int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 {
 #define NESTWIDTH           2   ///< how many spaces per nestLevel
@@ -431,19 +687,31 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 
     va_start( args, fmt );
 
+    static const char spaces[] = "                                ";
+
     int result = 0;
     int total  = 0;
 
-    for( int i = 0; i < nestLevel; ++i )
+    // no error checking needed, an exception indicates an error.
+    for( int remaining = nestLevel * NESTWIDTH; remaining > 0; remaining -= result )
     {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
-
+        result = std::min( remaining, (int) sizeof( spaces ) - 1 );
+        write( spaces, result );
         total += result;
     }
 
-    // no error checking needed, an exception indicates an error.
-    result = vprint( fmt, args );
+    // A format without conversions is written as is, saving the trip through vsnprintf.
+    if( !strchr( fmt, '%' ) )
+    {
+        result = (int) strlen( fmt );
+
+        if( result > 0 )
+            write( fmt, result );
+    }
+    else
+    {
+        result = vprint( fmt, args );
+    }
 
     va_end( args );
 
@@ -452,6 +720,13 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 }
 
 
+void OUTPUTFORMATTER::Write( const std::string& aText )
+{
+    if( !aText.empty() )
+        write( aText.data(), (int) aText.size() );
+}
+
+
 std::string OUTPUTFORMATTER::Quotes( const std::string& aWrapee ) const
 {
     std::string ret;
@@ -534,6 +809,9 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // Saves are made of many small writes; a large stdio buffer keeps them out of the kernel.
+    setvbuf( m_fp, nullptr, _IOFBF, OUTPUTFMT_FILE_BUFFER_SIZE );
 }
 
 
@@ -544,6 +822,26 @@ FILE_OUTPUTFORMATTER::~FILE_OUTPUTFORMATTER()
 }
 
 
+void FILE_OUTPUTFORMATTER::Finish()
+{
+    if( !m_fp )
+        return;
+
+    int error = fflush( m_fp ) == 0 ? 0 : errno;
+
+    if( fclose( m_fp ) != 0 && !error )
+        error = errno;
+
+    m_fp = nullptr;
+
+    if( error )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Error writing %s: %s" ), m_filename,
+                                          strerror( error ) ) );
+    }
+}
+
+
 void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
     if( fwrite( aOutBuf, (unsigned) aCount, 1, m_fp ) != 1 )
@@ -551,6 +849,69 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 }
 
 
+GZIP_FILE_OUTPUTFORMATTER::GZIP_FILE_OUTPUTFORMATTER( const wxString& aFileName,
+                                                      char aQuoteChar ) :
+    OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+    m_filename( aFileName )
+{
+    m_file = std::make_unique<wxFFileOutputStream>( aFileName, wxT( "wb" ) );
+
+    if( !m_file->IsOk() )
+        THROW_IO_ERROR( strerror( errno ) );
+
+    // Board and schematic files are written on every save and autosave, so favor speed over
+    // size.  Their text is regular enough to still shrink several times over.
+    m_stream = std::make_unique<wxZlibOutputStream>( *m_file, wxZ_BEST_SPEED, wxZLIB_GZIP );
+}
+
+
+GZIP_FILE_OUTPUTFORMATTER::~GZIP_FILE_OUTPUTFORMATTER()
+{
+    // Flush the compressor into the file before closing it.
+    if( m_stream )
+        m_stream->Close();
+
+    m_stream.reset();
+
+    if( m_file )
+        m_file->Close();
+}
+
+
+void GZIP_FILE_OUTPUTFORMATTER::Finish()
+{
+    if( !m_file )
+        return;
+
+    bool ok = m_stream->Close();
+
+    m_stream.reset();
+    ok = m_file->Close() && ok;
+    m_file.reset();
+
+    if( !ok )
+        THROW_IO_ERROR( wxString::Format( _( "Error writing %s." ), m_filename ) );
+}
+
+
+bool GZIP_FILE_OUTPUTFORMATTER::IsGzipFileName( const wxString& aFileName )
+{
+    wxString name = aFileName.Lower();
+
+    if( name.EndsWith( wxT( "$" ) ) )
+        name.RemoveLast();
+
+    return name.EndsWith( wxT( ".gz" ) );
+}
+
+
+void GZIP_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
+{
+    if( m_stream->Write( aOutBuf, aCount ).LastWrite() != (size_t) aCount )
+        THROW_IO_ERROR( wxString::Format( _( "Error writing %s." ), m_filename ) );
+}
+
+
 void STREAM_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
     int lastWrite;
@@ -114,6 +114,9 @@ APP_SETTINGS_BASE::APP_SETTINGS_BASE( const std::string& aFilename, int aSchemaV
     m_params.emplace_back( new PARAM<int>( "system.max_undo_items",
             &m_System.max_undo_items, 0 ) );
 
+    m_params.emplace_back( new PARAM<int>( "system.max_undo_memory",
+            &m_System.max_undo_memory, DEFAULT_MAX_UNDO_MEMORY_MB ) );
+
 
     m_params.emplace_back( new PARAM_LIST<wxString>( "system.file_history",
             &m_System.file_history, {} ) );
@@ -29,6 +29,7 @@
 #include <clocale>
 #include <cmath>
 #include <macros.h>
+#include <locale_io.h>
 #include <richio.h>                        // StrPrintf
 #include <string_utils.h>
 
@@ -1056,7 +1057,7 @@ std::string Double2Str( double aValue )
     {
         // For these small values, %f works fine,
         // and %g gives an exponent
-        len = sprintf( buf,  "%.16f", aValue );
+        len = SnprintfC( buf, sizeof( buf ), "%.16f", aValue );
 
         while( --len > 0 && buf[len] == '0' )
             buf[len] = '\0';
@@ -1070,7 +1071,7 @@ std::string Double2Str( double aValue )
     {
         // For these values, %g works fine, and sometimes %f
         // gives a bad value (try aValue = 1.222222222222, with %.16f format!)
-        len = sprintf( buf, "%.10g", aValue );
+        len = SnprintfC( buf, sizeof( buf ), "%.10g", aValue );
     }
 
     return std::string( buf, len );
@@ -54,7 +54,8 @@ void ITEM_PICKER::SetItem( EDA_ITEM* aItem )
 }
 
 
-PICKED_ITEMS_LIST::PICKED_ITEMS_LIST()
+PICKED_ITEMS_LIST::PICKED_ITEMS_LIST() :
+        m_estimatedSize( 0 )
 {
 }
 
@@ -30,6 +30,7 @@
 #include <regex>
 #include <wildcards_and_files_ext.h>
 #include <wx/filedlg.h>
+#include <wx/filename.h>
 #include <wx/regex.h>
 #include <wx/translation.h>
 
@@ -141,6 +142,7 @@ const std::string EquFileExtension( "equ" );
 const std::string HotkeyFileExtension( "hotkeys" );
 
 const std::string ArchiveFileExtension( "zip" );
+const std::string GzipFileExtension( "gz" );
 
 const std::string LegacyPcbFileExtension( "brd" );
 const std::string KiCadPcbFileExtension( "kicad_pcb" );
@@ -178,6 +180,18 @@ bool IsProtelExtension( const wxString& ext )
 }
 
 
+wxString ChangeFileExtension( const wxString& aFileName, const std::string& aExtension )
+{
+    wxFileName fn( aFileName );
+
+    if( fn.GetExt().CmpNoCase( GzipFileExtension ) == 0 )
+        fn.SetFullName( fn.GetName() );
+
+    fn.SetExt( aExtension );
+    return fn.GetFullPath();
+}
+
+
 wxString AllFilesWildcard()
 {
     return _( "All files" ) + AddFileExtListToFilter( {} );
@@ -334,6 +348,13 @@ wxString PcbFileWildcard()
 }
 
 
+wxString CompressedPcbFileWildcard()
+{
+    return _( "Compressed KiCad printed circuit board files" ) +
+           AddFileExtListToFilter( { KiCadPcbFileExtension + "." + GzipFileExtension } );
+}
+
+
 wxString KiCadFootprintLibFileWildcard()
 {
     return _( "KiCad footprint files" )
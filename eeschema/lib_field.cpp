@@ -391,7 +391,7 @@ void LIB_FIELD::SetName( const wxString& aName )
         return;
     }
 
-    if( m_name != aName )
+    if( m_name.Get() != aName )
     {
         m_name = aName;
         SetModified();
@@ -30,6 +30,7 @@
 #define CLASS_LIBENTRY_FIELDS_H
 
 #include <eda_text.h>
+#include <interned_string.h>
 #include <lib_item.h>
 
 
@@ -206,8 +207,8 @@ private:
 
     friend class SCH_LEGACY_PLUGIN_CACHE;   // Required to access m_name.
 
-    int      m_id;           ///< @see enum MANDATORY_FIELD_T
-    wxString m_name;         ///< Name (not the field text value itself, that is .m_Text)
+    int             m_id;    ///< @see enum MANDATORY_FIELD_T
+    INTERNED_STRING m_name;  ///< Name (not the field text value itself, that is .m_Text)
 };
 
 #endif  //  CLASS_LIBENTRY_FIELDS_H
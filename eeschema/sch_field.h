@@ -27,6 +27,7 @@
 
 
 #include <eda_text.h>
+#include <interned_string.h>
 #include <sch_item.h>
 #include <template_fieldnames.h>
 #include <general.h>
@@ -205,9 +206,9 @@ public:
 #endif
 
 private:
-    int      m_id;         ///< Field index, @see enum MANDATORY_FIELD_T
+    int             m_id;         ///< Field index, @see enum MANDATORY_FIELD_T
 
-    wxString m_name;
+    INTERNED_STRING m_name;
 };
 
 
@@ -36,6 +36,7 @@ class SCH_PLUGIN;
 class SCHEMATIC;
 class KIWAY;
 class LIB_SYMBOL;
+class SYMBOL_INFO;
 class SYMBOL_LIB;
 class PROPERTIES;
 class PROGRESS_REPORTER;
@@ -295,6 +296,29 @@ public:
                                      const wxString& aLibraryPath,
                                      const PROPERTIES* aProperties = nullptr );
 
+    /**
+     * Populate a list of the symbol chooser properties of the symbols contained within the
+     * library \a aLibraryPath.
+     *
+     * The default implementation loads the symbols with EnumerateSymbolLib().  Plugins which
+     * can list these properties without parsing the symbols should override it.
+     *
+     * @param aSymbolList is an array to populate with the properties of the symbols.
+     *
+     * @param aLibraryPath is a locator for the "library", usually a directory, file,
+     *                     or URL containing one or more #LIB_SYMBOL objects.
+     *
+     * @param aProperties is an associative array that can be used to tell the plugin anything
+     *                    needed about how to perform with respect to \a aLibraryPath.  The
+     *                    caller continues to own this object (plugin may not delete it), and
+     *                    plugins should expect it to be optionally NULL.
+     *
+     * @throw IO_ERROR if the library cannot be found, the part library cannot be loaded.
+     */
+    virtual void EnumerateSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList,
+                                      const wxString& aLibraryPath,
+                                      const PROPERTIES* aProperties = nullptr );
+
     /**
      * Load a #LIB_SYMBOL object having \a aPartName from the \a aLibraryPath containing
      * a library format that this #SCH_PLUGIN knows about.
@@ -23,6 +23,7 @@
 #include <properties.h>
 
 #include <sch_io_mgr.h>
+#include <symbol_info.h>
 #include <wx/translation.h>
 
 #define FMT_UNIMPLEMENTED   "Plugin \"%s\" does not implement the \"%s\" function."
@@ -82,6 +83,19 @@ void SCH_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SCH_PLUGIN::EnumerateSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList,
+                                      const wxString&   aLibraryPath,
+                                      const PROPERTIES* aProperties )
+{
+    std::vector<LIB_SYMBOL*> symbols;
+
+    EnumerateSymbolLib( symbols, aLibraryPath, aProperties );
+
+    for( LIB_SYMBOL* symbol : symbols )
+        aSymbolList.emplace_back( symbol );
+}
+
+
 LIB_SYMBOL* SCH_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                   const PROPERTIES* aProperties )
 {
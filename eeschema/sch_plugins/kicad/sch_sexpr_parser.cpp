@@ -36,6 +36,7 @@
 #include <lib_shape.h>
 #include <lib_pin.h>
 #include <lib_text.h>
+#include <locale_io.h>
 #include <math/util.h>                           // KiROUND, Clamp
 #include <string_utils.h>
 #include <sch_bitmap.h>
@@ -139,6 +140,142 @@ void SCH_SEXPR_PARSER::ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap )
 }
 
 
+void SCH_SEXPR_PARSER::skipSection()
+{
+    for( int depth = 1;  depth > 0;  )
+    {
+        T token = NextTok();
+
+        if( token == T_LEFT )
+            depth++;
+        else if( token == T_RIGHT )
+            depth--;
+        else if( token == T_EOF )
+            Unexpected( T_EOF );
+    }
+}
+
+
+int SCH_SEXPR_PARSER::IndexLib( std::vector<LIB_SYMBOL_LOCATION>& aSymbols )
+{
+    T token;
+
+    NeedLEFT();
+    NextTok();
+    parseHeader( T_kicad_symbol_lib, SEXPR_SYMBOL_LIB_FILE_VERSION );
+
+    for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+    {
+        if( token != T_LEFT )
+            Expecting( T_LEFT );
+
+        LIB_SYMBOL_LOCATION location;
+
+        location.m_startLine = CurLineNumber();
+        location.m_startOffset = CurOffset() - 1;
+
+        if( NextTok() != T_symbol )
+            Expecting( "symbol" );
+
+        token = NextTok();
+
+        if( !IsSymbol( token ) )
+        {
+            THROW_PARSE_ERROR( _( "Invalid symbol name" ), CurSource(), CurLine(), CurLineNumber(),
+                               CurOffset() );
+        }
+
+        LIB_ID id;
+
+        if( id.Parse( FromUTF8() ) >= 0 )
+        {
+            THROW_PARSE_ERROR( _( "Invalid library identifier" ), CurSource(), CurLine(),
+                               CurLineNumber(), CurOffset() );
+        }
+
+        location.m_name = id.GetLibItemName().wx_str();
+
+        for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+        {
+            if( token != T_LEFT )
+                Expecting( T_LEFT );
+
+            token = NextTok();
+
+            if( token == T_power )
+            {
+                location.m_power = true;
+                NeedRIGHT();
+            }
+            else if( token == T_extends )
+            {
+                NeedSYMBOL();
+                location.m_parent = FromUTF8();
+                NeedRIGHT();
+            }
+            else if( token == T_property )
+            {
+                NeedSYMBOL();
+                wxString name = FromUTF8();
+                NeedSYMBOL();
+                wxString value = FromUTF8();
+                int      fieldId = -1;
+
+                for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+                {
+                    if( token != T_LEFT )
+                        Expecting( T_LEFT );
+
+                    if( NextTok() == T_id )
+                    {
+                        fieldId = parseInt( "field ID" );
+                        NeedRIGHT();
+                    }
+                    else
+                    {
+                        skipSection();
+                    }
+                }
+
+                if( fieldId == FOOTPRINT_FIELD )
+                    location.m_footprint = value;
+                else if( name == "ki_keywords" )
+                    location.m_keywords = value;
+                else if( name == "ki_description" )
+                    location.m_description = value;
+            }
+            else if( token == T_symbol )
+            {
+                // Units are drawn in sub-symbols named "<name>_<unit>_<convert>".
+                NeedSYMBOL();
+                wxString unitName = FromUTF8();
+                long     unit = 0;
+
+                if( unitName.BeforeLast( '_' ).AfterLast( '_' ).ToLong( &unit )
+                        && unit > location.m_unitCount )
+                {
+                    location.m_unitCount = static_cast<int>( unit );
+                }
+
+                skipSection();
+            }
+            else
+            {
+                // Skip everything else, the symbol is parsed when it is loaded.
+                skipSection();
+            }
+        }
+
+        location.m_endLine = CurLineNumber();
+        location.m_endOffset = CurOffset();
+
+        aSymbols.push_back( location );
+    }
+
+    return m_requiredVersion;
+}
+
+
 LIB_SYMBOL* SCH_SEXPR_PARSER::ParseSymbol( LIB_SYMBOL_MAP& aSymbolLibMap, int aFileVersion )
 {
     wxCHECK_MSG( CurTok() == T_symbol, nullptr,
@@ -427,7 +564,7 @@ double SCH_SEXPR_PARSER::parseDouble()
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+    double fval = StrToDoubleC( CurText(), &tmp );
 
     if( errno )
     {
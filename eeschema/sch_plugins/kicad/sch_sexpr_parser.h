@@ -70,6 +70,28 @@ public:
 };
 
 
+/**
+ * Where a symbol is in a symbol library file, found by SCH_SEXPR_PARSER::IndexLib() without
+ * parsing the symbol.
+ */
+struct LIB_SYMBOL_LOCATION
+{
+    wxString m_name;            ///< The symbol name, as the key of a #LIB_SYMBOL_MAP.
+    wxString m_parent;          ///< The symbol it extends, empty for a root symbol.
+    bool     m_power = false;
+    int      m_unitCount = 1;   ///< Highest unit number drawn, 1 for a derived symbol.
+
+    wxString m_description;     ///< The properties shown in the symbol chooser.
+    wxString m_keywords;
+    wxString m_footprint;
+
+    int      m_startLine = 0;   ///< Line number and offset in that line of the opening paren.
+    int      m_startOffset = 0;
+    int      m_endLine = 0;     ///< Line number and offset in that line past the closing paren.
+    int      m_endOffset = 0;
+};
+
+
 /**
  * Object to parser s-expression symbol library and schematic file formats.
  */
@@ -88,6 +110,9 @@ class SCH_SEXPR_PARSER : public SCHEMATIC_LEXER
 
     void checkpoint();
 
+    /// Skip the rest of the section whose opening paren and keyword were just read.
+    void skipSection();
+
     void parseHeader( TSCHEMATIC_T::T aHeaderType, int aFileVersion );
 
     inline long parseHex()
@@ -193,6 +218,15 @@ public:
 
     void ParseLib( LIB_SYMBOL_MAP& aSymbolLibMap );
 
+    /**
+     * Scan a symbol library for the location of its symbols, only reading the properties
+     * needed to list them and to fill the symbol chooser.
+     *
+     * @param aSymbols receives the symbols in file order.
+     * @return the file version, to parse the symbols with.
+     */
+    int IndexLib( std::vector<LIB_SYMBOL_LOCATION>& aSymbols );
+
     LIB_SYMBOL* ParseSymbol( LIB_SYMBOL_MAP& aSymbolLibMap,
                              int aFileVersion = SEXPR_SYMBOL_LIB_FILE_VERSION );
 
@@ -26,11 +26,11 @@
 // base64 code.
 #define wxUSE_BASE64 1
 #include <wx/base64.h>
+#include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/mstream.h>
 #include <advanced_config.h>
 #include <trace_helpers.h>
-#include <locale_io.h>
 #include <sch_bitmap.h>
 #include <sch_bus_entry.h>
 #include <sch_symbol.h>
@@ -54,11 +54,17 @@
 #include <schematic_lexer.h>
 #include <sch_plugins/kicad/sch_sexpr_parser.h>
 #include <symbol_lib_table.h>  // for PropPowerSymsOnly definition.
+#include <symbol_info.h>
 #include <ee_selection.h>
 #include <string_utils.h>
 #include <wx_filename.h>       // for ::ResolvePossibleSymlinks()
 #include <progress_reporter.h>
 
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <thread>
+
 
 using namespace TSCHEMATIC_T;
 
@@ -447,8 +453,57 @@ class SCH_SEXPR_PLUGIN_CACHE
     int             m_versionMajor;
     SCH_LIB_TYPE    m_libType;      // Is this cache a symbol or symbol library.
 
+    /// Where a symbol which is not parsed yet is in the library file.
+    struct SYMBOL_RANGE
+    {
+        wxString m_parent;
+        bool     m_power;
+        int      m_unitCount;
+        wxString m_description;
+        wxString m_keywords;
+        wxString m_footprint;
+        size_t   m_start;
+        size_t   m_end;
+    };
+
+    // Symbols which are not parsed yet map to nullptr in m_symbols, and to their range of
+    // the library file here.
+    std::map<wxString, SYMBOL_RANGE> m_unparsed;
+    std::string                      m_fileData;     // The listed file, until all are parsed.
+    int                              m_fileVersion;  // To parse the symbols with.
+    wxString                         m_parseErrors;  // Of symbols which failed to parse.
+
     LIB_SYMBOL* removeSymbol( LIB_SYMBOL* aAlias );
 
+    /**
+     * Return the symbol named \a aName, parsing it and the symbol it extends first if they
+     * were only listed when the library was loaded.
+     *
+     * @return the symbol, or nullptr if there is no such symbol.
+     * @throw IO_ERROR if the symbol cannot be parsed.
+     */
+    LIB_SYMBOL* getSymbol( const wxString& aName );
+
+    /**
+     * Parse every symbol which was only listed, before the whole library is used.
+     *
+     * @throw IO_ERROR if any symbol of the library cannot be parsed.
+     */
+    void parseAll();
+
+    /// Free the copy of the library file once no symbol is left to parse from it.
+    void releaseFileData();
+
+    /**
+     * @return true if the symbol of \a aIt is a power symbol, without parsing it.
+     */
+    bool isPower( LIB_SYMBOL_MAP::const_iterator aIt ) const;
+
+    /**
+     * @return the symbol chooser properties of the symbol of \a aIt, without parsing it.
+     */
+    SYMBOL_INFO getSymbolInfo( LIB_SYMBOL_MAP::const_iterator aIt ) const;
+
     static void saveSymbolDrawItem( LIB_ITEM* aItem, OUTPUTFORMATTER& aFormatter,
                                     int aNestLevel );
     static void saveField( LIB_FIELD* aField, OUTPUTFORMATTER& aFormatter, int& aNextFreeFieldId,
@@ -503,7 +558,8 @@ public:
 
 
 SCH_SEXPR_PLUGIN::SCH_SEXPR_PLUGIN() :
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_parallelLoad( ADVANCED_CFG::GetCfg().m_ParallelSchematicLoad )
 {
     init( nullptr );
 }
@@ -531,7 +587,6 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
 {
     wxASSERT( !aFileName || aSchematic != nullptr );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
     SCH_SHEET*  sheet;
 
     wxFileName fn = aFileName;
@@ -601,103 +656,217 @@ SCH_SHEET* SCH_SEXPR_PLUGIN::Load( const wxString& aFileName, SCHEMATIC* aSchema
 }
 
 
-// Everything below this comment is recursive.  Modify with care.
-
 void SCH_SEXPR_PLUGIN::loadHierarchy( SCH_SHEET* aSheet )
 {
-    SCH_SCREEN* screen = nullptr;
+    if( aSheet->GetScreen() )
+        return;
 
-    if( !aSheet->GetScreen() )
+    // A sheet still to be loaded, with the full path of its file.  Sheet file names may be
+    // relative to the file of the sheet they are placed in, which is always absolute.
+    struct PENDING_SHEET
     {
-        // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
-        // stores the file name and extension.  Add the project path to the file name and
-        // extension to compare when calling SCH_SHEET::SearchHierarchy().
-        wxFileName fileName = aSheet->GetFileName();
+        SCH_SHEET* sheet;
+        wxString   fileName;
+    };
+
+    auto pendingSheet =
+            []( SCH_SHEET* aChild, const wxString& aParentPath ) -> PENDING_SHEET
+            {
+                wxFileName fileName = aChild->GetFileName();
 
-        if( !fileName.IsAbsolute() )
-            fileName.MakeAbsolute( m_currentPath.top() );
+                if( !fileName.IsAbsolute() )
+                    fileName.MakeAbsolute( aParentPath );
 
-        // Save the current path so that it gets restored when descending and ascending the
-        // sheet hierarchy which allows for sheet schematic files to be nested in folders
-        // relative to the last path a schematic was loaded from.
-        wxLogTrace( traceSchLegacyPlugin, "Saving path    '%s'", m_currentPath.top() );
-        m_currentPath.push( fileName.GetPath() );
-        wxLogTrace( traceSchLegacyPlugin, "Current path   '%s'", m_currentPath.top() );
-        wxLogTrace( traceSchLegacyPlugin, "Loading        '%s'", fileName.GetFullPath() );
+                return { aChild, fileName.GetFullPath() };
+            };
 
-        m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &screen );
+    std::vector<PENDING_SHEET> pending = { pendingSheet( aSheet, m_currentPath.top() ) };
 
-        if( screen )
+    while( !pending.empty() )
+    {
+        // Give every sheet of this level its screen before any file is parsed, so sheets
+        // using the same file find the screen of the first one.
+        std::vector<PENDING_SHEET> toLoad;
+
+        for( const PENDING_SHEET& entry : pending )
         {
-            aSheet->SetScreen( screen );
-            aSheet->GetScreen()->SetParent( m_schematic );
-            // Do not need to load the sub-sheets - this has already been done.
+            SCH_SCREEN* screen = nullptr;
+
+            wxLogTrace( traceSchLegacyPlugin, "Loading        '%s'", entry.fileName );
+
+            m_rootSheet->SearchHierarchy( entry.fileName, &screen );
+
+            if( screen )
+            {
+                entry.sheet->SetScreen( screen );
+                entry.sheet->GetScreen()->SetParent( m_schematic );
+                // Do not need to load the sub-sheets - this has already been done.
+            }
+            else
+            {
+                entry.sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                entry.sheet->GetScreen()->SetFileName( entry.fileName );
+                toLoad.push_back( entry );
+            }
+        }
+
+        std::vector<std::exception_ptr> errors( toLoad.size() );
+        std::atomic<size_t>             nextSheet( 0 );
+        std::atomic<bool>               cancelled( false );
+
+        size_t parallelThreadCount = 1;
+
+        if( m_parallelLoad )
+        {
+            parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                    toLoad.size() );
+        }
+
+        // The progress reporter may only be refreshed from this thread.
+        PROGRESS_REPORTER* reporter = parallelThreadCount <= 1 ? m_progressReporter : nullptr;
+
+        auto load_lambda =
+                [&]() -> size_t
+                {
+                    size_t num = 0;
+
+                    for( size_t i = nextSheet++; i < toLoad.size() && !cancelled; i = nextSheet++ )
+                    {
+                        if( m_progressReporter && !reporter )
+                        {
+                            m_progressReporter->Report( wxString::Format( _( "Loading %s..." ),
+                                                                          toLoad[i].fileName ) );
+                        }
+
+                        try
+                        {
+                            loadFile( toLoad[i].fileName, toLoad[i].sheet, reporter );
+                        }
+                        catch( ... )
+                        {
+                            errors[i] = std::current_exception();
+                        }
+
+                        num++;
+                    }
+
+                    return num;
+                };
+
+        if( parallelThreadCount <= 1 )
+        {
+            load_lambda();
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+            std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-            try
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, load_lambda );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                // Here we balance returns with a 100ms timeout to allow UI updating
+                std::future_status status;
+
+                do
+                {
+                    if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+                        cancelled = true;
+
+                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+                } while( status != std::future_status::ready );
             }
-            catch( const IO_ERROR& ioe )
+
+            if( cancelled )
+                THROW_IO_ERROR( ( "Open cancelled by user." ) );
+        }
+
+        // Everything below runs on this thread, in sheet order.
+        std::vector<PENDING_SHEET> children;
+
+        for( size_t i = 0; i < toLoad.size(); ++i )
+        {
+            SCH_SHEET* sheet = toLoad[i].sheet;
+            wxFileName fileName( toLoad[i].fileName );
+
+            if( errors[i] )
             {
-                // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw;
+                try
+                {
+                    std::rethrow_exception( errors[i] );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    // If there is a problem loading the root sheet, there is no recovery.
+                    if( sheet == m_rootSheet )
+                        throw;
 
-                // For all subsheets, queue up the error message for the caller.
-                if( !m_error.IsEmpty() )
-                    m_error += "\n";
+                    // For all subsheets, queue up the error message for the caller.
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
 
-                m_error += ioe.What();
+                    m_error += ioe.What();
+                }
             }
 
-            aSheet->GetScreen()->SetFileReadOnly( !fileName.IsFileWritable() );
-            aSheet->GetScreen()->SetFileExists( true );
+            sheet->GetScreen()->SetFileReadOnly( !fileName.IsFileWritable() );
+            sheet->GetScreen()->SetFileExists( true );
 
-            // This was moved out of the try{} block so that any sheets definitionsthat
-            // the plugin fully parsed before the exception was raised will be loaded.
-            for( SCH_ITEM* aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+            // Any sheet definitions that the plugin fully parsed before an exception was raised
+            // will be loaded.
+            for( SCH_ITEM* aItem : sheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
             {
                 wxCHECK2( aItem->Type() == SCH_SHEET_T, /* do nothing */ );
-                SCH_SHEET* sheet = static_cast<SCH_SHEET*>( aItem );
+                SCH_SHEET* child = static_cast<SCH_SHEET*>( aItem );
 
-                // Recursion starts here.
-                loadHierarchy( sheet );
+                if( !child->GetScreen() )
+                    children.push_back( pendingSheet( child, fileName.GetPath() ) );
             }
         }
 
-        m_currentPath.pop();
-        wxLogTrace( traceSchLegacyPlugin, "Restoring path \"%s\"", m_currentPath.top() );
+        pending = std::move( children );
     }
 }
 
 
-void SCH_SEXPR_PLUGIN::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
+void SCH_SEXPR_PLUGIN::loadFile( const wxString& aFileName, SCH_SHEET* aSheet,
+                                 PROGRESS_REPORTER* aReporter )
 {
-    FILE_LINE_READER reader( aFileName );
+    auto load =
+            [&]( auto& aReader )
+            {
+                size_t lineCount = 0;
 
-    size_t lineCount = 0;
+                if( aReporter )
+                {
+                    aReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
 
-    if( m_progressReporter )
-    {
-        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
+                    if( !aReporter->KeepRefreshing() )
+                        THROW_IO_ERROR( ( "Open cancelled by user." ) );
 
-        if( !m_progressReporter->KeepRefreshing() )
-            THROW_IO_ERROR( ( "Open cancelled by user." ) );
+                    while( aReader.ReadLine() )
+                        lineCount++;
 
-        while( reader.ReadLine() )
-            lineCount++;
+                    aReader.Rewind();
+                }
 
-        reader.Rewind();
-    }
+                SCH_SEXPR_PARSER parser( &aReader, aReporter, lineCount );
 
-    SCH_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount );
+                parser.ParseSchematic( aSheet );
+            };
 
-    parser.ParseSchematic( aSheet );
+    // Compressed schematics are recognized by their content rather than their name.
+    if( GZIP_FILE_LINE_READER::IsGzipFile( aFileName ) )
+    {
+        GZIP_FILE_LINE_READER reader( aFileName );
+        load( reader );
+    }
+    else
+    {
+        MAPPED_FILE_LINE_READER reader( aFileName );
+        load( reader );
+    }
 }
 
 
@@ -705,7 +874,6 @@ void SCH_SEXPR_PLUGIN::LoadContent( LINE_READER& aReader, SCH_SHEET* aSheet, int
 {
     wxCHECK( aSheet, /* void */ );
 
-    LOCALE_IO toggle;
     SCH_SEXPR_PARSER parser( &aReader );
 
     parser.ParseSchematic( aSheet, true, aFileVersion );
@@ -718,8 +886,6 @@ void SCH_SEXPR_PLUGIN::Save( const wxString& aFileName, SCH_SHEET* aSheet, SCHEM
     wxCHECK_RET( aSheet != nullptr, "NULL SCH_SHEET object." );
     wxCHECK_RET( !aFileName.IsEmpty(), "No schematic file name defined." );
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale, to write floating point values.
-
     init( aSchematic, aProperties );
 
     wxFileName fn = aFileName;
@@ -728,12 +894,20 @@ void SCH_SEXPR_PLUGIN::Save( const wxString& aFileName, SCH_SHEET* aSheet, SCHEM
     // works properly.
     wxASSERT( fn.IsAbsolute() );
 
-    FILE_OUTPUTFORMATTER formatter( fn.GetFullPath() );
+    std::unique_ptr<OUTPUTFORMATTER> formatter;
 
-    m_out = &formatter;     // no ownership
+    if( GZIP_FILE_OUTPUTFORMATTER::IsGzipFileName( fn.GetFullPath() ) )
+        formatter = std::make_unique<GZIP_FILE_OUTPUTFORMATTER>( fn.GetFullPath() );
+    else
+        formatter = std::make_unique<FILE_OUTPUTFORMATTER>( fn.GetFullPath() );
+
+    m_out = formatter.get();     // no ownership
 
     Format( aSheet );
 
+    m_out = nullptr;
+    formatter->Finish();
+
     aSheet->GetScreen()->SetFileExists( true );
 }
 
@@ -885,8 +1059,6 @@ void SCH_SEXPR_PLUGIN::Format( EE_SELECTION* aSelection, SCH_SHEET_PATH* aSelect
 {
     wxCHECK( aSelection && aSelectionPath && aFullSheetHierarchy && aFormatter, /* void */ );
 
-    LOCALE_IO toggle;
-
     m_out = aFormatter;
 
     size_t i;
@@ -1510,7 +1682,8 @@ SCH_SEXPR_PLUGIN_CACHE::SCH_SEXPR_PLUGIN_CACHE( const wxString& aFullPathAndFile
     m_fileName( aFullPathAndFileName ),
     m_libFileName( aFullPathAndFileName ),
     m_isWritable( true ),
-    m_isModified( false )
+    m_isModified( false ),
+    m_fileVersion( SEXPR_SYMBOL_LIB_FILE_VERSION )
 {
     m_versionMajor = -1;
     m_libType      = SCH_LIB_TYPE::LT_EESCHEMA;
@@ -1632,6 +1805,9 @@ LIB_SYMBOL* SCH_SEXPR_PLUGIN_CACHE::removeSymbol( LIB_SYMBOL* aSymbol )
 
 void SCH_SEXPR_PLUGIN_CACHE::AddSymbol( const LIB_SYMBOL* aSymbol )
 {
+    // Replacing a root symbol reparents the symbols which extend it.
+    parseAll();
+
     // aSymbol is cloned in SYMBOL_LIB::AddSymbol().  The cache takes ownership of aSymbol.
     wxString name = aSymbol->GetName();
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( name );
@@ -1659,18 +1835,82 @@ void SCH_SEXPR_PLUGIN_CACHE::Load()
                  wxString::Format( "Cannot use relative file paths in sexpr plugin to "
                                    "open library '%s'.", m_libFileName.GetFullPath() ) );
 
-    // The current locale must use period as the decimal point.
-    wxCHECK2( wxLocale::GetInfo( wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER ) == ".",
-              LOCALE_IO toggle );
-
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    if( !ADVANCED_CFG::GetCfg().m_LazySymbolLibs )
+    {
+        MAPPED_FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+
+        SCH_SEXPR_PARSER parser( &reader );
+
+        parser.ParseLib( m_symbols );
+    }
+    else
+    {
+        // Only list the symbols here, keeping where each one is in the file so it can be
+        // parsed on its own when it is first used.
+        std::string data;
+
+        {
+            wxFFile file( m_libFileName.GetFullPath(), wxT( "rb" ) );
+
+            if( file.IsOpened() )
+            {
+                data.resize( (size_t) file.Length() );
+
+                if( file.Read( &data[0], data.size() ) != data.size() )
+                    data.clear();
+            }
+
+            if( data.empty() )
+            {
+                THROW_IO_ERROR( wxString::Format( _( "Cannot read library file '%s'." ),
+                                                  m_libFileName.GetFullPath() ) );
+            }
+        }
+
+        std::vector<size_t> lineStarts = { 0 };
+        const char*         begin = data.data();
+        const char*         end = begin + data.size();
+
+        for( const char* eol = (const char*) memchr( begin, '\n', data.size() );  eol;
+             eol = (const char*) memchr( eol + 1, '\n', end - eol - 1 ) )
+        {
+            lineStarts.push_back( eol + 1 - begin );
+        }
+
+        std::vector<LIB_SYMBOL_LOCATION> locations;
+
+        {
+            STRING_LINE_READER reader( data, m_libFileName.GetFullPath() );
+            SCH_SEXPR_PARSER   parser( &reader );
+
+            m_fileVersion = parser.IndexLib( locations );
+        }
+
+        for( const LIB_SYMBOL_LOCATION& location : locations )
+        {
+            SYMBOL_RANGE& range = m_unparsed[location.m_name];
+
+            range.m_parent = location.m_parent;
+            range.m_power = location.m_power;
+            range.m_unitCount = location.m_unitCount;
+            range.m_description = location.m_description;
+            range.m_keywords = location.m_keywords;
+            range.m_footprint = location.m_footprint;
+            range.m_start = lineStarts[location.m_startLine - 1] + location.m_startOffset;
+            range.m_end = lineStarts[location.m_endLine - 1] + location.m_endOffset;
+
+            m_symbols[location.m_name] = nullptr;
+        }
 
-    SCH_SEXPR_PARSER parser( &reader );
+        // Symbols are parsed from this copy, so they can't be read from a file which was
+        // changed since it was listed.
+        if( !m_unparsed.empty() )
+            m_fileData = std::move( data );
+    }
 
-    parser.ParseLib( m_symbols );
     ++m_modHash;
 
     // Remember the file modification time of library file when the
@@ -1680,12 +1920,254 @@ void SCH_SEXPR_PLUGIN_CACHE::Load()
 }
 
 
+LIB_SYMBOL* SCH_SEXPR_PLUGIN_CACHE::getSymbol( const wxString& aName )
+{
+    LIB_SYMBOL_MAP::iterator it = m_symbols.find( aName );
+
+    if( it == m_symbols.end() )
+        return nullptr;
+
+    if( it->second )
+        return it->second;
+
+    auto rangeIt = m_unparsed.find( aName );
+
+    // Not listed either when the symbol is already being parsed, which only happens for
+    // symbols extending each other.
+    if( rangeIt == m_unparsed.end() )
+        return nullptr;
+
+    SYMBOL_RANGE range = rangeIt->second;
+
+    wxCHECK_MSG( range.m_end <= m_fileData.size(), nullptr,
+                 wxT( "Symbol range outside of the listed library file." ) );
+
+    // Taken before the parent is parsed, which may release the file data.
+    std::string text = m_fileData.substr( range.m_start, range.m_end - range.m_start );
+
+    m_unparsed.erase( rangeIt );
+
+    try
+    {
+        LIB_SYMBOL_MAP parents;
+
+        if( !range.m_parent.IsEmpty() )
+        {
+            LIB_SYMBOL* parent = nullptr;
+
+            try
+            {
+                parent = getSymbol( range.m_parent );
+            }
+            catch( const IO_ERROR& )
+            {
+                // Already queued; parsing this symbol reports the missing parent.
+            }
+
+            if( parent )
+                parents[range.m_parent] = parent;
+        }
+
+        // The library was listed from m_fileName, m_libFileName only differs while the cache
+        // is saved to another library.
+        STRING_LINE_READER reader( text, m_fileName );
+        SCH_SEXPR_PARSER   parser( &reader );
+
+        parser.NeedLEFT();
+        parser.NextTok();
+
+        LIB_SYMBOL* symbol = parser.ParseSymbol( parents, m_fileVersion );
+
+        m_symbols[aName] = symbol;
+
+        if( m_unparsed.empty() )
+            releaseFileData();
+
+        return symbol;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        // Drop the symbol, as the library does when it is parsed at once.
+        m_symbols.erase( aName );
+
+        if( m_unparsed.empty() )
+            releaseFileData();
+
+        if( !m_parseErrors.IsEmpty() )
+            m_parseErrors += "\n";
+
+        m_parseErrors += ioe.What();
+        throw;
+    }
+}
+
+
+void SCH_SEXPR_PLUGIN_CACHE::releaseFileData()
+{
+    std::string().swap( m_fileData );
+}
+
+
+void SCH_SEXPR_PLUGIN_CACHE::parseAll()
+{
+    if( m_unparsed.empty() )
+        return;
+
+    // Nothing was used yet: parse the library in one pass, as when it isn't listed first.
+    if( m_unparsed.size() == m_symbols.size() )
+    {
+        LIB_SYMBOL_MAP symbols;
+
+        try
+        {
+            STRING_LINE_READER reader( m_fileData, m_fileName );
+            SCH_SEXPR_PARSER   parser( &reader );
+
+            parser.ParseLib( symbols );
+        }
+        catch( const IO_ERROR& )
+        {
+            // Parse the symbols one by one below, to drop only those which are damaged.
+            for( const std::pair<const wxString, LIB_SYMBOL*>& entry : symbols )
+                delete entry.second;
+
+            symbols.clear();
+        }
+
+        if( !symbols.empty() )
+        {
+            m_symbols = std::move( symbols );
+            m_unparsed.clear();
+            releaseFileData();
+            return;
+        }
+    }
+
+    std::vector<wxString> names;
+
+    for( const std::pair<const wxString, LIB_SYMBOL*>& entry : m_symbols )
+    {
+        if( !entry.second )
+            names.push_back( entry.first );
+    }
+
+    for( const wxString& name : names )
+    {
+        try
+        {
+            getSymbol( name );
+        }
+        catch( const IO_ERROR& )
+        {
+            // Queued in m_parseErrors.
+        }
+    }
+
+    // Don't let a library with symbols which were dropped be used, or saved, as a whole.
+    if( !m_parseErrors.IsEmpty() )
+        THROW_IO_ERROR( m_parseErrors );
+}
+
+
+bool SCH_SEXPR_PLUGIN_CACHE::isPower( LIB_SYMBOL_MAP::const_iterator aIt ) const
+{
+    if( aIt->second )
+        return aIt->second->IsPower();
+
+    auto rangeIt = m_unparsed.find( aIt->first );
+
+    if( rangeIt == m_unparsed.end() )
+        return false;
+
+    // Derived symbols are power symbols when the symbol they extend is.
+    if( !rangeIt->second.m_parent.IsEmpty() )
+    {
+        LIB_SYMBOL_MAP::const_iterator parentIt = m_symbols.find( rangeIt->second.m_parent );
+
+        if( parentIt == m_symbols.end() || parentIt == aIt )
+            return false;
+
+        if( parentIt->second )
+            return parentIt->second->IsPower();
+
+        auto parentRangeIt = m_unparsed.find( parentIt->first );
+
+        return parentRangeIt != m_unparsed.end() && parentRangeIt->second.m_power;
+    }
+
+    return rangeIt->second.m_power;
+}
+
+
+SYMBOL_INFO SCH_SEXPR_PLUGIN_CACHE::getSymbolInfo( LIB_SYMBOL_MAP::const_iterator aIt ) const
+{
+    if( aIt->second )
+        return SYMBOL_INFO( aIt->second );
+
+    SYMBOL_INFO info;
+    auto        rangeIt = m_unparsed.find( aIt->first );
+
+    info.m_libId.SetLibItemName( aIt->first );
+    info.m_isPower = isPower( aIt );
+
+    if( rangeIt == m_unparsed.end() )
+        return info;
+
+    const SYMBOL_RANGE& range = rangeIt->second;
+
+    info.m_description = range.m_description;
+    info.m_keywords = range.m_keywords;
+    info.m_footprint = range.m_footprint;
+    info.m_unitCount = range.m_unitCount;
+    info.m_isRoot = range.m_parent.IsEmpty();
+
+    // Derived symbols take the units of the symbol they extend, and its description and
+    // keywords when they have none.
+    if( !info.m_isRoot )
+    {
+        LIB_SYMBOL_MAP::const_iterator parentIt = m_symbols.find( range.m_parent );
+
+        SYMBOL_INFO parent;
+
+        if( parentIt == m_symbols.end() || parentIt == aIt )
+            return info;
+
+        if( parentIt->second )
+        {
+            parent = SYMBOL_INFO( parentIt->second );
+        }
+        else
+        {
+            auto parentRangeIt = m_unparsed.find( parentIt->first );
+
+            if( parentRangeIt == m_unparsed.end() )
+                return info;
+
+            parent.m_description = parentRangeIt->second.m_description;
+            parent.m_keywords = parentRangeIt->second.m_keywords;
+            parent.m_unitCount = parentRangeIt->second.m_unitCount;
+        }
+
+        info.m_unitCount = parent.m_unitCount;
+
+        if( info.m_description.IsEmpty() )
+            info.m_description = parent.m_description;
+
+        if( info.m_keywords.IsEmpty() )
+            info.m_keywords = parent.m_keywords;
+    }
+
+    return info;
+}
+
+
 void SCH_SEXPR_PLUGIN_CACHE::Save()
 {
     if( !m_isModified )
         return;
 
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
+    // Symbols which were only listed must be written back too.
+    parseAll();
 
     // Write through symlinks, don't replace them.
     wxFileName fn = GetRealFile();
@@ -1720,6 +2202,7 @@ void SCH_SEXPR_PLUGIN_CACHE::Save()
 
     formatter->Print( 0, ")\n" );
 
+    formatter->Finish();
     formatter.reset();
 
     m_fileModTime = fn.GetModificationTime();
@@ -1732,10 +2215,6 @@ void SCH_SEXPR_PLUGIN_CACHE::SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& a
 {
     wxCHECK_RET( aSymbol, "Invalid LIB_SYMBOL pointer." );
 
-    // The current locale must use period as the decimal point.
-    wxCHECK2( wxLocale::GetInfo( wxLOCALE_DECIMAL_POINT, wxLOCALE_CAT_NUMBER ) == ".",
-              LOCALE_IO toggle );
-
     int nextFreeFieldId = MANDATORY_FIELDS;
     std::vector<LIB_FIELD*> fields;
     std::string name = aFormatter.Quotew( aSymbol->GetLibId().Format().wx_str() );
@@ -2056,6 +2535,9 @@ void SCH_SEXPR_PLUGIN_CACHE::saveText( LIB_TEXT* aText, OUTPUTFORMATTER& aFormat
 
 void SCH_SEXPR_PLUGIN_CACHE::DeleteSymbol( const wxString& aSymbolName )
 {
+    // Deleting a root symbol deletes the symbols which extend it.
+    parseAll();
+
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( aSymbolName );
 
     if( it == m_symbols.end() )
@@ -2140,8 +2622,6 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
                                            const wxString&   aLibraryPath,
                                            const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
@@ -2151,7 +2631,7 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
 
     for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
     {
-        if( !powerSymbolsOnly || it->second->IsPower() )
+        if( !powerSymbolsOnly || m_cache->isPower( it ) )
             aSymbolNameList.Add( it->first );
     }
 }
@@ -2161,12 +2641,11 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList
                                            const wxString&   aLibraryPath,
                                            const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     bool powerSymbolsOnly = ( aProperties &&
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
     cacheLib( aLibraryPath, aProperties );
+    m_cache->parseAll();
 
     const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
 
@@ -2178,27 +2657,38 @@ void SCH_SEXPR_PLUGIN::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList
 }
 
 
-LIB_SYMBOL* SCH_SEXPR_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
-                                          const PROPERTIES* aProperties )
+void SCH_SEXPR_PLUGIN::EnumerateSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList,
+                                            const wxString&   aLibraryPath,
+                                            const PROPERTIES* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+    bool powerSymbolsOnly = ( aProperties &&
+                              aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
     cacheLib( aLibraryPath, aProperties );
 
-    LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
+    // Listed from the library index, so the chooser doesn't parse the symbols.
+    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
+
+    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
+    {
+        if( !powerSymbolsOnly || m_cache->isPower( it ) )
+            aSymbolList.push_back( m_cache->getSymbolInfo( it ) );
+    }
+}
 
-    if( it == m_cache->m_symbols.end() )
-        return nullptr;
 
-    return it->second;
+LIB_SYMBOL* SCH_SEXPR_PLUGIN::LoadSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
+                                          const PROPERTIES* aProperties )
+{
+    cacheLib( aLibraryPath, aProperties );
+
+    return m_cache->getSymbol( aSymbolName );
 }
 
 
 void SCH_SEXPR_PLUGIN::SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBOL* aSymbol,
                                    const PROPERTIES* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->AddSymbol( aSymbol );
@@ -2211,8 +2701,6 @@ void SCH_SEXPR_PLUGIN::SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBO
 void SCH_SEXPR_PLUGIN::DeleteSymbol( const wxString& aLibraryPath, const wxString& aSymbolName,
                                      const PROPERTIES* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-
     cacheLib( aLibraryPath, aProperties );
 
     m_cache->DeleteSymbol( aSymbolName );
@@ -2231,8 +2719,6 @@ void SCH_SEXPR_PLUGIN::CreateSymbolLib( const wxString& aLibraryPath,
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO toggle;
-
     delete m_cache;
     m_cache = new SCH_SEXPR_PLUGIN_CACHE( aLibraryPath );
     m_cache->SetModified();
@@ -2311,7 +2797,6 @@ bool SCH_SEXPR_PLUGIN::IsSymbolLibWritable( const wxString& aLibraryPath )
 
 LIB_SYMBOL* SCH_SEXPR_PLUGIN::ParseLibSymbol( LINE_READER& aReader, int aFileVersion )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     LIB_SYMBOL_MAP map;
     SCH_SEXPR_PARSER parser( &aReader );
 
@@ -2325,7 +2810,6 @@ LIB_SYMBOL* SCH_SEXPR_PLUGIN::ParseLibSymbol( LINE_READER& aReader, int aFileVer
 void SCH_SEXPR_PLUGIN::FormatLibSymbol( LIB_SYMBOL* symbol, OUTPUTFORMATTER & formatter )
 {
 
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
     SCH_SEXPR_PLUGIN_CACHE::SaveSymbol( symbol, formatter );
 }
 
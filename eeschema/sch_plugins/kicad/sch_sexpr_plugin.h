@@ -84,6 +84,15 @@ public:
         m_progressReporter = aReporter;
     }
 
+    /**
+     * Parse the sheet files of each hierarchy level on worker threads, or not.  Defaults to
+     * the ParallelSchematicLoad advanced config setting.
+     */
+    void SetParallelLoad( bool aParallel )
+    {
+        m_parallelLoad = aParallel;
+    }
+
     /**
      * The property used internally by the plugin to enable cache buffering which prevents
      * the library file from being written every time the cache is changed.  This is useful
@@ -114,6 +123,9 @@ public:
     void EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
                              const wxString&           aLibraryPath,
                              const PROPERTIES*         aProperties = nullptr ) override;
+    void EnumerateSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList,
+                              const wxString&           aLibraryPath,
+                              const PROPERTIES*         aProperties = nullptr ) override;
     LIB_SYMBOL* LoadSymbol( const wxString& aLibraryPath, const wxString& aAliasName,
                             const PROPERTIES* aProperties = nullptr ) override;
     void SaveSymbol( const wxString& aLibraryPath, const LIB_SYMBOL* aSymbol,
@@ -137,8 +149,14 @@ public:
     static void FormatLibSymbol( LIB_SYMBOL* aPart, OUTPUTFORMATTER& aFormatter );
 
 private:
+    /**
+     * Load the sheet files of the hierarchy below \a aSheet, one level at a time.  The new
+     * files of each level are parsed on worker threads when enabled in the advanced config,
+     * then linked into the hierarchy in sheet order.  A file used by several sheets is only
+     * loaded once, and its screen shared.
+     */
     void loadHierarchy( SCH_SHEET* aSheet );
-    void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
+    void loadFile( const wxString& aFileName, SCH_SHEET* aSheet, PROGRESS_REPORTER* aReporter );
 
     void saveSymbol( SCH_SYMBOL* aSymbol, SCH_SHEET_PATH* aSheetPath, int aNestLevel );
     void saveField( SCH_FIELD* aField, int aNestLevel );
@@ -163,6 +181,7 @@ protected:
     wxString                m_error;            ///< For throwing exceptions or errors on partial
                                                 ///<  loads.
     PROGRESS_REPORTER*      m_progressReporter;
+    bool                    m_parallelLoad;     ///< Load the sheets of a level on worker threads.
 
     wxString                m_path;             ///< Root project path for loading child sheets.
     std::stack<wxString>    m_currentPath;      ///< Stack to maintain nested sheet paths
@@ -3169,7 +3169,10 @@ void SCH_LEGACY_PLUGIN_CACHE::loadField( std::unique_ptr<LIB_SYMBOL>& aSymbol,
     }
     else
     {
-        parseQuotedString( field->m_name, aReader, line, &line, true );  // Optional.
+        wxString name;
+
+        parseQuotedString( name, aReader, line, &line, true );  // Optional.
+        field->m_name = name;
     }
 }
 
@@ -4079,7 +4082,7 @@ void SCH_LEGACY_PLUGIN_CACHE::saveField( const LIB_FIELD* aField, OUTPUTFORMATTE
      */
     wxString defName = TEMPLATE_FIELDNAME::GetDefaultFieldName( id );
 
-    if( id >= MANDATORY_FIELDS && !aField->m_name.IsEmpty() && aField->m_name != defName )
+    if( id >= MANDATORY_FIELDS && !aField->m_name.IsEmpty() && aField->m_name.Get() != defName )
         aFormatter.Print( 0, " %s", EscapedUTF8( aField->m_name ).c_str() );
 
     aFormatter.Print( 0, "\n" );
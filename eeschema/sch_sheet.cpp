@@ -42,6 +42,11 @@
 #include <pgm_base.h>
 #include <wx/log.h>
 
+#include <mutex>
+
+
+static std::mutex s_defaultFieldMutex;
+
 
 const wxString SCH_SHEET::GetDefaultFieldName( int aFieldNdx )
 {
@@ -50,6 +55,10 @@ const wxString SCH_SHEET::GetDefaultFieldName( int aFieldNdx )
     static wxString sheetfilenameDefault;
     static wxString userFieldDefault;
 
+    // Mutex protection is needed so that multiple loader threads don't write to the static
+    // variables at once
+    std::lock_guard<std::mutex> lock( s_defaultFieldMutex );
+
     // Fetching translations can take a surprising amount of time when loading libraries,
     // so only do it when necessary.
     if( Pgm().GetLocale() != locale )
@@ -71,25 +71,27 @@ std::string toUTFTildaText( const wxString& txt )
  */
 static LIB_SYMBOL* dummy()
 {
-    static LIB_SYMBOL* symbol;
+    // Built by the first caller only; symbols are measured from several loader threads
+    static LIB_SYMBOL* symbol =
+            []()
+            {
+                LIB_SYMBOL* newSymbol = new LIB_SYMBOL( wxEmptyString );
 
-    if( !symbol )
-    {
-        symbol = new LIB_SYMBOL( wxEmptyString );
+                LIB_SHAPE* square = new LIB_SHAPE( newSymbol, SHAPE_T::RECT );
 
-        LIB_SHAPE* square = new LIB_SHAPE( symbol, SHAPE_T::RECT );
+                square->MoveTo( wxPoint( Mils2iu( -200 ), Mils2iu( 200 ) ) );
+                square->SetEnd( wxPoint( Mils2iu( 200 ), Mils2iu( -200 ) ) );
 
-        square->MoveTo( wxPoint( Mils2iu( -200 ), Mils2iu( 200 ) ) );
-        square->SetEnd( wxPoint( Mils2iu( 200 ), Mils2iu( -200 ) ) );
+                LIB_TEXT* text = new LIB_TEXT( newSymbol );
 
-        LIB_TEXT* text = new LIB_TEXT( symbol );
+                text->SetTextSize( wxSize( Mils2iu( 150 ), Mils2iu( 150 ) ) );
+                text->SetText( wxString( wxT( "??" ) ) );
 
-        text->SetTextSize( wxSize( Mils2iu( 150 ), Mils2iu( 150 ) ) );
-        text->SetText( wxString( wxT( "??" ) ) );
+                newSymbol->AddDrawItem( square );
+                newSymbol->AddDrawItem( text );
 
-        symbol->AddDrawItem( square );
-        symbol->AddDrawItem( text );
-    }
+                return newSymbol;
+            }();
 
     return symbol;
 }
@@ -28,7 +28,7 @@
 
 SYMBOL_ASYNC_LOADER::SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNicknames,
         SYMBOL_LIB_TABLE* aTable, bool aOnlyPowerSymbols,
-        std::unordered_map<wxString, std::vector<LIB_SYMBOL*>>* aOutput,
+        std::unordered_map<wxString, std::vector<SYMBOL_INFO>>* aOutput,
         PROGRESS_REPORTER* aReporter ) :
         m_nicknames( aNicknames ),
         m_table( aTable ),
@@ -118,7 +118,7 @@ std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
 
         try
         {
-            m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
+            m_table->LoadSymbolInfo( pair.second, nickname, onlyPower );
             ret.emplace_back( std::move( pair ) );
         }
         catch( const IO_ERROR& ioe )
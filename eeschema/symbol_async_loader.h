@@ -29,7 +29,8 @@
 
 #include <wx/string.h>
 
-class LIB_SYMBOL;
+#include <symbol_info.h>
+
 class PROGRESS_REPORTER;
 class SYMBOL_LIB_TABLE;
 
@@ -42,12 +43,12 @@ public:
      * @param aNicknames is a list of library nicknames to load
      * @param aTable is a pointer to the symbol library table to load libraries for
      * @param aOnlyPowerSymbols, if true, will only return power symbols in the output map
-     * @param aOutput will be filled with the loaded parts
+     * @param aOutput will be filled with the symbol chooser properties of the loaded parts
      * @param aReporter will be used to repord progress, of not null
      */
     SYMBOL_ASYNC_LOADER( const std::vector<wxString>& aNicknames,
                          SYMBOL_LIB_TABLE* aTable, bool aOnlyPowerSymbols = false,
-                         std::unordered_map<wxString, std::vector<LIB_SYMBOL*>>* aOutput = nullptr,
+                         std::unordered_map<wxString, std::vector<SYMBOL_INFO>>* aOutput = nullptr,
                          PROGRESS_REPORTER* aReporter = nullptr );
 
     ~SYMBOL_ASYNC_LOADER();
@@ -74,7 +75,7 @@ public:
     const wxString& GetErrors() const { return m_errors; }
 
     ///< Represents a pair of <nickname, loaded parts list>
-    typedef std::pair<wxString, std::vector<LIB_SYMBOL*>> LOADED_PAIR;
+    typedef std::pair<wxString, std::vector<SYMBOL_INFO>> LOADED_PAIR;
 
 private:
     ///< Worker job that loads libraries and returns a list of pairs of <nickname, loaded parts>
@@ -90,7 +91,7 @@ private:
     bool m_onlyPowerSymbols;
 
     ///< Handle to map that will be filled with the loaded parts per library
-    std::unordered_map<wxString, std::vector<LIB_SYMBOL*>>* m_output;
+    std::unordered_map<wxString, std::vector<SYMBOL_INFO>>* m_output;
 
     ///< Progress reporter (may be null)
     PROGRESS_REPORTER* m_reporter;
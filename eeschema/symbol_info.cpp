@@ -0,0 +1,54 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <lib_symbol.h>
+#include <symbol_info.h>
+
+
+SYMBOL_INFO::SYMBOL_INFO( LIB_SYMBOL* aSymbol ) :
+        m_libId( aSymbol->GetLibId() ),
+        m_description( aSymbol->GetDescription() ),
+        m_keywords( aSymbol->GetKeyWords() ),
+        m_footprint( aSymbol->GetFootprintField().GetText() ),
+        m_isRoot( aSymbol->IsRoot() ),
+        m_isPower( aSymbol->IsPower() ),
+        m_unitCount( aSymbol->GetUnitCount() )
+{
+}
+
+
+wxString SYMBOL_INFO::GetSearchText()
+{
+    // Matches are scored by offset from front of string, so inclusion of this spacer
+    // discounts matches found after it.
+    static const wxString discount( wxT( "        " ) );
+
+    wxString text = m_keywords + discount + m_description;
+
+    if( !m_footprint.IsEmpty() )
+        text += discount + m_footprint;
+
+    return text;
+}
+
+
+wxString SYMBOL_INFO::GetUnitReference( int aUnit )
+{
+    return LIB_SYMBOL::SubReference( aUnit, false );
+}
@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_INFO_H
+#define SYMBOL_INFO_H
+
+#include <lib_id.h>
+#include <lib_tree_item.h>
+
+class LIB_SYMBOL;
+
+
+/**
+ * The properties of a library symbol shown in the symbol chooser.
+ *
+ * Unlike a #LIB_SYMBOL, they can be listed by a library plugin without parsing the symbol.
+ */
+class SYMBOL_INFO : public LIB_TREE_ITEM
+{
+public:
+    SYMBOL_INFO() :
+            m_isRoot( true ),
+            m_isPower( false ),
+            m_unitCount( 1 )
+    {
+    }
+
+    /**
+     * Copy the chooser properties of a symbol which is already parsed.
+     */
+    SYMBOL_INFO( LIB_SYMBOL* aSymbol );
+
+    LIB_ID GetLibId() const override { return m_libId; }
+
+    wxString GetName() const override { return m_libId.GetLibItemName(); }
+    wxString GetLibNickname() const override { return m_libId.GetLibNickname(); }
+
+    wxString GetDescription() override { return m_description; }
+
+    /**
+     * Same search text as LIB_SYMBOL::GetSearchText().
+     */
+    wxString GetSearchText() override;
+
+    bool IsRoot() const override { return m_isRoot; }
+
+    bool IsPower() const { return m_isPower; }
+
+    int GetUnitCount() const override { return m_unitCount; }
+
+    wxString GetUnitReference( int aUnit ) override;
+
+    LIB_ID   m_libId;
+    wxString m_description;     ///< Inherited from the symbol extended, when empty.
+    wxString m_keywords;        ///< Inherited from the symbol extended, when empty.
+    wxString m_footprint;
+    bool     m_isRoot;
+    bool     m_isPower;         ///< Always the one of the root symbol.
+    int      m_unitCount;       ///< Always the one of the root symbol.
+};
+
+#endif // SYMBOL_INFO_H
@@ -31,6 +31,7 @@
 #include <systemdirsappend.h>
 #include <symbol_lib_table.h>
 #include <lib_symbol.h>
+#include <symbol_info.h>
 
 #define OPT_SEP     '|'         ///< options separator character
 
@@ -350,6 +351,32 @@ void SYMBOL_LIB_TABLE::LoadSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
 }
 
 
+void SYMBOL_LIB_TABLE::LoadSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList,
+                                       const wxString& aNickname, bool aPowerSymbolsOnly )
+{
+    SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+    wxCHECK( row && row->plugin, /* void */  );
+
+    wxString options = row->GetOptions();
+    size_t   first = aSymbolList.size();
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( row->GetOptions() + " " + PropPowerSymsOnly );
+
+    row->SetLoaded( false );
+    row->plugin->EnumerateSymbolInfo( aSymbolList, row->GetFullURI( true ),
+                                      row->GetProperties() );
+    row->SetLoaded( true );
+
+    if( aPowerSymbolsOnly )
+        row->SetOptions( options );
+
+    // As in LoadSymbolLib(), only this layer knows the library nickname.
+    for( size_t ii = first; ii < aSymbolList.size(); ++ii )
+        aSymbolList[ii].m_libId.SetLibNickname( row->GetNickName() );
+}
+
+
 LIB_SYMBOL* SYMBOL_LIB_TABLE::LoadSymbol( const wxString& aNickname, const wxString& aSymbolName )
 {
     SYMBOL_LIB_TABLE_ROW* row = FindRow( aNickname, true );
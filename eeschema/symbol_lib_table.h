@@ -159,6 +159,18 @@ public:
     void LoadSymbolLib( std::vector<LIB_SYMBOL*>& aAliasList, const wxString& aNickname,
                         bool aPowerSymbolsOnly = false );
 
+    /**
+     * Return the symbol chooser properties of the symbols of the library given by
+     * @a aNickname, which plugins may list without loading the symbols.
+     *
+     * @param aSymbolList receives the properties of the symbols.
+     * @param aNickname is a locator for the "library", it is a "name" in LIB_TABLE_ROW.
+     * @param aPowerSymbolsOnly is a flag to list only power symbols.
+     * @throw IO_ERROR if the library cannot be found or loaded.
+     */
+    void LoadSymbolInfo( std::vector<SYMBOL_INFO>& aSymbolList, const wxString& aNickname,
+                         bool aPowerSymbolsOnly = false );
+
     /**
      * Load a #LIB_SYMBOL having @a aName from the library given by @a aNickname.
      *
@@ -101,6 +101,12 @@ public:
      */
     double m_DRCEpsilon;
 
+    /**
+     * Collect per-rule evaluation counts and timings during DRC runs and show them in the
+     * DRC dialog and report.
+     */
+    bool m_DRCProfileRules;
+
     /**
      * Hole wall plating thickness.  Used to determine actual hole size from finish hole size.
      * Units are mm.
@@ -150,6 +156,12 @@ public:
      */
     bool m_DebugZoneFiller;
 
+    /**
+     * After each zone fill, compare the isolated islands found with the incrementally updated
+     * connectivity against a full connectivity rebuild.
+     */
+    bool m_ZoneFillVerifyConnectivity;
+
     /**
      * A mode that writes PDFs without compression.
      */
@@ -195,6 +207,39 @@ public:
      */
     bool m_HideVersionFromTitle;
 
+    /**
+     * Parse the footprints, zones and tracks of a board file on worker threads.
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Format the footprints and zones of a board file on worker threads when saving.
+     */
+    bool m_ParallelBoardSave;
+
+    /**
+     * Keep the zone fills of saved boards, with their triangulations, in a binary file next
+     * to the board file, and load them from there when it is up to date.
+     */
+    bool m_ZoneFillCache;
+
+    /**
+     * Parse the footprints of a footprint library only when they are loaded, and keep the
+     * properties shown in the footprint chooser in an index in the user cache directory.
+     */
+    bool m_FootprintLibIndex;
+
+    /**
+     * Parse the sheet files of a schematic hierarchy on worker threads.
+     */
+    bool m_ParallelSchematicLoad;
+
+    /**
+     * Only list the symbols of a symbol library when it is loaded, and parse each symbol
+     * when it is first used.
+     */
+    bool m_LazySymbolLibs;
+
 private:
     ADVANCED_CFG();
 
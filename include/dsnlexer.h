@@ -430,7 +430,13 @@ public:
      */
     const char* CurLine() const
     {
-        return (const char*)(*reader);
+        // Copied, as the lines of a MAPPED_FILE_LINE_READER aren't nul terminated
+        if( reader && reader->Length() )
+            curLine.assign( reader->Line(), reader->Length() );
+        else
+            curLine.clear();
+
+        return curLine.c_str();
     }
 
     /**
@@ -527,6 +533,7 @@ protected:
 
     int                 curTok;                 ///< the current token obtained on last NextTok()
     std::string         curText;                ///< the text of the current token
+    mutable std::string curLine;                ///< copy of the current line, for CurLine()
 
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
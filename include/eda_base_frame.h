@@ -554,14 +554,16 @@ public:
     /**
      * Add a command to undo in the undo list.
      *
-     * Delete the very old commands when the max count of undo commands is reached.
+     * Delete the very old commands when the max count of undo commands or the undo memory
+     * budget is reached.
      */
     virtual void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem );
 
     /**
      * Add a command to redo in the redo list.
      *
-     * Delete the very old commands when the max count of redo commands is reached.
+     * Delete the very old commands when the max count of redo commands or the undo memory
+     * budget is reached.
      */
     virtual void PushCommandToRedoList( PICKED_ITEMS_LIST* aItem );
 
@@ -580,6 +582,20 @@ public:
 
     int GetMaxUndoItems() const { return m_undoRedoCountMax; }
 
+    /**
+     * @return the memory budget of each of the undo and redo lists, in bytes (0 for no limit).
+     */
+    size_t GetMaxUndoMemory() const { return m_undoRedoMemoryMax; }
+
+    /**
+     * Return a rough estimate of the memory held by an undo/redo command.
+     *
+     * Only used to enforce the undo memory budget, so it does not need to be exact.  The
+     * default counts a fixed cost per picker; frames storing large item copies should override
+     * it.
+     */
+    virtual size_t EstimateUndoCommandSize( const PICKED_ITEMS_LIST& aCommand ) const;
+
     bool NonUserClose( bool aForce )
     {
         m_isNonUserClose = true;
@@ -673,6 +689,12 @@ private:
 
     wxWindow* findQuasiModalDialog();
 
+    /**
+     * Delete the oldest commands of \a aList until it fits in the count and memory limits.
+     * The newest command is always kept.
+     */
+    void trimUndoRedoList( UNDO_REDO_LIST aList );
+
     /**
      * Return true if the frame is shown in our modal mode and false  if the frame is
      * shown as an usual frame.
@@ -720,6 +742,7 @@ private:
     wxTimer*        m_autoSaveTimer;
 
     int             m_undoRedoCountMax;     // undo/Redo command Max depth
+    size_t          m_undoRedoMemoryMax;    // undo/Redo list memory budget in bytes (0 = none)
 
     UNDO_REDO_CONTAINER m_undoList;         // Objects list for the undo command (old data)
     UNDO_REDO_CONTAINER m_redoList;         // Objects list for the redo command (old data)
@@ -192,6 +192,18 @@ public:
      */
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aNickname,
                                              const wxString& aFootprintName );
+
+    /**
+     * Fetch the footprint properties shown in the footprint chooser without loading the
+     * footprint, when the library plugin keeps them indexed.
+     *
+     * @return false if the plugin does not provide them.
+     * @throw IO_ERROR if the footprint cannot be read.
+     */
+    bool GetFootprintInfo( const wxString& aNickname, const wxString& aFootprintName,
+                           unsigned& aPadCount, unsigned& aUniquePadCount,
+                           wxString& aKeywords, wxString& aDoc );
+
     /**
      * The set of return values from FootprintSave() below.
      */
@@ -0,0 +1,154 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <wx/string.h>
+#include <utf8.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+/**
+ * An immutable string shared through a process-wide pool.
+ *
+ * Each distinct value is stored once, so the many copies of the same pad number, field name
+ * or library name cost a pointer each, and two interned strings are equal if and only if they
+ * point to the same pool entry.  Only use it for values which are repeated a lot: unique
+ * values pay for the pool entry and lookup without sharing anything.
+ *
+ * Pool entries are reference counted and released with the last string using them.  The pool
+ * is split in shards with their own lock, so threads loading files at the same time seldom
+ * wait for each other; only releasing the last reference to an entry takes a lock.
+ *
+ * @tparam STRING is the string type handed out, wxString or UTF8.
+ */
+template <typename STRING>
+class INTERNED
+{
+public:
+    INTERNED() :
+            m_entry( nullptr )
+    {}
+
+    INTERNED( const STRING& aString ) :
+            m_entry( acquire( aString ) )
+    {}
+
+    INTERNED( const INTERNED& aOther ) :
+            m_entry( aOther.m_entry )
+    {
+        if( m_entry )
+            m_entry->m_refCount.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    INTERNED( INTERNED&& aOther ) noexcept :
+            m_entry( aOther.m_entry )
+    {
+        aOther.m_entry = nullptr;
+    }
+
+    ~INTERNED()
+    {
+        release( m_entry );
+    }
+
+    INTERNED& operator=( const INTERNED& aOther )
+    {
+        if( aOther.m_entry )
+            aOther.m_entry->m_refCount.fetch_add( 1, std::memory_order_relaxed );
+
+        release( m_entry );
+        m_entry = aOther.m_entry;
+        return *this;
+    }
+
+    INTERNED& operator=( INTERNED&& aOther ) noexcept
+    {
+        std::swap( m_entry, aOther.m_entry );
+        return *this;
+    }
+
+    INTERNED& operator=( const STRING& aString )
+    {
+        ENTRY* entry = acquire( aString );
+
+        release( m_entry );
+        m_entry = entry;
+        return *this;
+    }
+
+    const STRING& Get() const { return m_entry ? m_entry->m_string : emptyString(); }
+
+    operator const STRING&() const { return Get(); }
+
+    bool IsEmpty() const { return m_entry == nullptr; }
+
+    bool operator==( const INTERNED& aOther ) const { return m_entry == aOther.m_entry; }
+    bool operator!=( const INTERNED& aOther ) const { return m_entry != aOther.m_entry; }
+
+private:
+    struct SHARD;
+
+    struct ENTRY
+    {
+        ENTRY( const STRING& aString, SHARD* aShard ) :
+                m_string( aString ),
+                m_key( nullptr ),
+                m_shard( aShard ),
+                m_refCount( 0 )
+        {}
+
+        const STRING       m_string;
+        const std::string* m_key;           ///< Key of the entry in its shard
+        SHARD*             m_shard;
+        std::atomic<int>   m_refCount;
+    };
+
+    /**
+     * @return the pool entry of \a aString with a reference taken for the caller, or nullptr
+     *         for the empty string.
+     */
+    static ENTRY* acquire( const STRING& aString );
+
+    /**
+     * Drop a reference to \a aEntry, removing it from the pool if it was the last one.
+     */
+    static void release( ENTRY* aEntry );
+
+    static SHARD& shard( const std::string& aKey );
+
+    static const STRING& emptyString();
+
+    ENTRY* m_entry;                         ///< nullptr for the empty string
+};
+
+
+typedef INTERNED<wxString> INTERNED_STRING;
+
+/// For the UTF-8 names of #LIB_ID.
+typedef INTERNED<UTF8>     INTERNED_UTF8;
+
+#endif // INTERNED_STRING_H
@@ -97,6 +97,20 @@ private:
 };
 
 
+#ifndef SWIG
+namespace std
+{
+    template <> struct hash<KIID>
+    {
+        size_t operator()( const KIID& aId ) const
+        {
+            return aId.Hash();
+        }
+    };
+}
+#endif
+
+
 extern KIID niluuid;
 
 KIID& NilUuid();
@@ -26,6 +26,7 @@
 #ifndef _LIB_ID_H_
 #define _LIB_ID_H_
 
+#include <interned_string.h>
 #include <richio.h>
 #include <utf8.h>
 
@@ -111,7 +112,7 @@ public:
      *
      * @return the library item name, i.e. footprintName in a wxString (UTF16 or 32).
      */
-    const wxString GetUniStringLibItemName() const { return m_itemName.wx_str(); }
+    const wxString GetUniStringLibItemName() const { return m_itemName.Get().wx_str(); }
 
     /**
      * Override the library item name portion of the LIB_ID to @a aLibItemName
@@ -158,7 +159,7 @@ public:
      */
     bool IsValid() const
     {
-        return !m_libraryName.empty() && !m_itemName.empty();
+        return !m_libraryName.IsEmpty() && !m_itemName.IsEmpty();
     }
 
     /**
@@ -166,7 +167,7 @@ public:
      */
     bool IsLegacy() const
     {
-        return m_libraryName.empty() && !m_itemName.empty();
+        return m_libraryName.IsEmpty() && !m_itemName.IsEmpty();
     }
 
     /**
@@ -179,7 +180,7 @@ public:
      */
     bool empty() const
     {
-        return m_libraryName.empty() && m_itemName.empty();
+        return m_libraryName.IsEmpty() && m_itemName.IsEmpty();
     }
 
     /**
@@ -255,8 +256,9 @@ protected:
      */
     static bool isLegalLibraryNameChar( unsigned aUniChar );
 
-    UTF8    m_libraryName;    ///< The nickname of the library or empty.
-    UTF8    m_itemName;       ///< The name of the entry in the logical library.
+    // Interned: the same library and item names are used by many symbols and footprints.
+    INTERNED_UTF8 m_libraryName;    ///< The nickname of the library or empty.
+    INTERNED_UTF8 m_itemName;       ///< The name of the entry in the logical library.
 };
 
 
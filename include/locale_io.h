@@ -25,6 +25,8 @@
 #define LOCALE_IO_H
 
 #include <atomic>
+#include <cstdarg>
+#include <cstddef>
 #include <string>
 
 class wxLocale;
@@ -53,4 +55,25 @@ private:
     wxLocale*   m_wxLocale;
 };
 
+/**
+ * Locale-independent strtod(): the decimal separator is always '.', whatever the current
+ * C locale.
+ *
+ * Unlike #LOCALE_IO this doesn't touch the process-wide locale, so it can be used from
+ * several threads at once.
+ */
+double StrToDoubleC( const char* aStr, char** aEndPtr = nullptr );
+
+/**
+ * Locale-independent vsnprintf(), with C99 return value semantics on all platforms.
+ * @see StrToDoubleC()
+ */
+int VsnprintfC( char* aBuf, size_t aSize, const char* aFormat, va_list aArgs );
+
+/**
+ * Locale-independent snprintf().
+ * @see VsnprintfC()
+ */
+int SnprintfC( char* aBuf, size_t aSize, const char* aFormat, ... );
+
 #endif
\ No newline at end of file
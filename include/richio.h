@@ -29,6 +29,7 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <memory>
 #include <vector>
 #include <utf8.h>
 
@@ -40,6 +41,11 @@
 
 #include <ki_exception.h>
 
+class wxFFileInputStream;
+class wxFFileOutputStream;
+class wxZlibInputStream;
+class wxZlibOutputStream;
+
 
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
@@ -234,6 +240,91 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that maps a file into memory instead of copying its lines into a buffer.
+ *
+ * Line() points into the mapped file and is @b not nul terminated: only Length() bytes of it
+ * may be read.  This is all #DSNLEXER needs, so it is meant for the s-expression loaders of
+ * large files.  Don't hand it to code which treats lines as C strings.
+ */
+class MAPPED_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * Open and map @a aFileName.  The file itself is closed again right away.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened or mapped.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Go back to the start of the file and reset the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = 0;
+    }
+
+    size_t FileLength() const { return m_size; }
+
+protected:
+    const char* m_data;       ///< start of the mapped file, nullptr if it's empty
+    size_t      m_size;
+    size_t      m_pos;        ///< offset of the next line in the file
+    void*       m_mapping;    ///< file mapping handle, on Windows only
+};
+
+
+/**
+ * A #LINE_READER for a gzip compressed file.
+ *
+ * The file is decompressed on the fly, a block at a time, so the uncompressed text is never
+ * held in memory as a whole.
+ */
+class GZIP_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * Open @a aFileName for decompression.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    GZIP_FILE_LINE_READER( const wxString& aFileName,
+                           unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~GZIP_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Go back to the start of the file and reset the line number back to zero.
+     *
+     * @throw IO_ERROR if the file cannot be opened again.
+     */
+    void Rewind();
+
+    /**
+     * @return true if @a aFileName exists and starts with the gzip magic number.
+     */
+    static bool IsGzipFile( const wxString& aFileName );
+
+protected:
+    void open();
+
+    std::unique_ptr<wxFFileInputStream> m_file;
+    std::unique_ptr<wxZlibInputStream>  m_stream;
+    std::vector<char>                   m_block;     ///< decompressed data not yet returned
+    size_t                              m_blockPos;
+    size_t                              m_blockEnd;
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -290,6 +381,7 @@ protected:
 
 
 #define OUTPUTFMTBUFZ    500        ///< default buffer size for any OUTPUT_FORMATTER
+#define OUTPUTFMT_FILE_BUFFER_SIZE  ( 1 << 20 )  ///< stdio buffer size for FILE_OUTPUTFORMATTER
 
 /**
  * An interface used to output 8 bit text in a convenient way.
@@ -363,6 +455,13 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Write \a aText to the output stream as is, without any formatting or indentation.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const std::string& aText );
+
     /**
      * Perform quote character need determination.
      *
@@ -396,11 +495,18 @@ public:
 
      std::string Quotew( const wxString& aWrapee ) const;
 
+    /**
+     * Complete the output, such as flushing and closing a file, and report the errors that
+     * a destructor cannot.  Nothing may be written afterwards.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    virtual void Finish() {}
+
 private:
     std::vector<char>   m_buffer;
     char                quoteChar[2];
 
-    int sprint( const char* fmt, ... );
     int vprint( const char* fmt, va_list ap );
 
 };
@@ -470,6 +576,14 @@ public:
 
     ~FILE_OUTPUTFORMATTER();
 
+    /**
+     * Flush and close the file.  Output is buffered, so a save must call this to learn
+     * whether the file was written completely.
+     *
+     * @throw IO_ERROR if the file could not be written or closed.
+     */
+    void Finish() override;
+
 protected:
     void write( const char* aOutBuf, int aCount ) override;
 
@@ -478,6 +592,47 @@ protected:
 };
 
 
+/**
+ * Used for gzip compressed text file output.
+ *
+ * The text is compressed as it is written, so nothing but the compressor state is buffered.
+ */
+class GZIP_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
+{
+public:
+    /**
+     * @param aFileName is the full filename to create and save to.
+     * @param aQuoteChar is a char used for quoting problematic strings (with whitespace or
+     *                   special characters in them).
+     * @throw IO_ERROR if the file cannot be opened.
+     */
+    GZIP_FILE_OUTPUTFORMATTER( const wxString& aFileName, char aQuoteChar = '"' );
+
+    ~GZIP_FILE_OUTPUTFORMATTER();
+
+    /**
+     * Flush the compressor and close the file.
+     *
+     * @throw IO_ERROR if the file could not be written or closed.
+     */
+    void Finish() override;
+
+    /**
+     * @return true if @a aFileName should be saved compressed, which is when it ends in ".gz".
+     *         The "$" suffix of the temporary files saves are written to is ignored, so they
+     *         are compressed like the file they replace.
+     */
+    static bool IsGzipFileName( const wxString& aFileName );
+
+protected:
+    void write( const char* aOutBuf, int aCount ) override;
+
+    std::unique_ptr<wxFFileOutputStream> m_file;
+    std::unique_ptr<wxZlibOutputStream>  m_stream;
+    wxString                             m_filename;
+};
+
+
 /**
  * Implement an #OUTPUTFORMATTER to a wxWidgets wxOutputStream.
  *
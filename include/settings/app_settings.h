@@ -24,6 +24,9 @@
 #include <gal/color4d.h>
 #include <settings/json_settings.h>
 
+/// Default memory budget of each undo and redo list, in MB
+#define DEFAULT_MAX_UNDO_MEMORY_MB 512
+
 /**
  * Cross-probing behavior
  */
@@ -143,6 +146,7 @@ public:
     {
         bool                  first_run_shown;
         int                   max_undo_items;
+        int                   max_undo_memory;      ///< Undo/redo memory budget in MB, 0 = none
         std::vector<wxString> file_history;
         int                   units;
         int                   last_metric_units;
@@ -133,6 +133,7 @@ class PICKED_ITEMS_LIST
 {
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
+    size_t                    m_estimatedSize;  // Cached when pushed to an undo/redo list
 
 public:
     PICKED_ITEMS_LIST();
@@ -180,6 +181,13 @@ public:
         return m_ItemsList.size();
     }
 
+    /**
+     * The memory estimate of this command, as computed by
+     * EDA_BASE_FRAME::EstimateUndoCommandSize() when it was last pushed to an undo or redo list.
+     */
+    size_t GetEstimatedSize() const { return m_estimatedSize; }
+    void SetEstimatedSize( size_t aSize ) { m_estimatedSize = aSize; }
+
     /**
      * Reverse the order of pickers stored in this list.
      *
@@ -129,6 +129,7 @@ extern const std::string EquFileExtension;
 extern const std::string HotkeyFileExtension;
 
 extern const std::string ArchiveFileExtension;
+extern const std::string GzipFileExtension;
 
 extern const std::string LegacyPcbFileExtension;
 extern const std::string KiCadPcbFileExtension;
@@ -162,6 +163,13 @@ extern const std::string TextFileExtension;
 
 bool IsProtelExtension( const wxString& ext );
 
+/**
+ * Replace the extension of \a aFileName by \a aExtension, looking through the ".gz" of a
+ * compressed file: "board.kicad_pcb" and "board.kicad_pcb.gz" both give "board.kicad_pro"
+ * for the project file extension.
+ */
+wxString ChangeFileExtension( const wxString& aFileName, const std::string& aExtension );
+
 /**
  * @}
  */
@@ -197,6 +205,7 @@ extern wxString HtmlFileWildcard();
 extern wxString CsvFileWildcard();
 extern wxString LegacyPcbFileWildcard();
 extern wxString PcbFileWildcard();
+extern wxString CompressedPcbFileWildcard();
 extern wxString EaglePcbFileWildcard();
 extern wxString AltiumSchematicFileWildcard();
 extern wxString CadstarSchematicArchiveFileWildcard();
@@ -162,6 +162,16 @@ public:
             return m_triangles;
         }
 
+        const std::deque<TRI>& Triangles() const
+        {
+            return m_triangles;
+        }
+
+        const std::deque<VECTOR2I>& Vertices() const
+        {
+            return m_vertices;
+        }
+
         size_t GetVertexCount() const
         {
             return m_vertices.size();
@@ -502,6 +512,13 @@ public:
     void CacheTriangulation( bool aPartition = true );
     bool IsTriangulationUpToDate() const;
 
+    /**
+     * Take \a aTriangulatedPolys as the triangulation of the current polygons instead of
+     * computing it, e.g. when it was made earlier for the same polygons and read back from a
+     * cache.  It is considered up to date until the polygons change.
+     */
+    void SetTriangulation( std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>&& aTriangulatedPolys );
+
     MD5_HASH GetHash() const;
 
     virtual bool HasIndexableSubshapes() const override;
@@ -2385,6 +2385,15 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
 }
 
 
+void SHAPE_POLY_SET::SetTriangulation(
+        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>&& aTriangulatedPolys )
+{
+    m_triangulatedPolys = std::move( aTriangulatedPolys );
+    m_triangulationValid = true;
+    m_hash = checksum();
+}
+
+
 MD5_HASH SHAPE_POLY_SET::checksum() const
 {
     MD5_HASH hash;
@@ -32,6 +32,7 @@
 #include <reporter.h>
 #include <board_commit.h>
 #include <board.h>
+#include <board_rtree.h>
 #include <footprint.h>
 #include <pcb_track.h>
 #include <zone.h>
@@ -104,6 +105,9 @@ BOARD::BOARD() :
 
 BOARD::~BOARD()
 {
+    // The connectivity can be held beyond the board; it must not look up the board again
+    m_connectivity->ClearBoard();
+
     // Clean up the owned elements
     DeleteMARKERs();
 
@@ -305,23 +309,9 @@ void BOARD::Move( const wxPoint& aMoveVector )        // overload
 
 TRACKS BOARD::TracksInNet( int aNetCode )
 {
-    TRACKS ret;
-
-    INSPECTOR_FUNC inspector = [aNetCode, &ret]( EDA_ITEM* item, void* testData )
-                               {
-                                   PCB_TRACK* t = static_cast<PCB_TRACK*>( item );
-
-                                   if( t->GetNetCode() == aNetCode )
-                                       ret.push_back( t );
-
-                                   return SEARCH_RESULT::CONTINUE;
-                               };
+    const std::vector<PCB_TRACK*>& tracks = GetItemsInNet( aNetCode ).m_Tracks;
 
-    // visit this BOARD's PCB_TRACKs and PCB_VIAs with above TRACK INSPECTOR which
-    // appends all in aNetCode to ret.
-    Visit( inspector, nullptr, GENERAL_COLLECTOR::Tracks );
-
-    return ret;
+    return TRACKS( tracks.begin(), tracks.end() );
 }
 
 
@@ -688,6 +678,10 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
 
     aBoardItem->SetParent( this );
     aBoardItem->ClearEditFlags();
+
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        IndexItem( aBoardItem );
+
     m_connectivity->Add( aBoardItem );
 
     if( aMode != ADD_MODE::BULK_INSERT && aMode != ADD_MODE::BULK_APPEND )
@@ -741,6 +735,7 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
         }
 
         m_NetInfo.RemoveNet( item );
+        m_netItemsIndex.erase( item );
         break;
     }
 
@@ -783,6 +778,9 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
 
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        UnindexItem( aBoardItem );
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
@@ -805,7 +803,10 @@ void BOARD::DeleteMARKERs()
 {
     // the vector does not know how to delete the PCB_MARKER, it holds pointers
     for( PCB_MARKER* marker : m_markers )
+    {
+        UnindexItem( marker );
         delete marker;
+    }
 
     m_markers.clear();
 }
@@ -821,6 +822,7 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
         if( ( marker->IsExcluded() && aExclusions )
                 || ( !marker->IsExcluded() && aWarningsAndErrors ) )
         {
+            UnindexItem( marker );
             delete marker;
         }
         else
@@ -836,7 +838,10 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
 void BOARD::DeleteAllFootprints()
 {
     for( FOOTPRINT* footprint : m_footprints )
+    {
+        UnindexItem( footprint );
         delete footprint;
+    }
 
     m_footprints.clear();
 }
@@ -847,113 +852,380 @@ BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
     if( aID == niluuid )
         return nullptr;
 
-    for( PCB_TRACK* track : Tracks() )
+    if( m_Uuid == aID )
+        return const_cast<BOARD*>( this );
+
+    auto cacheIter = m_itemByIdCache.find( aID );
+
+    if( cacheIter != m_itemByIdCache.end() )
     {
-        if( track->m_Uuid == aID )
-            return track;
+        wxASSERT_MSG( cacheIter->second->m_Uuid == aID,
+                      wxT( "BOARD::GetItem(): stale entry in the KIID index" ) );
+
+        return cacheIter->second;
     }
 
-    for( FOOTPRINT* footprint : Footprints() )
+#ifdef DEBUG
+    // The index must cover everything a full walk of the board can find
+    auto checkNotMissed =
+            [&]( BOARD_ITEM* aItem )
+            {
+                wxASSERT_MSG( aItem->m_Uuid != aID,
+                              wxT( "BOARD::GetItem(): item missing from the KIID index" ) );
+            };
+
+    for( PCB_TRACK* track : m_tracks )
+        checkNotMissed( track );
+
+    for( FOOTPRINT* footprint : m_footprints )
     {
-        if( footprint->m_Uuid == aID )
-            return footprint;
+        checkNotMissed( footprint );
+        footprint->RunOnChildren( checkNotMissed );
+    }
 
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( pad->m_Uuid == aID )
-                return pad;
-        }
+    for( ZONE* zone : m_zones )
+        checkNotMissed( zone );
 
-        if( footprint->Reference().m_Uuid == aID )
-            return &footprint->Reference();
+    for( BOARD_ITEM* drawing : m_drawings )
+        checkNotMissed( drawing );
 
-        if( footprint->Value().m_Uuid == aID )
-            return &footprint->Value();
+    for( PCB_MARKER* marker : m_markers )
+        checkNotMissed( marker );
 
-        for( BOARD_ITEM* drawing : footprint->GraphicalItems() )
-        {
-            if( drawing->m_Uuid == aID )
-                return drawing;
-        }
+    for( PCB_GROUP* group : m_groups )
+        checkNotMissed( group );
+#endif
 
-        for( BOARD_ITEM* zone : footprint->Zones() )
-        {
-            if( zone->m_Uuid == aID )
-                return zone;
-        }
+    // Not found; weak reference has been deleted.
+    return DELETED_BOARD_ITEM::GetInstance();
+}
 
-        for( PCB_GROUP* group : footprint->Groups() )
-        {
-            if( group->m_Uuid == aID )
-                return group;
-        }
-    }
 
-    for( ZONE* zone : Zones() )
+static bool isNetIndexed( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
     {
-        if( zone->m_Uuid == aID )
-            return zone;
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+        return true;
+
+    default:
+        return false;
     }
+}
+
 
-    for( BOARD_ITEM* drawing : Drawings() )
+static bool isSpatiallyIndexed( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
     {
-        if( drawing->m_Uuid == aID )
-            return drawing;
+    case PCB_MARKER_T:
+    case PCB_GROUP_T:
+    case PCB_NETINFO_T:
+        return false;
+
+    default:
+        return true;
     }
+}
 
-    for( PCB_MARKER* marker : m_markers )
+
+void BOARD::IndexItem( BOARD_ITEM* aItem )
+{
+    auto index =
+            [&]( BOARD_ITEM* aEntry )
+            {
+                m_itemByIdCache[ aEntry->m_Uuid ] = aEntry;
+
+                if( isNetIndexed( aEntry ) )
+                    indexNetItem( static_cast<BOARD_CONNECTED_ITEM*>( aEntry ) );
+
+                if( m_spatialIndex && isSpatiallyIndexed( aEntry ) )
+                    m_spatialIndex->Insert( aEntry );
+            };
+
+    std::lock_guard<std::mutex> lock( m_spatialIndexMutex );
+
+    index( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+        static_cast<FOOTPRINT*>( aItem )->RunOnChildren( index );
+}
+
+
+void BOARD::UnindexItem( BOARD_ITEM* aItem )
+{
+    auto unindex =
+            [&]( BOARD_ITEM* aEntry )
+            {
+                // Only drop KIID entries which still refer to aEntry: a replacement item
+                // carrying the same KIID (e.g. an exchanged footprint) may already be there.
+                auto it = m_itemByIdCache.find( aEntry->m_Uuid );
+
+                if( it != m_itemByIdCache.end() && it->second == aEntry )
+                    m_itemByIdCache.erase( it );
+
+                if( isNetIndexed( aEntry ) )
+                    unindexNetItem( static_cast<BOARD_CONNECTED_ITEM*>( aEntry ) );
+
+                if( m_spatialIndex )
+                    m_spatialIndex->Remove( aEntry );
+
+                m_uncommittedItems.erase( aEntry );
+            };
+
+    std::lock_guard<std::mutex> lock( m_spatialIndexMutex );
+
+    unindex( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+        static_cast<FOOTPRINT*>( aItem )->RunOnChildren( unindex );
+}
+
+
+bool BOARD::IsIndexed( const BOARD_ITEM* aItem ) const
+{
+    auto it = m_itemByIdCache.find( aItem->m_Uuid );
+
+    return it != m_itemByIdCache.end() && it->second == aItem;
+}
+
+
+void BOARD::indexNetItem( BOARD_CONNECTED_ITEM* aItem )
+{
+    unindexNetItem( aItem );
+
+    const NETINFO_ITEM* net = aItem->GetNet();
+
+    if( net == NETINFO_LIST::OrphanedItem() )
+        net = nullptr;
+
+    // Items without a net are remembered so that a later SetNet() files them
+    m_indexedItemNets[ aItem ] = net;
+    aItem->m_netIndexed = true;
+
+    if( !net )
+        return;
+
+    BOARD_NET_ITEMS& netItems = m_netItemsIndex[ net ];
+
+    switch( aItem->Type() )
     {
-        if( marker->m_Uuid == aID )
-            return marker;
+    case PCB_PAD_T:
+        netItems.m_Pads.push_back( static_cast<PAD*>( aItem ) );
+        break;
+
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+        netItems.m_Zones.push_back( static_cast<ZONE*>( aItem ) );
+        break;
+
+    default:
+        netItems.m_Tracks.push_back( static_cast<PCB_TRACK*>( aItem ) );
+        break;
     }
+}
 
-    for( PCB_GROUP* group : m_groups )
+
+void BOARD::unindexNetItem( BOARD_CONNECTED_ITEM* aItem )
+{
+    auto it = m_indexedItemNets.find( aItem );
+
+    if( it == m_indexedItemNets.end() )
+        return;
+
+    auto netIt = it->second ? m_netItemsIndex.find( it->second ) : m_netItemsIndex.end();
+
+    m_indexedItemNets.erase( it );
+    aItem->m_netIndexed = false;
+
+    if( netIt == m_netItemsIndex.end() )
+        return;
+
+    BOARD_NET_ITEMS& netItems = netIt->second;
+
+    switch( aItem->Type() )
     {
-        if( group->m_Uuid == aID )
-            return group;
+    case PCB_PAD_T:
+        alg::delete_matching( netItems.m_Pads, aItem );
+        break;
+
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+        alg::delete_matching( netItems.m_Zones, aItem );
+        break;
+
+    default:
+        alg::delete_matching( netItems.m_Tracks, aItem );
+        break;
     }
+}
 
-    if( m_Uuid == aID )
-        return const_cast<BOARD*>( this );
 
-    // Not found; weak reference has been deleted.
-    return DELETED_BOARD_ITEM::GetInstance();
+void BOARD::OnItemNetChanged( BOARD_CONNECTED_ITEM* aItem )
+{
+    auto it = m_indexedItemNets.find( aItem );
+
+    if( it == m_indexedItemNets.end() )
+        return;
+
+    const NETINFO_ITEM* net = aItem->GetNet();
+
+    if( net == NETINFO_LIST::OrphanedItem() )
+        net = nullptr;
+
+    if( it->second != net )
+        indexNetItem( aItem );
 }
 
 
-void BOARD::FillItemMap( std::map<KIID, EDA_ITEM*>& aMap )
+void BOARD::QueryItems( const BOX2I& aArea, PCB_LAYER_ID aLayer,
+                        const std::function<bool( BOARD_ITEM* )>& aVisitor ) const
 {
-    // the board itself
-    aMap[ m_Uuid ] = this;
+    QueryItems( aArea, LSET( aLayer ), aVisitor );
+}
 
-    for( PCB_TRACK* track : Tracks() )
-        aMap[ track->m_Uuid ] = track;
 
-    for( FOOTPRINT* footprint : Footprints() )
+void BOARD::QueryItems( const BOX2I& aArea, LSET aLayers,
+                        const std::function<bool( BOARD_ITEM* )>& aVisitor ) const
+{
+    // The hits are collected under the lock and visited after it is released, so that the
+    // visitor may itself change or query the board.
+    std::vector<BOARD_ITEM*> hits;
+
     {
-        aMap[ footprint->m_Uuid ] = footprint;
+        std::lock_guard<std::mutex> lock( m_spatialIndexMutex );
 
-        for( PAD* pad : footprint->Pads() )
-            aMap[ pad->m_Uuid ] = pad;
+        if( !m_spatialIndex )
+        {
+            m_spatialIndex = std::make_unique<BOARD_RTREE>();
 
-        aMap[ footprint->Reference().m_Uuid ] = &footprint->Reference();
-        aMap[ footprint->Value().m_Uuid ] = &footprint->Value();
+            for( PCB_TRACK* track : m_tracks )
+                m_spatialIndex->Insert( track );
 
-        for( BOARD_ITEM* drawing : footprint->GraphicalItems() )
-            aMap[ drawing->m_Uuid ] = drawing;
+            for( FOOTPRINT* footprint : m_footprints )
+            {
+                m_spatialIndex->Insert( footprint );
+
+                footprint->RunOnChildren(
+                        [&]( BOARD_ITEM* aChild )
+                        {
+                            if( isSpatiallyIndexed( aChild ) )
+                                m_spatialIndex->Insert( aChild );
+                        } );
+            }
+
+            for( ZONE* zone : m_zones )
+                m_spatialIndex->Insert( zone );
+
+            for( BOARD_ITEM* drawing : m_drawings )
+                m_spatialIndex->Insert( drawing );
+        }
+
+        // Items staged for modification may have moved since they were indexed, so they are
+        // tested where they are now rather than where the index has them.
+        auto isUncommitted =
+                [&]( BOARD_ITEM* aItem ) -> bool
+                {
+                    if( m_uncommittedItems.empty() )
+                        return false;
+
+                    if( m_uncommittedItems.count( aItem ) )
+                        return true;
+
+                    BOARD_ITEM* parent = aItem->GetParent();
+
+                    return parent && parent->Type() == PCB_FOOTPRINT_T
+                                && m_uncommittedItems.count( parent );
+                };
+
+        // An item on several of aLayers is only reported once
+        std::unordered_set<BOARD_ITEM*> seen;
+        bool                            multiLayer = aLayers.count() > 1;
+
+        auto collect =
+                [&]( BOARD_ITEM* aItem )
+                {
+                    if( !isUncommitted( aItem ) && ( !multiLayer || seen.insert( aItem ).second ) )
+                        hits.push_back( aItem );
+
+                    return true;
+                };
+
+        for( PCB_LAYER_ID layer : aLayers.Seq() )
+            m_spatialIndex->Query( aArea, layer, collect );
+
+        auto collectCurrent =
+                [&]( BOARD_ITEM* aItem )
+                {
+                    if( !isSpatiallyIndexed( aItem ) || !( aItem->GetLayerSet() & aLayers ).any() )
+                        return;
+
+                    EDA_RECT bbox = aItem->GetBoundingBox();
+                    bbox.Normalize();
+
+                    if( BOX2I( bbox.GetOrigin(), bbox.GetSize() ).Intersects( aArea ) )
+                        hits.push_back( aItem );
+                };
+
+        for( BOARD_ITEM* item : m_uncommittedItems )
+        {
+            BOARD_ITEM* parent = item->GetParent();
+
+            // Children of a staged footprint are visited with it
+            if( parent && parent->Type() == PCB_FOOTPRINT_T && m_uncommittedItems.count( parent ) )
+                continue;
+
+            collectCurrent( item );
+
+            if( item->Type() == PCB_FOOTPRINT_T )
+                static_cast<FOOTPRINT*>( item )->RunOnChildren( collectCurrent );
+        }
     }
 
-    for( ZONE* zone : Zones() )
-        aMap[ zone->m_Uuid ] = zone;
+    for( BOARD_ITEM* item : hits )
+    {
+        if( !aVisitor( item ) )
+            break;
+    }
+}
 
-    for( BOARD_ITEM* drawing : Drawings() )
-        aMap[ drawing->m_Uuid ] = drawing;
 
-    for( PCB_MARKER* marker : m_markers )
-        aMap[ marker->m_Uuid ] = marker;
+void BOARD::OnItemStaged( BOARD_ITEM* aItem )
+{
+    std::lock_guard<std::mutex> lock( m_spatialIndexMutex );
 
-    for( PCB_GROUP* group : m_groups )
-        aMap[ group->m_Uuid ] = group;
+    if( m_itemByIdCache.count( aItem->m_Uuid ) && isSpatiallyIndexed( aItem ) )
+        m_uncommittedItems.insert( aItem );
+}
+
+
+const BOARD_NET_ITEMS& BOARD::GetItemsInNet( int aNetCode ) const
+{
+    static const BOARD_NET_ITEMS emptyNet;
+
+    // Items without a net are filed under nullptr, which an unknown net code must not reach
+    const NETINFO_ITEM* net = m_NetInfo.GetNetItem( aNetCode );
+    auto                it = net ? m_netItemsIndex.find( net ) : m_netItemsIndex.end();
+
+    if( it == m_netItemsIndex.end() )
+        return emptyNet;
+
+    return it->second;
+}
+
+
+void BOARD::FillItemMap( std::map<KIID, EDA_ITEM*>& aMap )
+{
+    // the board itself
+    aMap[ m_Uuid ] = this;
+
+    for( const std::pair<const KIID, BOARD_ITEM*>& entry : m_itemByIdCache )
+        aMap[ entry.first ] = entry.second;
 }
 
 
@@ -1460,18 +1732,19 @@ PAD* BOARD::GetPad( const wxPoint& aPosition, LSET aLayerSet ) const
     if( !aLayerSet.any() )
         aLayerSet = LSET::AllCuMask();
 
-    for( FOOTPRINT* footprint : m_footprints )
-    {
-        PAD* pad = nullptr;
+    BOX2I area( aPosition, VECTOR2I( 0, 0 ) );
+    PAD*  found = nullptr;
 
-        if( footprint->HitTest( aPosition ) )
-            pad = footprint->GetPad( aPosition, aLayerSet );
+    QueryItems( area, aLayerSet,
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( aItem->Type() == PCB_PAD_T && aItem->HitTest( aPosition ) )
+                    found = static_cast<PAD*>( aItem );
 
-        if( pad )
-            return pad;
-    }
+                return found == nullptr;
+            } );
 
-    return nullptr;
+    return found;
 }
 
 
@@ -1487,20 +1760,19 @@ PAD* BOARD::GetPad( const PCB_TRACK* aTrace, ENDPOINT_T aEndPoint ) const
 
 PAD* BOARD::GetPadFast( const wxPoint& aPosition, LSET aLayerSet ) const
 {
-    for( FOOTPRINT* footprint : Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-        if( pad->GetPosition() != aPosition )
-            continue;
+    BOX2I area( aPosition, VECTOR2I( 0, 0 ) );
+    PAD*  found = nullptr;
 
-        // Pad found, it must be on the correct layer
-        if( ( pad->GetLayerSet() & aLayerSet ).any() )
-            return pad;
-        }
-    }
+    QueryItems( area, aLayerSet,
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( aItem->Type() == PCB_PAD_T && aItem->GetPosition() == aPosition )
+                    found = static_cast<PAD*>( aItem );
 
-    return nullptr;
+                return found == nullptr;
+            } );
+
+    return found;
 }
 
 
@@ -1614,11 +1886,16 @@ bool sortPadsByXthenYCoord( PAD* const & aLH, PAD* const & aRH )
 
 void BOARD::GetSortedPadListByXthenYCoord( std::vector<PAD*>& aVector, int aNetCode ) const
 {
-    for( FOOTPRINT* footprint : Footprints() )
+    if( aNetCode >= 0 )
+    {
+        const std::vector<PAD*>& pads = GetItemsInNet( aNetCode ).m_Pads;
+        aVector.insert( aVector.end(), pads.begin(), pads.end() );
+    }
+    else
     {
-        for( PAD* pad : footprint->Pads( ) )
+        for( FOOTPRINT* footprint : Footprints() )
         {
-            if( aNetCode < 0 || pad->GetNetCode() == aNetCode )
+            for( PAD* pad : footprint->Pads( ) )
                 aVector.push_back( pad );
         }
     }
@@ -1729,7 +2006,21 @@ FOOTPRINT* BOARD::GetFootprint( const wxPoint& aPosition, PCB_LAYER_ID aActiveLa
     int        alt_min_dim   = 0x7FFFFFFF;
     bool       current_layer_back = IsBackLayer( aActiveLayer );
 
-    for( FOOTPRINT* candidate : m_footprints )
+    BOX2I                   area( aPosition, VECTOR2I( 0, 0 ) );
+    std::vector<FOOTPRINT*> candidates;
+
+    auto collect =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( aItem->Type() == PCB_FOOTPRINT_T )
+                    candidates.push_back( static_cast<FOOTPRINT*>( aItem ) );
+
+                return true;
+            };
+
+    QueryItems( area, LSET( 2, F_Cu, B_Cu ), collect );
+
+    for( FOOTPRINT* candidate : candidates )
     {
         // is the ref point within the footprint's bounds?
         if( !candidate->HitTest( aPosition ) )
@@ -1813,6 +2104,7 @@ ZONE* BOARD::AddArea( PICKED_ITEMS_LIST* aNewZonesList, int aNetcode, PCB_LAYER_
     new_area->SetLayer( aLayer );
 
     m_zones.push_back( new_area );
+    IndexItem( new_area );
 
     new_area->SetHatchStyle( (ZONE_BORDER_DISPLAY_STYLE) aHatch );
 
@@ -1976,14 +2268,45 @@ void BOARD::RemoveListener( BOARD_LISTENER* aListener )
 }
 
 
+void BOARD::reindexChangedItem( BOARD_ITEM* aItem )
+{
+    // SwapData() exchanges nets without going through SetNet()
+    if( isNetIndexed( aItem ) )
+        OnItemNetChanged( static_cast<BOARD_CONNECTED_ITEM*>( aItem ) );
+
+    std::lock_guard<std::mutex> lock( m_spatialIndexMutex );
+
+    m_uncommittedItems.erase( aItem );
+
+    if( m_spatialIndex )
+    {
+        m_spatialIndex->Update( aItem );
+
+        if( aItem->Type() == PCB_FOOTPRINT_T )
+        {
+            static_cast<FOOTPRINT*>( aItem )->RunOnChildren(
+                    [&]( BOARD_ITEM* aChild )
+                    {
+                        m_spatialIndex->Update( aChild );
+                    } );
+        }
+    }
+}
+
+
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    reindexChangedItem( aItem );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
 void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 {
+    for( BOARD_ITEM* item : aItems )
+        reindexChangedItem( item );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *this, aItems );
 }
 
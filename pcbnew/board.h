@@ -29,6 +29,7 @@
 #include <common.h> // Needed for stl hash extensions
 #include <convert_shape_list_to_polygon.h> // for OUTLINE_ERROR_HANDLER
 #include <layer_ids.h>
+#include <math/box2.h>
 #include <netinfo.h>
 #include <pcb_item_containers.h>
 #include <pcb_plot_params.h>
@@ -36,8 +37,11 @@
 #include <tools/pcb_selection.h>
 #include <mutex>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 class BOARD_DESIGN_SETTINGS;
+class BOARD_RTREE;
 class BOARD_CONNECTED_ITEM;
 class BOARD_COMMIT;
 class DRC_RTREE;
@@ -130,6 +134,17 @@ struct LAYER
 };
 
 
+/**
+ * The items of a single net, as indexed by the board.  See BOARD::GetItemsInNet().
+ */
+struct BOARD_NET_ITEMS
+{
+    std::vector<PCB_TRACK*> m_Tracks;   ///< Tracks, arcs and vias
+    std::vector<PAD*>       m_Pads;
+    std::vector<ZONE*>      m_Zones;    ///< Board and footprint zones
+};
+
+
 // Helper class to handle high light nets
 class HIGH_LIGHT_INFO
 {
@@ -329,6 +344,25 @@ public:
      */
     BOARD_ITEM* GetItem( const KIID& aID ) const;
 
+    /**
+     * Add \a aItem (and the children of a footprint) to the lookup indexes of the board: the
+     * KIID index used by GetItem() and the net index used by GetItemsInNet().
+     *
+     * Items handled by Add() and Remove() are indexed automatically; this is only needed by
+     * code which changes the KIID of an item already on the board, or which bypasses Add().
+     */
+    void IndexItem( BOARD_ITEM* aItem );
+
+    /**
+     * Remove \a aItem (and the children of a footprint) from the lookup indexes.
+     */
+    void UnindexItem( BOARD_ITEM* aItem );
+
+    /**
+     * @return true if \a aItem is in the KIID index, i.e. it has been added to the board.
+     */
+    bool IsIndexed( const BOARD_ITEM* aItem ) const;
+
     void FillItemMap( std::map<KIID, EDA_ITEM*>& aMap );
 
     /**
@@ -986,6 +1020,52 @@ public:
      */
     TRACKS TracksInNet( int aNetCode );
 
+    /**
+     * Return the tracks, pads and zones of a net.
+     *
+     * The board keeps these lists up to date as items are added, removed or change net, so
+     * this is the cheap way of visiting a net.  The lists are in no particular order and
+     * are only valid until the board is modified.
+     */
+    const BOARD_NET_ITEMS& GetItemsInNet( int aNetCode ) const;
+
+    /**
+     * Call \a aVisitor for each item on \a aLayer whose bounding box intersects \a aArea,
+     * until it returns false.
+     *
+     * Covers tracks, zones, drawings, footprints and footprint children.  The index is built
+     * on first use and then kept up to date by Add(), Remove() and OnItemChanged().  Items
+     * staged for modification (see OnItemStaged()) are tested at their current position until
+     * they are committed, so items being moved by a tool are found where they are now.
+     * Callers must still hit-test the items they are handed.
+     *
+     * The visitor is called once the index lock is released, so it may change the board.
+     */
+    void QueryItems( const BOX2I& aArea, PCB_LAYER_ID aLayer,
+                     const std::function<bool( BOARD_ITEM* )>& aVisitor ) const;
+
+    /**
+     * Call \a aVisitor once for each item on any of \a aLayers whose bounding box intersects
+     * \a aArea, until it returns false.  Takes the index lock once for all the layers.
+     */
+    void QueryItems( const BOX2I& aArea, LSET aLayers,
+                     const std::function<bool( BOARD_ITEM* )>& aVisitor ) const;
+
+    /**
+     * Called by BOARD_COMMIT when \a aItem is staged for modification.  Until the commit is
+     * pushed or reverted (or OnItemChanged() is called) the item may move, so QueryItems()
+     * tests it where it is rather than where it was indexed.
+     *
+     * Scripts which move items without a commit must call OnItemChanged() afterwards.
+     */
+    void OnItemStaged( BOARD_ITEM* aItem );
+
+    /**
+     * Move \a aItem to the net index entry of its current net, if it is indexed.
+     * Called by BOARD_CONNECTED_ITEM::SetNet().
+     */
+    void OnItemNetChanged( BOARD_CONNECTED_ITEM* aItem );
+
     /**
      * Get a footprint by its bounding rectangle at \a aPosition on \a aLayer.
      *
@@ -1134,6 +1214,26 @@ private:
     std::map<wxString, wxString>        m_properties;
     std::shared_ptr<CONNECTIVITY_DATA>  m_connectivity;
 
+    void indexNetItem( BOARD_CONNECTED_ITEM* aItem );
+    void reindexChangedItem( BOARD_ITEM* aItem );
+    void unindexNetItem( BOARD_CONNECTED_ITEM* aItem );
+
+    /// Index of the board items and footprint children by KIID, see GetItem()
+    std::unordered_map<KIID, BOARD_ITEM*> m_itemByIdCache;
+
+    /// Index of the tracks, pads and zones by net, see GetItemsInNet()
+    std::unordered_map<const NETINFO_ITEM*, BOARD_NET_ITEMS> m_netItemsIndex;
+
+    /// Net each indexed item was filed under (nullptr for items with no net)
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, const NETINFO_ITEM*> m_indexedItemNets;
+
+    /// Per-layer R-tree of the board items, built on first use; see QueryItems()
+    mutable std::unique_ptr<BOARD_RTREE> m_spatialIndex;
+    mutable std::mutex                   m_spatialIndexMutex;
+
+    /// Items staged for modification since they were last indexed; see OnItemStaged()
+    std::unordered_set<BOARD_ITEM*>      m_uncommittedItems;
+
     PAGE_INFO           m_paper;
     TITLE_BLOCK         m_titles;                   // text in lower right of screen and plots
     PCB_PLOT_PARAMS     m_plotOptions;
@@ -78,6 +78,16 @@ COMMIT& BOARD_COMMIT::Stage( EDA_ITEM* aItem, CHANGE_TYPE aChangeType )
             aItem = item;
     }
 
+    // The item is about to be changed (typically moved) without the board being told until
+    // the commit is pushed; have the board's spatial index look at it where it is meanwhile
+    if( aItem && aChangeType == CHT_MODIFY && m_toolMgr )
+    {
+        BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() );
+
+        if( board )
+            board->OnItemStaged( static_cast<BOARD_ITEM*>( aItem ) );
+    }
+
     return COMMIT::Stage( aItem, aChangeType );
 }
 
@@ -38,6 +38,14 @@ BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype
     m_netinfo( NETINFO_LIST::OrphanedItem() )
 {
     m_localRatsnestVisible = true;
+    m_netIndexed = false;
+}
+
+
+void BOARD_CONNECTED_ITEM::onNetChanged()
+{
+    if( BOARD* board = GetBoard() )
+        board->OnItemNetChanged( this );
 }
 
 
@@ -52,9 +60,9 @@ bool BOARD_CONNECTED_ITEM::SetNetCode( int aNetCode, bool aNoAssert )
     BOARD* board = GetBoard();
 
     if( ( aNetCode >= 0 ) && board )
-        m_netinfo = board->FindNet( aNetCode );
+        SetNet( board->FindNet( aNetCode ) );
     else
-        m_netinfo = NETINFO_LIST::OrphanedItem();
+        SetNet( NETINFO_LIST::OrphanedItem() );
 
     if( !aNoAssert )
         wxASSERT( m_netinfo );
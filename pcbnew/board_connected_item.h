@@ -82,7 +82,15 @@ public:
      */
     void SetNet( NETINFO_ITEM* aNetInfo )
     {
+        if( aNetInfo == m_netinfo )
+            return;
+
         m_netinfo = aNetInfo;
+
+        // Only items filed in their board's net index have to tell it; items being built,
+        // clones and library footprints never leave this inline path.
+        if( m_netIndexed )
+            onNetChanged();
     }
 
     /**
@@ -191,7 +199,14 @@ protected:
     NETINFO_ITEM* m_netinfo;
 
 private:
+    friend class BOARD;
+
+    void onNetChanged();
+
     bool m_localRatsnestVisible;
+
+    /// Set by #BOARD while the item may be in its net index.
+    bool m_netIndexed;
 };
 
 #endif  // BOARD_CONNECTED_ITEM_H
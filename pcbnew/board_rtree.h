@@ -0,0 +1,138 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef BOARD_RTREE_H_
+#define BOARD_RTREE_H_
+
+#include <board_item.h>
+#include <layer_ids.h>
+#include <math/box2.h>
+
+#include <array>
+#include <climits>
+#include <memory>
+#include <unordered_map>
+
+#include <geometry/rtree.h>
+
+/**
+ * Non-owning per-layer R-tree of board items, indexed by bounding box.
+ *
+ * The box and layers each item was inserted with are remembered, so an item can be removed
+ * (or updated) after it has been moved or changed layers.
+ */
+class BOARD_RTREE
+{
+private:
+    using board_rtree = RTree<BOARD_ITEM*, int, 2, double>;
+
+    struct ENTRY
+    {
+        BOX2I bbox;
+        LSET  layers;
+    };
+
+public:
+    /**
+     * Insert an item on each of its layers.  Does nothing if the item is already indexed.
+     */
+    void Insert( BOARD_ITEM* aItem )
+    {
+        if( m_entries.count( aItem ) )
+            return;
+
+        EDA_RECT bbox = aItem->GetBoundingBox();
+        bbox.Normalize();
+
+        ENTRY& entry = m_entries[aItem];
+        entry.bbox = BOX2I( bbox.GetOrigin(), bbox.GetSize() );
+        entry.layers = aItem->GetLayerSet() & LSET::AllLayersMask();
+
+        const int mmin[2] = { entry.bbox.GetX(), entry.bbox.GetY() };
+        const int mmax[2] = { entry.bbox.GetRight(), entry.bbox.GetBottom() };
+
+        for( PCB_LAYER_ID layer : entry.layers.Seq() )
+        {
+            if( !m_tree[layer] )
+                m_tree[layer] = std::make_unique<board_rtree>();
+
+            m_tree[layer]->Insert( mmin, mmax, aItem );
+        }
+    }
+
+    /**
+     * Remove an item, using the box and layers it was inserted with.
+     */
+    void Remove( BOARD_ITEM* aItem )
+    {
+        auto it = m_entries.find( aItem );
+
+        if( it == m_entries.end() )
+            return;
+
+        const ENTRY& entry = it->second;
+        const int    mmin[2] = { entry.bbox.GetX(), entry.bbox.GetY() };
+        const int    mmax[2] = { entry.bbox.GetRight(), entry.bbox.GetBottom() };
+
+        for( PCB_LAYER_ID layer : entry.layers.Seq() )
+            m_tree[layer]->Remove( mmin, mmax, aItem );
+
+        m_entries.erase( it );
+    }
+
+    /**
+     * Re-insert an already indexed item with its current box and layers.
+     */
+    void Update( BOARD_ITEM* aItem )
+    {
+        if( m_entries.count( aItem ) )
+        {
+            Remove( aItem );
+            Insert( aItem );
+        }
+    }
+
+    /**
+     * Execute \a aVisitor for each item on \a aLayer whose bounding box intersects \a aBounds.
+     * The search stops when the visitor returns false.
+     */
+    template <class Visitor>
+    void Query( const BOX2I& aBounds, PCB_LAYER_ID aLayer, Visitor& aVisitor ) const
+    {
+        if( aLayer < 0 || aLayer >= PCB_LAYER_ID_COUNT || !m_tree[aLayer] )
+            return;
+
+        const int mmin[2] = { aBounds.GetX(), aBounds.GetY() };
+        const int mmax[2] = { aBounds.GetRight(), aBounds.GetBottom() };
+
+        m_tree[aLayer]->Search( mmin, mmax, aVisitor );
+    }
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    std::array<std::unique_ptr<board_rtree>, PCB_LAYER_ID_COUNT> m_tree;
+    std::unordered_map<BOARD_ITEM*, ENTRY>                       m_entries;
+};
+
+#endif /* BOARD_RTREE_H_ */
@@ -31,10 +31,12 @@
 
 #include <wx/log.h>
 
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <algorithm>
 #include <future>
+#include <unordered_map>
 
 #ifdef PROFILE
 #include <profile.h>
@@ -173,6 +175,7 @@ bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
             return false;
 
         m_itemMap[zone] = ITEM_MAP_ENTRY();
+        m_itemMap[zone].m_netCode = zone->GetNetCode();
 
         for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
         {
@@ -430,11 +433,10 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     size *= 2;      // Our caller us gets the other half of the progress bar
 
-    for( ZONE* zone : aBoard->Zones() )
-    {
-        Add( zone );
-        reportProgress( aReporter, ii++, size, delta );
-    }
+    addZones( std::vector<ZONE*>( aBoard->Zones().begin(), aBoard->Zones().end() ) );
+
+    ii += aBoard->Zones().size();
+    reportProgress( aReporter, ii, size, 1 );
 
     for( PCB_TRACK* tv : aBoard->Tracks() )
     {
@@ -453,6 +455,68 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 }
 
 
+void CN_CONNECTIVITY_ALGO::addZones( const std::vector<ZONE*>& aZones )
+{
+    std::vector<std::pair<ZONE*, PCB_LAYER_ID>> zoneLayers;
+
+    for( ZONE* zone : aZones )
+    {
+        if( !zone->IsOnCopperLayer() || m_itemMap.find( zone ) != m_itemMap.end() )
+            continue;
+
+        markItemNetAsDirty( zone );
+        m_itemMap[zone] = ITEM_MAP_ENTRY();
+        m_itemMap[zone].m_netCode = zone->GetNetCode();
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            zoneLayers.emplace_back( zone, layer );
+    }
+
+    std::vector<std::vector<CN_ZONE_LAYER*>> zoneItems( zoneLayers.size() );
+    std::atomic<size_t>                      nextItem( 0 );
+
+    auto build_lambda =
+            [&]() -> size_t
+            {
+                for( size_t i = nextItem++; i < zoneLayers.size(); i = nextItem++ )
+                {
+                    zoneItems[i] = CN_LIST::BuildZoneItems( zoneLayers[i].first,
+                                                            zoneLayers[i].second );
+                }
+
+                return 1;
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   zoneLayers.size() );
+
+    if( parallelThreadCount <= 1 )
+    {
+        build_lambda();
+    }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, build_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    // The item list and its R-tree are not thread-safe; insert serially and in order
+    for( size_t i = 0; i < zoneLayers.size(); i++ )
+    {
+        for( CN_ZONE_LAYER* zitem : zoneItems[i] )
+        {
+            m_itemList.Add( zitem );
+            m_itemMap[ zoneLayers[i].first ].Link( zitem );
+        }
+    }
+}
+
+
 void CN_CONNECTIVITY_ALGO::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
     for( auto item : aItems )
@@ -520,6 +584,7 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit, PROPAGAT
                             aCommit->Modify( item->Parent() );
 
                         item->Parent()->SetNetCode( cluster->OriginNet() );
+                        m_itemMap[ item->Parent() ].m_netCode = cluster->OriginNet();
                         n_changed++;
                     }
                 }
@@ -578,36 +643,141 @@ void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( ZONE* aZone, PCB_LAYER_ID
     wxLogTrace( "CN", "Found %u isolated islands\n", (unsigned)aIslands.size() );
 }
 
+bool CN_CONNECTIVITY_ALGO::MatchesBoard( const BOARD* aBoard )
+{
+    // Number of non-empty m_itemMap entries accounted for by board items.  Keys of entries
+    // not accounted for may point to deleted items, so they are counted but never touched.
+    size_t matched = 0;
+
+    auto findEntry =
+            [&]( const BOARD_CONNECTED_ITEM* aItem ) -> const ITEM_MAP_ENTRY*
+            {
+                auto it = m_itemMap.find( aItem );
+
+                if( it == m_itemMap.end() || it->second.m_netCode != aItem->GetNetCode() )
+                    return nullptr;
+
+                if( !it->second.m_items.empty() )
+                    matched++;
+
+                return &it->second;
+            };
+
+    auto matches =
+            [&]( const BOARD_CONNECTED_ITEM* aItem, std::initializer_list<VECTOR2I> aAnchors )
+            {
+                const ITEM_MAP_ENTRY* entry = findEntry( aItem );
+
+                if( !entry || entry->m_items.size() != 1 )
+                    return false;
+
+                CN_ITEM* item = entry->m_items.front();
+
+                if( !item->Valid() || item->Anchors().size() != aAnchors.size() )
+                    return false;
+
+                auto anchor = item->Anchors().begin();
+
+                for( const VECTOR2I& pos : aAnchors )
+                {
+                    if( ( *anchor++ )->Pos() != pos )
+                        return false;
+                }
+
+                return true;
+            };
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( !track->IsOnCopperLayer() )
+            continue;
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            if( !matches( track, { track->GetStart() } ) )
+                return false;
+        }
+        else
+        {
+            if( !matches( track, { track->GetStart(), track->GetEnd() } ) )
+                return false;
+
+            if( m_itemMap[ track ].m_items.front()->Layer() != track->GetLayer() )
+                return false;
+        }
+    }
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->IsOnCopperLayer() && !matches( pad, { pad->ShapePos() } ) )
+                return false;
+        }
+    }
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        if( !zone->IsOnCopperLayer() )
+            continue;
+
+        const ITEM_MAP_ENTRY* entry = findEntry( zone );
+
+        if( !entry )
+            return false;
+
+        for( CN_ITEM* item : entry->m_items )
+        {
+            if( !item->Valid() )
+                return false;
+        }
+    }
+
+    // Anything left over was removed from the board behind our back
+    size_t known = std::count_if( m_itemMap.begin(), m_itemMap.end(),
+                                  []( const std::pair<const BOARD_ITEM* const,
+                                                      ITEM_MAP_ENTRY>& aEntry )
+                                  {
+                                      return !aEntry.second.m_items.empty();
+                                  } );
+
+    return known == matched;
+}
+
+
 void CN_CONNECTIVITY_ALGO::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones )
 {
-    for( auto& z : aZones )
+    std::vector<ZONE*>                                               zones;
+    std::unordered_map<const BOARD_ITEM*, CN_ZONE_ISOLATED_ISLAND_LIST*> zoneLists;
+
+    for( CN_ZONE_ISOLATED_ISLAND_LIST& z : aZones )
     {
         Remove( z.m_zone );
-        Add( z.m_zone );
+        zones.push_back( z.m_zone );
+        zoneLists[ z.m_zone ] = &z;
     }
 
+    addZones( zones );
+
     m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
 
-    for( CN_ZONE_ISOLATED_ISLAND_LIST& zone : aZones )
+    // A single pass over the orphaned clusters, rather than one per zone layer
+    for( const CN_CLUSTER_PTR& cluster : m_connClusters )
     {
-        for( PCB_LAYER_ID layer : zone.m_zone->GetLayerSet().Seq() )
+        if( !cluster->IsOrphaned() )
+            continue;
+
+        for( CN_ITEM* z : *cluster )
         {
-            if( zone.m_zone->GetFilledPolysList( layer ).IsEmpty() )
+            if( z->Parent()->Type() != PCB_ZONE_T )
                 continue;
 
-            for( const CN_CLUSTER_PTR& cluster : m_connClusters )
+            auto it = zoneLists.find( z->Parent() );
+
+            if( it != zoneLists.end() )
             {
-                if( cluster->Contains( zone.m_zone ) && cluster->IsOrphaned() )
-                {
-                    for( CN_ITEM* z : *cluster )
-                    {
-                        if( z->Parent() == zone.m_zone && z->Layer() == layer )
-                        {
-                            zone.m_islands[layer].push_back(
-                                    static_cast<CN_ZONE_LAYER*>( z )->SubpolyIndex() );
-                        }
-                    }
-                }
+                it->second->m_islands[ (PCB_LAYER_ID) z->Layer() ].push_back(
+                        static_cast<CN_ZONE_LAYER*>( z )->SubpolyIndex() );
             }
         }
     }
@@ -640,6 +810,15 @@ void CN_CONNECTIVITY_ALGO::MarkNetAsDirty( int aNet )
     }
 
     m_dirtyNets[aNet] = true;
+
+    // Revisions come from a process-wide counter so that they are never reused, even when
+    // the whole connectivity algo is rebuilt.
+    static std::atomic<uint64_t> s_nextRevision( 1 );
+
+    if( (int) m_netRevisions.size() <= aNet )
+        m_netRevisions.resize( aNet + 1, 0 );
+
+    m_netRevisions[aNet] = s_nextRevision++;
 }
 
 
@@ -811,6 +990,9 @@ bool CN_VISITOR::operator()( CN_ITEM* aCandidate )
 
 void CN_CONNECTIVITY_ALGO::Clear()
 {
+    for( int net = 0; net < (int) m_netRevisions.size(); ++net )
+        MarkNetAsDirty( net );
+
     m_ratsnestClusters.clear();
     m_connClusters.clear();
     m_itemMap.clear();
@@ -57,14 +57,21 @@ class BOARD_ITEM;
 class ZONE;
 class PROGRESS_REPORTER;
 
+/**
+ * An edge of the ratsnest graph.
+ *
+ * The anchors are not owned by the edge: they are kept alive by the RN_NET the edge was
+ * computed for, so copying and sorting edges costs no reference counting.  Edges must not be
+ * kept past the next ratsnest update; CONNECTIVITY_DATA hands out RN_EDGE copies instead.
+ */
 class CN_EDGE
 {
 public:
     CN_EDGE()
-            : m_weight( 0 ), m_visible( true )
+            : m_source( nullptr ), m_target( nullptr ), m_weight( 0 ), m_visible( true )
     {}
 
-    CN_EDGE( CN_ANCHOR_PTR aSource, CN_ANCHOR_PTR aTarget, unsigned aWeight = 0 )
+    CN_EDGE( CN_ANCHOR* aSource, CN_ANCHOR* aTarget, unsigned aWeight = 0 )
             : m_source( aSource ), m_target( aTarget ), m_weight( aWeight ), m_visible( true )
     {}
 
@@ -74,17 +81,17 @@ public:
      * @param aOther the other edge to compare.
      * @return true if our weight is smaller than the other weight.
      */
-    bool operator<( CN_EDGE aOther ) const
+    bool operator<( const CN_EDGE& aOther ) const
     {
         return m_weight < aOther.m_weight;
     }
 
-    CN_ANCHOR_PTR GetSourceNode() const { return m_source; }
-    CN_ANCHOR_PTR GetTargetNode() const { return m_target; }
+    CN_ANCHOR* GetSourceNode() const { return m_source; }
+    CN_ANCHOR* GetTargetNode() const { return m_target; }
     unsigned GetWeight() const { return m_weight; }
 
-    void SetSourceNode( const CN_ANCHOR_PTR& aNode ) { m_source = aNode; }
-    void SetTargetNode( const CN_ANCHOR_PTR& aNode ) { m_target = aNode; }
+    void SetSourceNode( CN_ANCHOR* aNode ) { m_source = aNode; }
+    void SetTargetNode( CN_ANCHOR* aNode ) { m_target = aNode; }
     void SetWeight( unsigned weight ) { m_weight = weight; }
 
     void SetVisible( bool aVisible )
@@ -108,8 +115,8 @@ public:
     }
 
 private:
-    CN_ANCHOR_PTR m_source;
-    CN_ANCHOR_PTR m_target;
+    CN_ANCHOR* m_source;
+    CN_ANCHOR* m_target;
     unsigned m_weight;
     bool m_visible;
 };
@@ -129,7 +136,8 @@ public:
     class ITEM_MAP_ENTRY
     {
     public:
-        ITEM_MAP_ENTRY( CN_ITEM* aItem = nullptr )
+        ITEM_MAP_ENTRY( CN_ITEM* aItem = nullptr ) :
+                m_netCode( aItem ? aItem->Net() : -1 )
         {
             if( aItem )
                 m_items.push_back( aItem );
@@ -154,6 +162,8 @@ public:
         }
 
         std::list<CN_ITEM*> m_items;
+        int                 m_netCode;  ///< net of the board item when it was added, or as
+                                        ///< last set by propagateConnections()
     };
 
     CN_CONNECTIVITY_ALGO() {}
@@ -199,6 +209,22 @@ public:
         return m_dirtyNets.size();
     }
 
+    /**
+     * Return the revision of a net's connectivity.  The revision changes every time an item
+     * of the net is added, removed or updated, and revisions are never reused, not even
+     * across CN_CONNECTIVITY_ALGO instances.  This allows caches of per-net results to be
+     * validated without being notified of every change.
+     *
+     * @return the revision, or 0 if the net has never held any item.
+     */
+    uint64_t GetNetRevision( int aNet ) const
+    {
+        if( aNet < 0 || aNet >= (int) m_netRevisions.size() )
+            return 0;
+
+        return m_netRevisions[ aNet ];
+    }
+
     void Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter = nullptr );
     void Build( const std::vector<BOARD_ITEM*>& aItems );
 
@@ -231,6 +257,19 @@ public:
      */
     void FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones );
 
+    /**
+     * Check that the connectivity holds exactly the copper tracks, vias, pads and zones of
+     * \a aBoard, each with the net it has now, and that tracks, vias and pads are at the
+     * position and (for tracks) on the layer they have now.
+     *
+     * Zone outlines and fills are not compared: the fills are re-inserted by
+     * FindIsolatedCopperIslands().
+     *
+     * @return false if an item was added, removed, moved or changed net or layer without the
+     *         connectivity being told, e.g. by a script.
+     */
+    bool MatchesBoard( const BOARD* aBoard );
+
     const CLUSTERS& GetClusters();
 
     const CN_LIST& ItemList() const
@@ -272,6 +311,12 @@ private:
         m_itemMap[ brditem ] = ITEM_MAP_ENTRY( item );
     }
 
+    /**
+     * Add a set of zones.  Equivalent to calling Add() for each of them, but the zone items
+     * (and their point-in-polygon partitions) are built on worker threads.
+     */
+    void addZones( const std::vector<ZONE*>& aZones );
+
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
     CN_LIST m_itemList;
@@ -281,6 +326,7 @@ private:
     CLUSTERS m_connClusters;
     CLUSTERS m_ratsnestClusters;
     std::vector<bool> m_dirtyNets;
+    std::vector<uint64_t> m_netRevisions;
     PROGRESS_REPORTER* m_progressReporter = nullptr;
 
 };
@@ -71,6 +71,7 @@ bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 {
     m_connAlgo->Remove( aItem );
+    m_fromToCache->Remove( aItem );
     return true;
 }
 
@@ -85,6 +86,11 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 
 void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    {
+        std::lock_guard<std::mutex> lock( m_netCacheMutex );
+        m_board = aBoard;
+    }
+
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aBoard, aReporter );
 
@@ -100,6 +106,8 @@ void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
 void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
+    ClearBoard();
+
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aItems );
 
@@ -124,9 +132,20 @@ void CONNECTIVITY_DATA::updateRatsnest()
     std::vector<RN_NET*> dirty_nets;
 
     // Start with net 1 as net 0 is reserved for not-connected
-    // Nets without nodes are also ignored
-    std::copy_if( m_nets.begin() + 1, m_nets.end(), std::back_inserter( dirty_nets ),
-            [] ( RN_NET* aNet ) { return aNet->IsDirty() && aNet->GetNodeCount() > 0; } );
+    for( auto it = m_nets.begin() + 1; it != m_nets.end(); ++it )
+    {
+        RN_NET* net = *it;
+
+        if( !net->IsDirty() )
+            continue;
+
+        // A net which lost all its nodes has nothing to compute, but must still drop its old
+        // ratsnest and the state kept from it for the next incremental update.
+        if( net->GetNodeCount() == 0 )
+            net->Update();
+        else
+            dirty_nets.push_back( net );
+    }
 
     // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
     size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
@@ -247,7 +266,7 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
 
             for( const auto& cnItem : entry.GetItems() )
             {
-                for( auto anchor : cnItem->Anchors() )
+                for( const auto& anchor : cnItem->Anchors() )
                     anchor->SetNoLine( true );
             }
         }
@@ -275,6 +294,12 @@ void CONNECTIVITY_DATA::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_
 }
 
 
+bool CONNECTIVITY_DATA::MatchesBoard( const BOARD* aBoard ) const
+{
+    return m_connAlgo->MatchesBoard( aBoard );
+}
+
+
 void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems,
                                                 const CONNECTIVITY_DATA* aDynamicData )
 {
@@ -292,7 +317,8 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
         if( dynNet->GetNodeCount() != 0 )
         {
             auto ourNet = m_nets[nc];
-            CN_ANCHOR_PTR nodeA, nodeB;
+            CN_ANCHOR* nodeA = nullptr;
+            CN_ANCHOR* nodeB = nullptr;
 
             if( ourNet->NearestBicoloredPair( *dynNet, nodeA, nodeB ) )
             {
@@ -309,15 +335,13 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
     // This gets the ratsnest for internal connections in the moving set
     const auto& edges = GetRatsnestForItems( aItems );
 
-    for( const auto& edge : edges )
+    for( const RN_EDGE& edge : edges )
     {
-        const auto& nodeA   = edge.GetSourceNode();
-        const auto& nodeB   = edge.GetTargetNode();
         RN_DYNAMIC_LINE l;
 
         // Use the parents' positions
-        l.a = nodeA->Parent()->GetPosition();
-        l.b = nodeB->Parent()->GetPosition();
+        l.a = edge.source->GetPosition();
+        l.b = edge.target->GetPosition();
         l.netCode = 0;
         m_dynamicRatsnest.push_back( l );
     }
@@ -404,6 +428,16 @@ void CONNECTIVITY_DATA::Clear()
         delete net;
 
     m_nets.clear();
+
+    ClearBoard();
+}
+
+
+void CONNECTIVITY_DATA::ClearBoard()
+{
+    std::lock_guard<std::mutex> lock( m_netCacheMutex );
+
+    m_board = nullptr;
 }
 
 
@@ -441,6 +475,19 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetNetItems( int aNe
     std::vector<BOARD_CONNECTED_ITEM*> items;
     items.reserve( 32 );
 
+    ForEachNetItem( aNetCode, aTypes,
+            [&]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                items.push_back( aItem );
+            } );
+
+    return items;
+}
+
+
+void CONNECTIVITY_DATA::ForEachNetItem( int aNetCode, const KICAD_T aTypes[],
+        const std::function<void( BOARD_CONNECTED_ITEM* )>& aFunc ) const
+{
     std::bitset<MAX_STRUCT_TYPE_ID> type_bits;
 
     for( unsigned int i = 0; aTypes[i] != EOT; ++i )
@@ -449,14 +496,172 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetNetItems( int aNe
         type_bits.set( aTypes[i] );
     }
 
-    m_connAlgo->ForEachItem( [&]( CN_ITEM& aItem ) {
-        if( aItem.Valid() && ( aItem.Net() == aNetCode ) && type_bits[aItem.Parent()->Type()] )
-            items.push_back( aItem.Parent() );
-    } );
+    std::shared_ptr<const NET_ITEMS> items = netItems( aNetCode );
 
-    std::sort( items.begin(), items.end() );
-    items.erase( std::unique( items.begin(), items.end() ), items.end() );
-    return items;
+    for( BOARD_CONNECTED_ITEM* item : *items )
+    {
+        if( type_bits[item->Type()] )
+            aFunc( item );
+    }
+}
+
+
+std::shared_ptr<const CONNECTIVITY_DATA::NET_ITEMS> CONNECTIVITY_DATA::netItems( int aNet ) const
+{
+    static const std::shared_ptr<const NET_ITEMS> emptyNet = std::make_shared<NET_ITEMS>();
+
+    if( aNet < 0 )
+        return emptyNet;
+
+    std::lock_guard<std::mutex> lock( m_netCacheMutex );
+
+    updateNetCache();
+
+    if( aNet >= (int) m_netItems.size() || !m_netItems[ aNet ] )
+        return emptyNet;
+
+    return m_netItems[ aNet ];
+}
+
+
+CN_NET_LENGTHS CONNECTIVITY_DATA::GetNetLengths( int aNet )
+{
+    if( aNet < 0 )
+        return CN_NET_LENGTHS();
+
+    std::lock_guard<std::mutex> lock( m_netCacheMutex );
+
+    updateNetCache();
+
+    if( aNet >= (int) m_netLengths.size() )
+        return CN_NET_LENGTHS();
+
+    return m_netLengths[ aNet ];
+}
+
+
+void CONNECTIVITY_DATA::updateNetCache() const
+{
+    int              netCount = std::max( m_connAlgo->NetCount(), (int) m_netLengths.size() );
+    std::vector<int> staleNets;
+
+    m_netLengths.resize( netCount );
+    m_netItems.resize( netCount );
+
+    for( int net = 0; net < netCount; net++ )
+    {
+        if( m_netLengths[ net ].m_Revision != m_connAlgo->GetNetRevision( net ) )
+            staleNets.push_back( net );
+    }
+
+    if( staleNets.empty() )
+        return;
+
+    std::vector<bool> stale( netCount, false );
+
+    // Fresh lists for the stale nets; the current ones may be in use by ForEachNetItem()
+    std::vector<NET_ITEMS> freshItems( netCount );
+
+    for( int net : staleNets )
+    {
+        m_netLengths[ net ] = CN_NET_LENGTHS();
+        m_netLengths[ net ].m_Revision = m_connAlgo->GetNetRevision( net );
+        stale[ net ] = true;
+    }
+
+    auto addItem =
+            [&]( int aNet, BOARD_CONNECTED_ITEM* aItem )
+            {
+                CN_NET_LENGTHS& lengths = m_netLengths[ aNet ];
+
+                freshItems[ aNet ].push_back( aItem );
+
+                switch( aItem->Type() )
+                {
+                case PCB_PAD_T:
+                    lengths.m_PadCount++;
+                    lengths.m_PadToDieLength += static_cast<PAD*>( aItem )->GetPadToDieLength();
+                    break;
+
+                case PCB_VIA_T:
+                    lengths.m_RoutedItemCount++;
+                    lengths.m_Vias.push_back( static_cast<PCB_VIA*>( aItem ) );
+                    break;
+
+                case PCB_TRACE_T:
+                case PCB_ARC_T:
+                    lengths.m_RoutedItemCount++;
+                    lengths.m_TrackLength += static_cast<PCB_TRACK*>( aItem )->GetLength();
+                    break;
+
+                default:
+                    break;
+                }
+            };
+
+    if( m_board )
+    {
+        // Only the items of the connectivity count, e.g. not pads off the copper layers
+        auto isConnected =
+                [&]( BOARD_CONNECTED_ITEM* aItem )
+                {
+                    if( !m_connAlgo->ItemExists( aItem ) )
+                        return false;
+
+                    for( CN_ITEM* cnItem : m_connAlgo->ItemEntry( aItem ).m_items )
+                    {
+                        if( cnItem->Valid() )
+                            return true;
+                    }
+
+                    return false;
+                };
+
+        for( int net : staleNets )
+        {
+            const BOARD_NET_ITEMS& netItems = m_board->GetItemsInNet( net );
+
+            for( PCB_TRACK* track : netItems.m_Tracks )
+            {
+                if( isConnected( track ) )
+                    addItem( net, track );
+            }
+
+            for( PAD* pad : netItems.m_Pads )
+            {
+                if( isConnected( pad ) )
+                    addItem( net, pad );
+            }
+
+            for( ZONE* zone : netItems.m_Zones )
+            {
+                if( isConnected( zone ) )
+                    addItem( net, zone );
+            }
+        }
+    }
+    else
+    {
+        m_connAlgo->ForEachItem(
+                [&]( CN_ITEM& aItem )
+                {
+                    int net = aItem.Net();
+
+                    if( aItem.Valid() && net >= 0 && net < netCount && stale[ net ] )
+                        addItem( net, aItem.Parent() );
+                } );
+    }
+
+    // Zones own one CN_ITEM per layer and outline but must be listed once
+    for( int net : staleNets )
+    {
+        NET_ITEMS& items = freshItems[ net ];
+
+        std::sort( items.begin(), items.end() );
+        items.erase( std::unique( items.begin(), items.end() ), items.end() );
+
+        m_netItems[ net ] = std::make_shared<const NET_ITEMS>( std::move( items ) );
+    }
 }
 
 
@@ -485,27 +690,44 @@ bool CONNECTIVITY_DATA::CheckConnectivity( std::vector<CN_DISJOINT_NET_ENTRY>& a
 }
 
 
-const std::vector<PCB_TRACK*> CONNECTIVITY_DATA::GetConnectedTracks(
-                                                        const BOARD_CONNECTED_ITEM* aItem ) const
+void CONNECTIVITY_DATA::ForEachNeighbor( const BOARD_CONNECTED_ITEM* aItem,
+        const KICAD_T aTypes[],
+        const std::function<void( BOARD_CONNECTED_ITEM* )>& aFunc ) const
 {
-    auto& entry = m_connAlgo->ItemEntry( aItem );
+    std::bitset<MAX_STRUCT_TYPE_ID> type_bits;
 
-    std::set<PCB_TRACK*> tracks;
-    std::vector<PCB_TRACK*> rv;
+    for( unsigned int i = 0; aTypes[i] != EOT; ++i )
+    {
+        wxASSERT( aTypes[i] < MAX_STRUCT_TYPE_ID );
+        type_bits.set( aTypes[i] );
+    }
 
-    for( CN_ITEM* citem : entry.GetItems() )
+    for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
         {
-            if( connected->Valid() &&
-                    ( connected->Parent()->Type() == PCB_TRACE_T ||
-                            connected->Parent()->Type() == PCB_VIA_T ||
-                            connected->Parent()->Type() == PCB_ARC_T ) )
-                tracks.insert( static_cast<PCB_TRACK*> ( connected->Parent() ) );
+            if( connected->Valid() && type_bits[connected->Parent()->Type()] )
+                aFunc( connected->Parent() );
         }
     }
+}
+
+
+const std::vector<PCB_TRACK*> CONNECTIVITY_DATA::GetConnectedTracks(
+                                                        const BOARD_CONNECTED_ITEM* aItem ) const
+{
+    static const KICAD_T types[] = { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, EOT };
+
+    std::vector<PCB_TRACK*> rv;
 
-    std::copy( tracks.begin(), tracks.end(), std::back_inserter( rv ) );
+    ForEachNeighbor( aItem, types,
+            [&]( BOARD_CONNECTED_ITEM* aConnected )
+            {
+                rv.push_back( static_cast<PCB_TRACK*>( aConnected ) );
+            } );
+
+    std::sort( rv.begin(), rv.end() );
+    rv.erase( std::unique( rv.begin(), rv.end() ), rv.end() );
     return rv;
 }
 
@@ -513,26 +735,31 @@ const std::vector<PCB_TRACK*> CONNECTIVITY_DATA::GetConnectedTracks(
 void CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem,
                                           std::set<PAD*>* pads ) const
 {
-    for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
-    {
-        for( CN_ITEM* connected : citem->ConnectedItems() )
-        {
-            if( connected->Valid() && connected->Parent()->Type() == PCB_PAD_T )
-                pads->insert( static_cast<PAD*> ( connected->Parent() ) );
-        }
-    }
+    static const KICAD_T types[] = { PCB_PAD_T, EOT };
+
+    ForEachNeighbor( aItem, types,
+            [&]( BOARD_CONNECTED_ITEM* aConnected )
+            {
+                pads->insert( static_cast<PAD*>( aConnected ) );
+            } );
 }
 
 
 const std::vector<PAD*> CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem )
 const
 {
-    std::set<PAD*>    pads;
+    static const KICAD_T types[] = { PCB_PAD_T, EOT };
+
     std::vector<PAD*> rv;
 
-    GetConnectedPads( aItem, &pads );
+    ForEachNeighbor( aItem, types,
+            [&]( BOARD_CONNECTED_ITEM* aConnected )
+            {
+                rv.push_back( static_cast<PAD*>( aConnected ) );
+            } );
 
-    std::copy( pads.begin(), pads.end(), std::back_inserter( rv ) );
+    std::sort( rv.begin(), rv.end() );
+    rv.erase( std::unique( rv.begin(), rv.end() ), rv.end() );
     return rv;
 }
 
@@ -727,7 +954,7 @@ const std::vector<BOARD_CONNECTED_ITEM*> CONNECTIVITY_DATA::GetConnectedItemsAtA
     {
         for( auto connected : cnItem->ConnectedItems() )
         {
-            for( auto anchor : connected->Anchors() )
+            for( const auto& anchor : connected->Anchors() )
             {
                 if( ( anchor->Pos() - aAnchor ).SquaredEuclideanNorm() <= maxErrorSq )
                 {
@@ -782,10 +1009,20 @@ void CONNECTIVITY_DATA::SetProgressReporter( PROGRESS_REPORTER* aReporter )
 }
 
 
-const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForItems( std::vector<BOARD_ITEM*> aItems )
+/**
+ * Copy what a caller needs out of \a aEdge, whose anchors only live as long as its RN_NET.
+ */
+static RN_EDGE copyEdge( const CN_EDGE& aEdge )
+{
+    return RN_EDGE{ aEdge.GetSourceNode()->Parent(), aEdge.GetTargetNode()->Parent(),
+                    aEdge.GetSourcePos(), aEdge.GetTargetPos() };
+}
+
+
+const std::vector<RN_EDGE> CONNECTIVITY_DATA::GetRatsnestForItems( std::vector<BOARD_ITEM*> aItems )
 {
     std::set<int> nets;
-    std::vector<CN_EDGE> edges;
+    std::vector<RN_EDGE> edges;
     std::set<BOARD_CONNECTED_ITEM*> item_set;
 
     for( BOARD_ITEM* item : aItems )
@@ -813,8 +1050,8 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForItems( std::vector<B
 
         for( const CN_EDGE& edge : net->GetEdges() )
         {
-            std::shared_ptr<CN_ANCHOR> srcNode = edge.GetSourceNode();
-            std::shared_ptr<CN_ANCHOR> dstNode = edge.GetTargetNode();
+            CN_ANCHOR* srcNode = edge.GetSourceNode();
+            CN_ANCHOR* dstNode = edge.GetTargetNode();
 
             BOARD_CONNECTED_ITEM* srcParent = srcNode->Parent();
             BOARD_CONNECTED_ITEM* dstParent = dstNode->Parent();
@@ -823,7 +1060,7 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForItems( std::vector<B
             bool dstFound = ( item_set.find( dstParent ) != item_set.end() );
 
             if ( srcFound && dstFound )
-                edges.push_back( edge );
+                edges.push_back( copyEdge( edge ) );
         }
     }
 
@@ -831,26 +1068,26 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForItems( std::vector<B
 }
 
 
-const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad )
+const std::vector<RN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad )
 {
-    std::vector<CN_EDGE> edges;
+    std::vector<RN_EDGE> edges;
     RN_NET* net = GetRatsnestForNet( aPad->GetNetCode() );
 
     for( const CN_EDGE& edge : net->GetEdges() )
     {
         if( edge.GetSourceNode()->Parent() == aPad || edge.GetTargetNode()->Parent() == aPad )
-            edges.push_back( edge );
+            edges.push_back( copyEdge( edge ) );
     }
 
     return edges;
 }
 
 
-const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForComponent( FOOTPRINT* aComponent, bool aSkipInternalConnections )
+const std::vector<RN_EDGE> CONNECTIVITY_DATA::GetRatsnestForComponent( FOOTPRINT* aComponent, bool aSkipInternalConnections )
 {
     std::set<int> nets;
     std::set<const PAD*> pads;
-    std::vector<CN_EDGE> edges;
+    std::vector<RN_EDGE> edges;
 
     for( auto pad : aComponent->Pads() )
     {
@@ -875,11 +1112,11 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForComponent( FOOTPRINT
 
             if ( srcFound && dstFound && !aSkipInternalConnections )
             {
-                edges.push_back( edge );
+                edges.push_back( copyEdge( edge ) );
             }
             else if ( srcFound || dstFound )
             {
-                edges.push_back( edge );
+                edges.push_back( copyEdge( edge ) );
             }
         }
     }
@@ -30,6 +30,7 @@
 #include <core/typeinfo.h>
 #include <core/spinlock.h>
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -51,6 +52,7 @@ class ZONE;
 class RN_DATA;
 class RN_NET;
 class PCB_TRACK;
+class PCB_VIA;
 class PAD;
 class FOOTPRINT;
 class PROGRESS_REPORTER;
@@ -82,6 +84,31 @@ struct RN_DYNAMIC_LINE
     VECTOR2I a, b;
 };
 
+/**
+ * A ratsnest edge copied out of the connectivity.  Unlike CN_EDGE, whose anchors belong to
+ * the RN_NET it was computed for, it stays valid when the ratsnest is recomputed.
+ */
+struct RN_EDGE
+{
+    BOARD_CONNECTED_ITEM* source;
+    BOARD_CONNECTED_ITEM* target;
+    VECTOR2I              a, b;      ///< anchor positions on source and target
+};
+
+/**
+ * Routed length figures of a single net, as used by the length-matching DRC and the net
+ * inspector.
+ */
+struct CN_NET_LENGTHS
+{
+    uint64_t              m_Revision = 0;       ///< Connectivity revision these figures match
+    int                   m_PadCount = 0;
+    int                   m_RoutedItemCount = 0; ///< Number of tracks, arcs and vias
+    double                m_TrackLength = 0.0;  ///< Sum of the track and arc lengths
+    long long             m_PadToDieLength = 0;
+    std::vector<PCB_VIA*> m_Vias;
+};
+
 /**
  * Controls how nets are propagated through clusters
  */
@@ -151,6 +178,12 @@ public:
      */
     void Clear();
 
+    /**
+     * Forget the board the connectivity was built from, which is being deleted while the
+     * connectivity may still be shared.
+     */
+    void ClearBoard();
+
     /**
      * Function GetNetCount()
      * Returns the total number of nets in the connectivity database.
@@ -182,6 +215,12 @@ public:
     void FindIsolatedCopperIslands( ZONE* aZone, std::vector<int>& aIslands );
     void FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aZones );
 
+    /**
+     * @return false if tracks or pads of \a aBoard were added, moved or changed layer without
+     *         the connectivity being updated, in which case it must be built again.
+     */
+    bool MatchesBoard( const BOARD* aBoard ) const;
+
     /**
      * Function RecalculateRatsnest()
      * Updates the ratsnest for the board.
@@ -202,6 +241,16 @@ public:
 
     unsigned int GetPadCount( int aNet = -1 ) const;
 
+    /**
+     * Call \a aFunc for each item directly connected to \a aItem whose type is in \a aTypes.
+     *
+     * No container is built, so this is the preferred way of walking the neighbors of an item
+     * in a loop over the board.  An item touching \a aItem on several layers (e.g. a zone
+     * reached through a via) can be visited more than once.
+     */
+    void ForEachNeighbor( const BOARD_CONNECTED_ITEM* aItem, const KICAD_T aTypes[],
+                          const std::function<void( BOARD_CONNECTED_ITEM* )>& aFunc ) const;
+
     const std::vector<PCB_TRACK*> GetConnectedTracks( const BOARD_CONNECTED_ITEM* aItem ) const;
 
     const std::vector<PAD*> GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem ) const;
@@ -271,6 +320,17 @@ public:
     const std::vector<BOARD_CONNECTED_ITEM*> GetNetItems( int aNetCode,
             const KICAD_T aTypes[] ) const;
 
+    /**
+     * Call \a aFunc for each item of net \a aNetCode whose type is in \a aTypes.
+     *
+     * The items of each net are cached and only collected again after the net has changed,
+     * so walking a net does not scan the whole board.  The walk is over an immutable snapshot
+     * of the net, taken without copying it, so \a aFunc may query the connectivity; it must
+     * not modify the board.
+     */
+    void ForEachNetItem( int aNetCode, const KICAD_T aTypes[],
+                         const std::function<void( BOARD_CONNECTED_ITEM* )>& aFunc ) const;
+
     void BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aItems );
 
     std::shared_ptr<CN_CONNECTIVITY_ALGO> GetConnectivityAlgo() const
@@ -292,11 +352,11 @@ public:
     }
 
 #ifndef SWIG
-    const std::vector<CN_EDGE> GetRatsnestForItems( const std::vector<BOARD_ITEM*> aItems );
+    const std::vector<RN_EDGE> GetRatsnestForItems( const std::vector<BOARD_ITEM*> aItems );
 
-    const std::vector<CN_EDGE> GetRatsnestForPad( const PAD* aPad );
+    const std::vector<RN_EDGE> GetRatsnestForPad( const PAD* aPad );
 
-    const std::vector<CN_EDGE> GetRatsnestForComponent( FOOTPRINT* aComponent,
+    const std::vector<RN_EDGE> GetRatsnestForComponent( FOOTPRINT* aComponent,
                                                         bool aSkipInternalConnections = false );
 #endif
 
@@ -305,6 +365,17 @@ public:
         return m_fromToCache;
     }
 
+    /**
+     * Return the routed length figures of a net.
+     *
+     * The figures are cached per net and only recomputed for nets whose connectivity has
+     * changed since they were last requested, so querying every net after an edit costs a
+     * single pass over the items instead of one per net.
+     *
+     * @return a copy of the figures, as the cache may be refreshed by another thread.
+     */
+    CN_NET_LENGTHS GetNetLengths( int aNet );
+
 private:
 
     void    updateRatsnest();
@@ -317,11 +388,36 @@ private:
     void    updateItemPositions( const std::vector<BOARD_ITEM*>& aItems );
     void    addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+    /**
+     * Recomputes the cached item lists and length figures of all the nets that have changed,
+     * visiting only their items when the board's net index is available.
+     * Must be called with m_netCacheMutex held.
+     */
+    void    updateNetCache() const;
+
+    using NET_ITEMS = std::vector<BOARD_CONNECTED_ITEM*>;
+
+    /// Returns the cached items of a net (never null), see ForEachNetItem()
+    std::shared_ptr<const NET_ITEMS> netItems( int aNet ) const;
+
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
     std::shared_ptr<FROM_TO_CACHE> m_fromToCache;
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
     std::vector<RN_NET*> m_nets;
 
+    /// Per-netcode length figures, see GetNetLengths()
+    mutable std::vector<CN_NET_LENGTHS> m_netLengths;
+
+    /// Per-netcode unique item lists, refreshed along with m_netLengths.  A refresh replaces
+    /// the list, so a snapshot handed out by netItems() stays valid.
+    mutable std::vector<std::shared_ptr<const NET_ITEMS>> m_netItems;
+
+    mutable std::mutex m_netCacheMutex;
+
+    /// Board the connectivity was built from, if any; its net index lets updateNetCache()
+    /// visit only the items of the nets which changed
+    BOARD* m_board = nullptr;
+
     PROGRESS_REPORTER* m_progressReporter;
 
     bool m_skipRatsnest = false;
@@ -275,25 +275,44 @@ CN_ITEM* CN_LIST::Add( PCB_ARC* aArc )
      return item;
  }
 
- const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
+ std::vector<CN_ZONE_LAYER*> CN_LIST::BuildZoneItems( ZONE* zone, PCB_LAYER_ID aLayer )
  {
      const auto& polys = zone->GetFilledPolysList( aLayer );
 
-     std::vector<CN_ITEM*> rv;
+     std::vector<CN_ZONE_LAYER*> rv;
 
      for( int j = 0; j < polys.OutlineCount(); j++ )
      {
          CN_ZONE_LAYER* zitem = new CN_ZONE_LAYER( zone, aLayer, false, j );
-         const auto& outline = zone->GetFilledPolysList( aLayer ).COutline( j );
+         const auto& outline = polys.COutline( j );
 
          for( int k = 0; k < outline.PointCount(); k++ )
              zitem->AddAnchor( outline.CPoint( k ) );
 
-         m_items.push_back( zitem );
          zitem->SetLayer( aLayer );
-         addItemtoTree( zitem );
          rv.push_back( zitem );
-         SetDirty();
+     }
+
+     return rv;
+ }
+
+
+ void CN_LIST::Add( CN_ZONE_LAYER* aItem )
+ {
+     m_items.push_back( aItem );
+     addItemtoTree( aItem );
+     SetDirty();
+ }
+
+
+ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
+ {
+     std::vector<CN_ITEM*> rv;
+
+     for( CN_ZONE_LAYER* zitem : BuildZoneItems( zone, aLayer ) )
+     {
+         Add( zitem );
+         rv.push_back( zitem );
      }
 
      return rv;
@@ -328,6 +347,32 @@ void CN_LIST::RemoveInvalidItems( std::vector<CN_ITEM*>& aGarbage )
 }
 
 
+void CN_ITEM::AddAnchor( const VECTOR2I& aPos )
+{
+    int idx = m_anchors.size();
+
+    if( idx >= m_anchorCapacity )
+    {
+        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
+        return;
+    }
+
+    if( !m_anchorBlock )
+    {
+        if( m_anchorCapacity == 1 )
+            m_anchorBlock = std::make_shared<CN_ANCHOR>();
+        else
+            m_anchorBlock.reset( new CN_ANCHOR[m_anchorCapacity], std::default_delete<CN_ANCHOR[]>() );
+    }
+
+    CN_ANCHOR* anchor = m_anchorBlock.get() + idx;
+    *anchor = CN_ANCHOR( aPos, this );
+
+    // Aliasing constructor: shares the block's reference count, no allocation
+    m_anchors.emplace_back( m_anchorBlock, anchor );
+}
+
+
 BOARD_CONNECTED_ITEM* CN_ANCHOR::Parent() const
 {
     assert( m_item->Valid() );
@@ -178,6 +178,7 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
+        m_anchorCapacity = std::max( 1, aAnchorCount );
         m_anchors.reserve( std::max( 6, aAnchorCount ) );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
@@ -185,10 +186,12 @@ public:
 
     virtual ~CN_ITEM() {};
 
-    void AddAnchor( const VECTOR2I& aPos )
-    {
-        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
-    }
+    /**
+     * Add an anchor to the item.  The first \a aAnchorCount anchors (as passed to the
+     * constructor) are stored in a single block shared by all of them, so that large items
+     * (ie: zone outlines) do not cost one allocation and one reference count per anchor.
+     */
+    void AddAnchor( const VECTOR2I& aPos );
 
     CN_ANCHORS& Anchors() { return m_anchors; }
 
@@ -286,6 +289,8 @@ private:
 
     CONNECTED_ITEMS m_connected;     ///< list of items physically connected (touching)
     CN_ANCHORS      m_anchors;
+    CN_ANCHOR_PTR   m_anchorBlock;   ///< storage of the first m_anchorCapacity anchors
+    int             m_anchorCapacity;
 
     bool            m_canChangeNet;  ///< can the net propagator modify the netcode?
 
@@ -301,7 +306,8 @@ class CN_ZONE_LAYER : public CN_ITEM
 {
 public:
     CN_ZONE_LAYER( ZONE* aParent, PCB_LAYER_ID aLayer, bool aCanChangeNet, int aSubpolyIndex ) :
-            CN_ITEM( aParent, aCanChangeNet ),
+            CN_ITEM( aParent, aCanChangeNet,
+                     aParent->GetFilledPolysList( aLayer ).COutline( aSubpolyIndex ).PointCount() ),
             m_subpolyIndex( aSubpolyIndex ),
             m_layer( aLayer )
     {
@@ -318,7 +324,7 @@ public:
         return m_subpolyIndex;
     }
 
-    bool ContainsAnchor( const CN_ANCHOR_PTR anchor ) const
+    bool ContainsAnchor( const CN_ANCHOR_PTR& anchor ) const
     {
         return ContainsPoint( anchor->Pos(), 0 );
     }
@@ -440,6 +446,17 @@ public:
 
     const std::vector<CN_ITEM*> Add( ZONE* zone, PCB_LAYER_ID aLayer );
 
+    /**
+     * Insert a zone item built by BuildZoneItems().
+     */
+    void Add( CN_ZONE_LAYER* aItem );
+
+    /**
+     * Build the items for the filled outlines of a zone layer without inserting them.  This
+     * only reads the zone, so it may be called from several threads at once.
+     */
+    static std::vector<CN_ZONE_LAYER*> BuildZoneItems( ZONE* aZone, PCB_LAYER_ID aLayer );
+
 private:
     bool                  m_dirty;
     bool                  m_hasInvalid;
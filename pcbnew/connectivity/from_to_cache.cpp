@@ -17,8 +17,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <unordered_map>
 #include <reporter.h>
 #include <board.h>
 #include <string_utils.h>
@@ -57,64 +59,89 @@ enum PATH_STATUS {
 };
 
 
-static bool isVertexVisited( CN_ITEM* v, const std::vector<CN_ITEM*>& path )
+/**
+ * Find a path between two connectivity items and tell whether it is the only one.
+ *
+ * A single depth-first search from \a u records the discovery order, the low-link and the
+ * parent of every reachable item.  The tree path from \a u to \a v is the only simple path
+ * between them if and only if each of its edges is a bridge (ie: does not lie on a cycle).
+ * This is linear in the size of the net, where enumerating the candidate paths was not.
+ */
+static PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath )
 {
-    for( auto u : path )
+    struct NODE_INFO
     {
-        if ( u == v )
-            return true;
-    }
+        int      disc;
+        int      low;
+        CN_ITEM* parent;
+    };
 
-    return false;
-}
+    std::unordered_map<CN_ITEM*, NODE_INFO>   info;
+    std::vector<std::pair<CN_ITEM*, size_t>> stack;
+    int                                       order = 0;
 
+    info[ u ] = { order, order, nullptr };
+    order++;
+    stack.emplace_back( u, 0 );
 
-static PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath )
-{
-    using Path = std::vector<CN_ITEM*>;
-    std::deque<Path> Q;
-
-    Path pInit;
-    bool pathFound = false;
-    pInit.push_back( u );
-    Q.push_back( pInit );
-
-    while( Q.size() )
+    while( !stack.empty() )
     {
-        Path path = Q.front();
-        Q.pop_front();
-        CN_ITEM* last = path.back();
+        CN_ITEM*                        node = stack.back().first;
+        const CN_ITEM::CONNECTED_ITEMS& neighbours = node->ConnectedItems();
 
-        if( last == v )
+        if( stack.back().second < neighbours.size() )
         {
-            outPath = path;
-            if( pathFound )
-                return PS_MULTIPLE_PATHS;
-            pathFound = true;
-        }
+            CN_ITEM* ci = neighbours[ stack.back().second++ ];
+            auto     it = info.find( ci );
 
-        for( auto ci : last->ConnectedItems() )
+            if( it == info.end() )
+            {
+                info[ ci ] = { order, order, node };
+                order++;
+                stack.emplace_back( ci, 0 );
+            }
+            else if( ci != info[ node ].parent )
+            {
+                NODE_INFO& nodeInfo = info[ node ];
+                nodeInfo.low = std::min( nodeInfo.low, it->second.disc );
+            }
+        }
+        else
         {
-            bool vertexVisited = isVertexVisited( ci, path );
+            stack.pop_back();
 
-            for( auto& p : Q )
-                if( isVertexVisited( ci, p ) )
-                {
-                    vertexVisited = true;
-                    break;
-                }
+            const NODE_INFO& nodeInfo = info[ node ];
 
-            if( !vertexVisited )
+            if( nodeInfo.parent )
             {
-                Path newpath( path );
-                newpath.push_back( ci );
-                Q.push_back( newpath );
+                NODE_INFO& parentInfo = info[ nodeInfo.parent ];
+                parentInfo.low = std::min( parentInfo.low, nodeInfo.low );
             }
         }
     }
 
-    return pathFound ? PS_OK : PS_NO_PATH;
-};
+    if( info.find( v ) == info.end() )
+        return PS_NO_PATH;
+
+    bool unique = true;
+
+    outPath.clear();
+
+    for( CN_ITEM* node = v; node; node = info[ node ].parent )
+    {
+        CN_ITEM* parent = info[ node ].parent;
+
+        // (parent, node) is a bridge iff nothing below node reaches back above it
+        if( parent && info[ node ].low <= info[ parent ].disc )
+            unique = false;
+
+        outPath.push_back( node );
+    }
+
+    std::reverse( outPath.begin(), outPath.end() );
+
+    return unique ? PS_OK : PS_MULTIPLE_PATHS;
+}
 
 
 int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo )
@@ -159,31 +186,28 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
 
             wxString toName = pad->GetParent()->GetReference() + "-" + pad->GetNumber();
 
-
-            for ( const auto& endpoint : m_ftEndpoints )
+            // Same names as the two endpoints buildEndpointList() creates for each pad
+            for( const wxString& endpointName : { toName, pad->GetParent()->GetReference() } )
             {
-                if( pad == endpoint.parent )
+                if( WildCompareString( aTo, endpointName, false ) )
                 {
-                        if( WildCompareString( aTo, endpoint.name, false ) )
-                        {
-                            count++;
-                            toPad = endpoint.parent;
-
-                            path.to = toPad;
-                            path.fromName = fromName;
-                            path.toName = toName;
-                            path.fromWildcard = aFrom;
-                            path.toWildcard = aTo;
-
-                            if( count >= 2 )
-                            {
-                                // fixme: report this somewhere?
-                                //printf("Multiple targets found, aborting...\n");
-                                path.to = nullptr;
-                            }
-                        }
+                    count++;
+                    toPad = const_cast<PAD*>( pad );
+
+                    path.to = toPad;
+                    path.fromName = fromName;
+                    path.toName = toName;
+                    path.fromWildcard = aFrom;
+                    path.toWildcard = aTo;
+
+                    if( count >= 2 )
+                    {
+                        // fixme: report this somewhere?
+                        //printf("Multiple targets found, aborting...\n");
+                        path.to = nullptr;
                     }
                 }
+            }
         }
     }
 
@@ -194,28 +218,33 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
         if( !path.from || !path.to )
             continue;
 
+        uint64_t  netRevision = cnAlgo->GetNetRevision( path.from->GetNetCode() );
+        PAD_PATH& padPath = m_padPaths[ { path.from, path.to } ];
 
-        CN_ITEM *cnFrom = cnAlgo->ItemEntry( path.from ).GetItems().front();
-        CN_ITEM *cnTo = cnAlgo->ItemEntry( path.to ).GetItems().front();
-        CN_ITEM::CONNECTED_ITEMS upath;
+        if( padPath.netRevision != netRevision || netRevision == 0 )
+        {
+            CN_ITEM *cnFrom = cnAlgo->ItemEntry( path.from ).GetItems().front();
+            CN_ITEM *cnTo = cnAlgo->ItemEntry( path.to ).GetItems().front();
+            CN_ITEM::CONNECTED_ITEMS upath;
 
-        auto result = uniquePathBetweenNodes( cnFrom, cnTo, upath );
+            auto result = uniquePathBetweenNodes( cnFrom, cnTo, upath );
 
-        if( result == PS_OK )
-            path.isUnique = true;
-        else
-            path.isUnique = false;
+            padPath.netRevision = netRevision;
+            padPath.found = result != PS_NO_PATH;
+            padPath.isUnique = result == PS_OK;
+            padPath.pathItems.clear();
 
+            for( const auto item : upath )
+                padPath.pathItems.insert( item->Parent() );
+        }
 
         //printf( "%s\n", (const char *) wxString::Format( _("Check path: %s -> %s (net %s)"), path.fromName, path.toName, cnFrom->Parent()->GetNetname() ) );
 
-        if( result == PS_NO_PATH )
+        if( !padPath.found )
             continue;
 
-        for( const auto item : upath )
-        {
-            path.pathItems.insert( item->Parent() );
-        }
+        path.isUnique = padPath.isUnique;
+        path.pathItems = padPath.pathItems;
 
         m_ftPaths.push_back(path);
         newPaths++;
@@ -264,9 +293,65 @@ bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString
 
 void FROM_TO_CACHE::Rebuild( BOARD* aBoard )
 {
+    // Pad-to-pad results stay valid as long as their net revision does, but not across boards
+    if( aBoard != m_board )
+        m_padPaths.clear();
+
     m_board = aBoard;
     buildEndpointList();
     m_ftPaths.clear();
+
+    // Drop the results of pads which left the board without going through Remove()
+    std::set<const PAD*> pads;
+
+    for( const FT_ENDPOINT& endpoint : m_ftEndpoints )
+        pads.insert( endpoint.parent );
+
+    for( auto it = m_padPaths.begin(); it != m_padPaths.end(); )
+    {
+        if( !pads.count( it->first.first ) || !pads.count( it->first.second ) )
+            it = m_padPaths.erase( it );
+        else
+            ++it;
+    }
+}
+
+
+void FROM_TO_CACHE::Remove( BOARD_ITEM* aItem )
+{
+    std::set<const PAD*> pads;
+
+    if( aItem->Type() == PCB_PAD_T )
+        pads.insert( static_cast<PAD*>( aItem ) );
+    else if( aItem->Type() == PCB_FOOTPRINT_T )
+        pads.insert( static_cast<FOOTPRINT*>( aItem )->Pads().begin(),
+                     static_cast<FOOTPRINT*>( aItem )->Pads().end() );
+
+    if( pads.empty() )
+        return;
+
+    for( auto it = m_padPaths.begin(); it != m_padPaths.end(); )
+    {
+        if( pads.count( it->first.first ) || pads.count( it->first.second ) )
+            it = m_padPaths.erase( it );
+        else
+            ++it;
+    }
+
+    m_ftPaths.erase( std::remove_if( m_ftPaths.begin(), m_ftPaths.end(),
+                                     [&]( const FT_PATH& aPath )
+                                     {
+                                         return pads.count( aPath.from )
+                                                || pads.count( aPath.to );
+                                     } ),
+                     m_ftPaths.end() );
+
+    m_ftEndpoints.erase( std::remove_if( m_ftEndpoints.begin(), m_ftEndpoints.end(),
+                                         [&]( const FT_ENDPOINT& aEndpoint )
+                                         {
+                                             return pads.count( aEndpoint.parent );
+                                         } ),
+                         m_ftEndpoints.end() );
 }
 
 
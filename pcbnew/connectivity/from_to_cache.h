@@ -20,6 +20,7 @@
 #ifndef __FROM_TO_CACHE_H
 #define __FROM_TO_CACHE_H
 
+#include <map>
 #include <set>
 
 class PAD;
@@ -56,11 +57,28 @@ public:
     }
 
     void Rebuild( BOARD* aBoard );
+
+    /**
+     * Forget the paths ending at \a aItem, a pad or the pads of a footprint, which is being
+     * removed from the board.
+     */
+    void Remove( BOARD_ITEM* aItem );
     bool IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo );
 
     FT_PATH* QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems );
 
 private:
+    /**
+     * Result of a path search between two pads, kept across Rebuild() calls for as long as
+     * the connectivity of their net does not change.
+     */
+    struct PAD_PATH
+    {
+        uint64_t                        netRevision;
+        bool                            found;
+        bool                            isUnique;
+        std::set<BOARD_CONNECTED_ITEM*> pathItems;
+    };
 
     int cacheFromToPaths( const wxString& aFrom, const wxString& aTo );
     void buildEndpointList();
@@ -68,6 +86,8 @@ private:
     std::vector<FT_ENDPOINT> m_ftEndpoints;
     std::vector<FT_PATH> m_ftPaths;
 
+    std::map<std::pair<const PAD*, const PAD*>, PAD_PATH> m_padPaths;
+
     BOARD* m_board;
 };
 
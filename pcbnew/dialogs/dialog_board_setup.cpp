@@ -169,9 +169,7 @@ void DIALOG_BOARD_SETUP::OnAuxiliaryAction( wxCommandEvent& event )
         return;
 
     wxFileName boardFn( importDlg.GetFilePath() );
-    wxFileName projectFn( boardFn );
-
-    projectFn.SetExt( ProjectFileExtension );
+    wxFileName projectFn( ChangeFileExtension( boardFn.GetFullPath(), ProjectFileExtension ) );
 
     if( !m_frame->GetSettingsManager()->LoadProject( projectFn.GetFullPath(), false ) )
     {
@@ -46,6 +46,7 @@
 #include <tools/zone_filler_tool.h>
 #include <tools/board_inspection_tool.h>
 #include <kiplatform/ui.h>
+#include <advanced_config.h>
 
 DIALOG_DRC::DIALOG_DRC( PCB_EDIT_FRAME* aEditorFrame, wxWindow* aParent ) :
         DIALOG_DRC_BASE( aParent ),
@@ -61,6 +62,10 @@ DIALOG_DRC::DIALOG_DRC( PCB_EDIT_FRAME* aEditorFrame, wxWindow* aParent ) :
         m_footprintWarningsProvider( nullptr ),
         m_footprintWarningsTreeModel( nullptr ),
         m_centerMarkerOnIdle( nullptr ),
+        m_panelRuleCosts( nullptr ),
+        m_ruleCostList( nullptr ),
+        m_ruleCostSortCol( 3 ),
+        m_ruleCostSortAscending( false ),
         m_severities( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING )
 {
     SetName( DIALOG_DRC_WINDOW_NAME ); // Set a window name to be able to find it
@@ -82,6 +87,27 @@ DIALOG_DRC::DIALOG_DRC( PCB_EDIT_FRAME* aEditorFrame, wxWindow* aParent ) :
     if( Kiface().IsSingle() )
         m_cbTestFootprints->Hide();
 
+    if( ADVANCED_CFG::GetCfg().m_DRCProfileRules )
+    {
+        m_panelRuleCosts = new wxPanel( m_Notebook, wxID_ANY );
+        m_ruleCostList = new wxListView( m_panelRuleCosts, wxID_ANY, wxDefaultPosition,
+                                         wxDefaultSize, wxLC_REPORT | wxLC_SINGLE_SEL );
+
+        m_ruleCostList->AppendColumn( _( "Rule" ) );
+        m_ruleCostList->AppendColumn( _( "Evaluations" ), wxLIST_FORMAT_RIGHT );
+        m_ruleCostList->AppendColumn( _( "Matches" ), wxLIST_FORMAT_RIGHT );
+        m_ruleCostList->AppendColumn( _( "Time (ms)" ), wxLIST_FORMAT_RIGHT );
+        m_ruleCostList->AppendColumn( _( "Condition" ) );
+
+        wxBoxSizer* ruleCostSizer = new wxBoxSizer( wxVERTICAL );
+        ruleCostSizer->Add( m_ruleCostList, 1, wxALL | wxEXPAND, 5 );
+        m_panelRuleCosts->SetSizer( ruleCostSizer );
+
+        m_Notebook->AddPage( m_panelRuleCosts, _( "Rule Cost" ), false );
+
+        m_ruleCostList->Bind( wxEVT_LIST_COL_CLICK, &DIALOG_DRC::onRuleCostColClick, this );
+    }
+
     // We use a sdbSizer here to get the order right, which is platform-dependent
     m_sdbSizerOK->SetLabel( _( "Run DRC" ) );
     m_sdbSizerCancel->SetLabel( _( "Close" ) );
@@ -257,6 +283,8 @@ void DIALOG_DRC::OnRunDRCClick( wxCommandEvent& aEvent )
 
     drcTool->RunTests( this, refillZones, reportAllTrackErrors, testFootprints );
 
+    updateRuleCosts();
+
     if( m_cancelled )
         m_messages->Report( _( "-------- DRC cancelled by user.<br><br>" ) );
     else
@@ -283,6 +311,85 @@ void DIALOG_DRC::OnRunDRCClick( wxCommandEvent& aEvent )
 }
 
 
+void DIALOG_DRC::updateRuleCosts()
+{
+    if( !m_ruleCostList )
+        return;
+
+    DRC_TOOL* drcTool = m_frame->GetToolManager()->GetTool<DRC_TOOL>();
+
+    m_ruleStats = drcTool->GetDRCEngine()->GetRuleStats();
+    sortRuleCosts();
+}
+
+
+void DIALOG_DRC::sortRuleCosts()
+{
+    int  col = m_ruleCostSortCol;
+    bool ascending = m_ruleCostSortAscending;
+
+    auto lessThan =
+            [col]( const DRC_RULE_STATS& a, const DRC_RULE_STATS& b ) -> bool
+            {
+                switch( col )
+                {
+                case 0:  return a.m_Name.CmpNoCase( b.m_Name ) < 0;
+                case 1:  return a.m_EvalCount < b.m_EvalCount;
+                case 2:  return a.m_MatchCount < b.m_MatchCount;
+                case 3:  return a.m_EvalTime < b.m_EvalTime;
+                default: return a.m_Condition.CmpNoCase( b.m_Condition ) < 0;
+                }
+            };
+
+    std::sort( m_ruleStats.begin(), m_ruleStats.end(),
+               [&]( const DRC_RULE_STATS& a, const DRC_RULE_STATS& b )
+               {
+                   return ascending ? lessThan( a, b ) : lessThan( b, a );
+               } );
+
+    wxWindowUpdateLocker updateLock( m_ruleCostList );
+
+    m_ruleCostList->DeleteAllItems();
+
+    for( const DRC_RULE_STATS& stats : m_ruleStats )
+    {
+        long row = m_ruleCostList->InsertItem( m_ruleCostList->GetItemCount(), stats.m_Name );
+
+        m_ruleCostList->SetItem( row, 1, wxString::Format( "%llu",
+                                                           (unsigned long long) stats.m_EvalCount ) );
+        m_ruleCostList->SetItem( row, 2, wxString::Format( "%llu",
+                                                           (unsigned long long) stats.m_MatchCount ) );
+        m_ruleCostList->SetItem( row, 3, wxString::Format( "%.3f", stats.m_EvalTime ) );
+        m_ruleCostList->SetItem( row, 4, stats.m_Condition );
+    }
+
+    for( int ii = 0; ii < m_ruleCostList->GetColumnCount(); ++ii )
+        m_ruleCostList->SetColumnWidth( ii, wxLIST_AUTOSIZE_USEHEADER );
+
+    m_Notebook->SetPageText( m_Notebook->FindPage( m_panelRuleCosts ),
+                             wxString::Format( _( "Rule Cost (%d)" ),
+                                               (int) m_ruleStats.size() ) );
+}
+
+
+void DIALOG_DRC::onRuleCostColClick( wxListEvent& aEvent )
+{
+    if( aEvent.GetColumn() == m_ruleCostSortCol )
+    {
+        m_ruleCostSortAscending = !m_ruleCostSortAscending;
+    }
+    else
+    {
+        m_ruleCostSortCol = aEvent.GetColumn();
+
+        // Names and conditions read best A-Z; counts and times largest first.
+        m_ruleCostSortAscending = m_ruleCostSortCol == 0 || m_ruleCostSortCol == 4;
+    }
+
+    sortRuleCosts();
+}
+
+
 void DIALOG_DRC::SetMarkersProvider( RC_ITEMS_PROVIDER* aProvider )
 {
     m_markersProvider = aProvider;
@@ -867,6 +974,20 @@ bool DIALOG_DRC::writeReport( const wxString& aFullFileName )
     }
 
 
+    if( !m_ruleStats.empty() )
+    {
+        fprintf( fp, "\n** Rule evaluation cost **\n" );
+
+        for( const DRC_RULE_STATS& stats : m_ruleStats )
+        {
+            fprintf( fp, "    %s: %llu evaluations; %llu matches; %.3f ms\n",
+                     TO_UTF8( stats.m_Name ),
+                     (unsigned long long) stats.m_EvalCount,
+                     (unsigned long long) stats.m_MatchCount,
+                     stats.m_EvalTime );
+        }
+    }
+
     fprintf( fp, "\n** End of Report **\n" );
 
     fclose( fp );
@@ -28,10 +28,12 @@
 #define _DIALOG_DRC_H_
 
 #include <wx/htmllbox.h>
+#include <wx/listctrl.h>
 #include <rc_item.h>
 #include <pcb_marker.h>
 #include <board.h>
 #include <dialog_drc_base.h>
+#include <drc/drc_engine.h>
 #include <widgets/progress_reporter_base.h>
 
 
@@ -75,6 +77,14 @@ private:
     void syncCheckboxes();
     void updateDisplayedCounts();
 
+    /**
+     * Fetch the rule evaluation statistics of the last run from the DRC engine and refresh
+     * the "Rule Cost" page (only present when rule profiling is enabled).
+     */
+    void updateRuleCosts();
+    void sortRuleCosts();
+    void onRuleCostColClick( wxListEvent& aEvent );
+
     void OnDRCItemSelected( wxDataViewEvent& aEvent ) override;
     void OnDRCItemDClick( wxDataViewEvent& aEvent ) override;
     void OnDRCItemRClick( wxDataViewEvent& aEvent ) override;
@@ -130,6 +140,12 @@ private:
 
     const PCB_MARKER*  m_centerMarkerOnIdle;
 
+    wxPanel*           m_panelRuleCosts;
+    wxListView*        m_ruleCostList;
+    std::vector<DRC_RULE_STATS> m_ruleStats;
+    int                m_ruleCostSortCol;
+    bool               m_ruleCostSortAscending;
+
     int                m_severities;        // A mask of SEVERITY flags
 };
 
@@ -1017,52 +1017,6 @@ bool DIALOG_NET_INSPECTOR::netFilterMatches( NETINFO_ITEM* aNet ) const
 }
 
 
-struct NETCODE_CMP_LESS
-{
-    bool operator()( const CN_ITEM* a, const CN_ITEM* b ) const
-    {
-        return a->Net() < b->Net();
-    }
-
-    bool operator()( const CN_ITEM* a, int b ) const
-    {
-        return a->Net() < b;
-    }
-
-    bool operator()( int a, const CN_ITEM* b ) const
-    {
-        return a < b->Net();
-    }
-};
-
-
-std::vector<CN_ITEM*> DIALOG_NET_INSPECTOR::relevantConnectivityItems() const
-{
-    // pre-filter the connectivity items and sort them by netcode.
-    // this avoids quadratic runtime when building the whole net list and
-    // calculating the total length for each net.
-
-    const auto type_bits = std::bitset<MAX_STRUCT_TYPE_ID>()
-            .set( PCB_TRACE_T )
-            .set( PCB_ARC_T )
-            .set( PCB_VIA_T )
-            .set( PCB_PAD_T );
-
-    std::vector<CN_ITEM*> cn_items;
-    cn_items.reserve( 1024 );
-
-    for( CN_ITEM* cn_item : m_brd->GetConnectivity()->GetConnectivityAlgo()->ItemList() )
-    {
-        if( cn_item->Valid() && type_bits[cn_item->Parent()->Type()] )
-            cn_items.push_back( cn_item );
-    }
-
-    std::sort( cn_items.begin(), cn_items.end(), NETCODE_CMP_LESS() );
-
-    return cn_items;
-}
-
-
 void DIALOG_NET_INSPECTOR::updateDisplayedRowValues( const OPT<LIST_ITEM_ITER>& aRow )
 {
     if( !aRow )
@@ -1339,8 +1293,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
         return;
     }
 
-    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count,
-                                                             relevantConnectivityItems() );
+    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count );
 
     if( !cur_net_row )
     {
@@ -1400,33 +1353,23 @@ unsigned int DIALOG_NET_INSPECTOR::calculateViaLength( const PCB_TRACK* aTrack )
 
 
 std::unique_ptr<DIALOG_NET_INSPECTOR::LIST_ITEM>
-DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount,
-                                    const std::vector<CN_ITEM*>& aCNItems )
+DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount )
 {
     std::unique_ptr<LIST_ITEM> new_item = std::make_unique<LIST_ITEM>( aNet );
 
     new_item->SetPadCount( aPadCount );
 
-    const auto cn_items = std::equal_range( aCNItems.begin(), aCNItems.end(), aNet->GetNetCode(),
-                                            NETCODE_CMP_LESS() );
-
-    for( auto i = cn_items.first; i != cn_items.second; ++i )
-    {
-        BOARD_CONNECTED_ITEM* item = ( *i )->Parent();
-
-        if( item->Type() == PCB_PAD_T )
-            new_item->AddChipWireLength( static_cast<PAD*>( item )->GetPadToDieLength() );
+    // the connectivity keeps these per net and only recomputes the nets that have changed,
+    // so rebuilding the whole list after an edit does not walk all the board items again.
+    CN_NET_LENGTHS lengths = m_brd->GetConnectivity()->GetNetLengths( aNet->GetNetCode() );
 
-        else if( PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( item ) )
-        {
-            new_item->AddBoardWireLength( track->GetLength() );
+    new_item->AddChipWireLength( lengths.m_PadToDieLength );
+    new_item->AddBoardWireLength( lengths.m_TrackLength );
 
-            if( item->Type() == PCB_VIA_T )
-            {
-                new_item->AddViaCount( 1 );
-                new_item->AddViaLength( calculateViaLength( track ) );
-            }
-        }
+    for( const PCB_VIA* via : lengths.m_Vias )
+    {
+        new_item->AddViaCount( 1 );
+        new_item->AddViaLength( calculateViaLength( via ) );
     }
 
     return new_item;
@@ -1471,9 +1414,6 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
         }
     }
 
-    std::vector<CN_ITEM*> prefiltered_cn_items = relevantConnectivityItems();
-
-
     // collect all nets which pass the filter string and also remember the
     // suffix after the filter match, if any.
     struct NET_INFO
@@ -1529,7 +1469,7 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
     for( NET_INFO& ni : nets )
     {
         if( m_cbShowZeroPad->IsChecked() || ni.pad_count > 0 )
-            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count, prefiltered_cn_items ) );
+            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count ) );
     }
 
 
@@ -41,6 +41,7 @@
 #include <geometry/shape_segment.h>
 #include <geometry/shape_null.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <profile.h>
 
 void drcPrintDebugMessage( int level, const wxString& msg, const char *function, int line )
 {
@@ -67,8 +68,11 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_userUnits( EDA_UNITS::MILLIMETRES ),
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
+    m_violationCount( 0 ),
     m_reporter( nullptr ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_evalRulesCount( 0 ),
+    m_profileRules( false )
 {
     m_errorLimits.resize( DRCE_LAST + 1 );
 
@@ -648,6 +652,8 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
     }
 
     m_constraintMap.clear();
+    m_providerStats.clear();
+    m_evalRulesCount = 0;
 
     m_board->IncrementTimeStamp();  // Clear board-level caches
 
@@ -696,6 +702,9 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     m_board->IncrementTimeStamp();      // Invalidate all caches
 
+    for( DRC_RULE* rule : m_rules )
+        rule->ResetStatistics();
+
     if( !ReportPhase( _( "Tessellating copper zones..." ) ) )
         return;
 
@@ -703,9 +712,9 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
     int                delta = 5;
     std::vector<ZONE*> copperZones;
 
+    // Zone bounding boxes and footprint courtyards are built on demand by the test providers.
     for( ZONE* zone : m_board->Zones() )
     {
-        zone->CacheBoundingBox();
         zone->CacheTriangulation();
 
         if( !zone->GetIsRuleArea() )
@@ -716,14 +725,11 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
     {
         for( ZONE* zone : footprint->Zones() )
         {
-            zone->CacheBoundingBox();
             zone->CacheTriangulation();
 
             if( !zone->GetIsRuleArea() )
                 copperZones.push_back( zone );
         }
-
-        footprint->BuildPolyCourtyards();
     }
 
     int zoneCount = copperZones.size();
@@ -747,6 +753,8 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
         }
     }
 
+    m_providerStats.clear();
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
         if( !provider->IsEnabled() )
@@ -756,7 +764,25 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
         ReportAux( wxString::Format( "Run DRC provider: '%s'", provider->GetName() ) );
 
-        if( !provider->Run() )
+        DRC_PROVIDER_STATS stats;
+        stats.m_Name = provider->GetName();
+
+        size_t evalRulesStart = m_evalRulesCount;
+        int    violationsStart = m_violationCount;
+
+        provider->ResetVisitedItemCount();
+
+        PROF_COUNTER timer;
+        bool         keepGoing = provider->Run();
+
+        stats.m_WallTime = timer.msecs();
+        stats.m_ItemCount = provider->GetVisitedItemCount();
+        stats.m_ViolationCount = m_violationCount - violationsStart;
+        stats.m_EvalRulesCount = m_evalRulesCount - evalRulesStart;
+
+        m_providerStats.push_back( stats );
+
+        if( !keepGoing )
             break;
     }
 }
@@ -774,6 +800,8 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
      * kills performance when running bulk DRC tests (where aReporter is nullptr).
      */
 
+    m_evalRulesCount.fetch_add( 1, std::memory_order_relaxed );
+
     const BOARD_CONNECTED_ITEM* ac = a && a->IsConnected() ?
                                          static_cast<const BOARD_CONNECTED_ITEM*>( a ) : nullptr;
     const BOARD_CONNECTED_ITEM* bc = b && b->IsConnected() ?
@@ -854,6 +882,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
         }
     }
 
+    // Returns true if the constraint was taken into the result, for rule profiling.
     auto processConstraint =
             [&]( const DRC_ENGINE_CONSTRAINT* c ) -> bool
             {
@@ -936,7 +965,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
                     {
                         REPORT( _( "Board and netclass clearances apply only between copper "
                                    "items." ) );
-                        return true;
+                        return false;
                     }
                 }
                 else if( c->constraint.m_Type == DISALLOW_CONSTRAINT )
@@ -1098,7 +1127,30 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
         std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
 
         for( int ii = 0; ii < (int) ruleset->size(); ++ii )
-            processConstraint( ruleset->at( ii ) );
+        {
+            const DRC_ENGINE_CONSTRAINT* c = ruleset->at( ii );
+
+            if( m_profileRules && c->parentRule )
+            {
+                auto start = std::chrono::steady_clock::now();
+                bool applied = processConstraint( c );
+                auto elapsed = std::chrono::steady_clock::now() - start;
+
+                DRC_RULE* rule = c->parentRule;
+
+                rule->m_EvalCount.fetch_add( 1, std::memory_order_relaxed );
+                rule->m_EvalTime.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count(),
+                        std::memory_order_relaxed );
+
+                if( applied )
+                    rule->m_MatchCount.fetch_add( 1, std::memory_order_relaxed );
+            }
+            else
+            {
+                processConstraint( c );
+            }
+        }
     }
 
     if( constraint.GetParentRule() && !constraint.GetParentRule()->m_Implicit )
@@ -1158,6 +1210,39 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
 }
 
 
+std::vector<DRC_RULE_STATS> DRC_ENGINE::GetRuleStats() const
+{
+    std::vector<DRC_RULE_STATS> stats;
+
+    for( DRC_RULE* rule : m_rules )
+    {
+        if( rule->m_EvalCount == 0 )
+            continue;
+
+        DRC_RULE_STATS ruleStats;
+
+        ruleStats.m_Name = rule->m_Name;
+        ruleStats.m_Implicit = rule->m_Implicit;
+        ruleStats.m_EvalCount = rule->m_EvalCount;
+        ruleStats.m_MatchCount = rule->m_MatchCount;
+        ruleStats.m_EvalTime = rule->m_EvalTime / 1e6;
+
+        if( rule->m_Condition )
+            ruleStats.m_Condition = rule->m_Condition->GetExpression();
+
+        stats.push_back( ruleStats );
+    }
+
+    std::sort( stats.begin(), stats.end(),
+               []( const DRC_RULE_STATS& a, const DRC_RULE_STATS& b )
+               {
+                   return a.m_EvalTime > b.m_EvalTime;
+               } );
+
+    return stats;
+}
+
+
 bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 {
     assert( error_code >= 0 && error_code <= DRCE_LAST );
@@ -1168,6 +1253,7 @@ bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const wxPoint& aPos )
 {
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
+    m_violationCount++;
 
     if( m_violationHandler )
         m_violationHandler( aItem, aPos );
@@ -24,6 +24,7 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -68,6 +69,34 @@ std::function<void( const std::shared_ptr<DRC_ITEM>& aItem,
                     const wxPoint& aPos )> DRC_VIOLATION_HANDLER;
 
 
+/**
+ * Run-time statistics of a single test provider, collected by DRC_ENGINE::RunTests().
+ */
+struct DRC_PROVIDER_STATS
+{
+    wxString m_Name;
+    double   m_WallTime = 0.0;       ///< in milliseconds
+    int      m_ItemCount = 0;        ///< number of board items visited by the provider
+    int      m_ViolationCount = 0;
+    size_t   m_EvalRulesCount = 0;   ///< number of calls to EvalRules()
+};
+
+
+/**
+ * Evaluation cost of a single rule, collected by DRC_ENGINE::EvalRules() when rule profiling
+ * is enabled.
+ */
+struct DRC_RULE_STATS
+{
+    wxString m_Name;
+    wxString m_Condition;
+    bool     m_Implicit = false;
+    size_t   m_EvalCount = 0;        ///< number of times the rule was tested
+    size_t   m_MatchCount = 0;       ///< number of times the rule applied
+    double   m_EvalTime = 0.0;       ///< in milliseconds
+};
+
+
 /**
  * Design Rule Checker object that performs all the DRC tests.
  *
@@ -167,6 +196,29 @@ public:
 
     std::vector<DRC_TEST_PROVIDER* > GetTestProviders() const { return m_testProviders; };
 
+    /**
+     * @return the per-provider statistics of the last RunTests() call.
+     */
+    const std::vector<DRC_PROVIDER_STATS>& GetProviderStats() const { return m_providerStats; }
+
+    /**
+     * Enable or disable the collection of per-rule evaluation statistics in EvalRules().
+     * When disabled (the default) the instrumentation costs a single flag test per rule.
+     */
+    void SetRuleProfiling( bool aEnable ) { m_profileRules = aEnable; }
+    bool GetRuleProfiling() const { return m_profileRules; }
+
+    /**
+     * @return the evaluation statistics of all rules tested at least once since the last
+     *         RunTests() call.  Empty unless rule profiling is enabled.
+     */
+    std::vector<DRC_RULE_STATS> GetRuleStats() const;
+
+    /**
+     * @return the number of EvalRules() calls since the engine was initialized.
+     */
+    size_t GetEvalRulesCount() const { return m_evalRulesCount.load(); }
+
     DRC_TEST_PROVIDER* GetTestProvider( const wxString& name ) const;
 
     static bool IsNetADiffPair( BOARD* aBoard, NETINFO_ITEM* aNet, int& aNetP, int& aNetN );
@@ -230,9 +282,16 @@ protected:
     std::unordered_map<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> m_constraintMap;
 
     DRC_VIOLATION_HANDLER            m_violationHandler;
+    std::atomic<int>                 m_violationCount;   ///< reported from provider threads
     REPORTER*                        m_reporter;
     PROGRESS_REPORTER*               m_progressReporter;
 
+    std::vector<DRC_PROVIDER_STATS>  m_providerStats;
+
+    // EvalRules() is also called from the zone filler threads
+    std::atomic<size_t>              m_evalRulesCount;
+    bool                             m_profileRules;
+
     wxString m_msg;  // Allocating strings gets expensive enough to want to avoid it
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
 };
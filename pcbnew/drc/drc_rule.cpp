@@ -32,7 +32,10 @@ DRC_RULE::DRC_RULE() :
         m_Unary( false ),
         m_Implicit( false ),
         m_LayerCondition( LSET::AllLayersMask() ),
-        m_Condition( nullptr )
+        m_Condition( nullptr ),
+        m_EvalCount( 0 ),
+        m_MatchCount( 0 ),
+        m_EvalTime( 0 )
 {
 }
 
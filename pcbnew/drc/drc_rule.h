@@ -24,6 +24,7 @@
 #ifndef DRC_RULE_PROTO_H
 #define DRC_RULE_PROTO_H
 
+#include <atomic>
 #include <core/typeinfo.h>
 #include <core/optional.h>
 #include <core/minoptmax.h>
@@ -90,6 +91,13 @@ public:
     void AddConstraint( DRC_CONSTRAINT& aConstraint );
     OPT<DRC_CONSTRAINT> FindConstraint( DRC_CONSTRAINT_T aType );
 
+    void ResetStatistics()
+    {
+        m_EvalCount = 0;
+        m_MatchCount = 0;
+        m_EvalTime = 0;
+    }
+
 public:
     bool                        m_Unary;
     bool                        m_Implicit;
@@ -98,6 +106,12 @@ public:
     LSET                        m_LayerCondition;
     DRC_RULE_CONDITION*         m_Condition;
     std::vector<DRC_CONSTRAINT> m_Constraints;
+
+    // Evaluation statistics; only collected when rule profiling is enabled in the DRC_ENGINE.
+    // Atomic because EvalRules() is also called from the zone filler threads.
+    std::atomic<size_t>         m_EvalCount;
+    std::atomic<size_t>         m_MatchCount;
+    std::atomic<long long>      m_EvalTime;     // in nanoseconds
 };
 
 
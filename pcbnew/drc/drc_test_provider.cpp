@@ -143,6 +143,13 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
     std::bitset<MAX_STRUCT_TYPE_ID> typeMask;
     int n = 0;
 
+    auto visit =
+            [&]( BOARD_ITEM* aItem ) -> bool
+            {
+                m_visitedItemCount++;
+                return aFunc( aItem );
+            };
+
     if( s_allBasicItems.size() == 0 )
     {
         for( int i = 0; i < MAX_STRUCT_TYPE_ID; i++ )
@@ -174,17 +181,17 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( typeMask[ PCB_TRACE_T ] && item->Type() == PCB_TRACE_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
             else if( typeMask[ PCB_VIA_T ] && item->Type() == PCB_VIA_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
             else if( typeMask[ PCB_ARC_T ] && item->Type() == PCB_ARC_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
         }
@@ -196,28 +203,28 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( typeMask[PCB_DIMENSION_T] && BaseType( item->Type() ) == PCB_DIMENSION_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_SHAPE_T ] && item->Type() == PCB_SHAPE_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_TEXT_T ] && item->Type() == PCB_TEXT_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_TARGET_T ] && item->Type() == PCB_TARGET_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
@@ -231,7 +238,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( ( item->GetLayerSet() & aLayers ).any() )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
@@ -245,7 +252,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( ( footprint->Reference().GetLayerSet() & aLayers ).any() )
             {
-                if( !aFunc( &footprint->Reference() ) )
+                if( !visit( &footprint->Reference() ) )
                     return n;
 
                 n++;
@@ -253,7 +260,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 
             if( ( footprint->Value().GetLayerSet() & aLayers ).any() )
             {
-                if( !aFunc( &footprint->Value() ) )
+                if( !visit( &footprint->Value() ) )
                     return n;
 
                 n++;
@@ -268,7 +275,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
                 if( ( pad->GetDrillSizeX() > 0 && pad->GetDrillSizeY() > 0 )
                         || ( pad->GetLayerSet() & aLayers ).any() )
                 {
-                    if( !aFunc( pad ) )
+                    if( !visit( pad ) )
                         return n;
 
                     n++;
@@ -282,14 +289,14 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             {
                 if( typeMask[ PCB_FP_TEXT_T ] && dwg->Type() == PCB_FP_TEXT_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
                 }
                 else if( typeMask[ PCB_FP_SHAPE_T ] && dwg->Type() == PCB_FP_SHAPE_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
@@ -303,7 +310,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             {
                 if( (zone->GetLayerSet() & aLayers).any() )
                 {
-                    if( !aFunc( zone ) )
+                    if( !visit( zone ) )
                         return n;
 
                     n++;
@@ -313,7 +320,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 
         if( typeMask[ PCB_FOOTPRINT_T ] )
         {
-            if( !aFunc( footprint ) )
+            if( !visit( footprint ) )
                 return n;
 
             n++;
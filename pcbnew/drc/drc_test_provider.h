@@ -108,6 +108,12 @@ public:
         m_enabled = aEnable;
     }
 
+    /**
+     * @return the number of board items visited by forEachGeometryItem() since the last reset.
+     */
+    int GetVisitedItemCount() const { return m_visitedItemCount; }
+    void ResetVisitedItemCount() { m_visitedItemCount = 0; }
+
 protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
@@ -132,6 +138,7 @@ protected:
     std::unordered_map<const DRC_RULE*, int> m_stats;
     bool        m_isRuleDriven = true;
     bool        m_enabled = true;
+    int         m_visitedItemCount = 0;
 
     wxString    m_msg;  // Allocating strings gets expensive enough to want to avoid it
 };
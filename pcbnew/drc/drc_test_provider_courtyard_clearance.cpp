@@ -107,6 +107,9 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
         if( !reportProgress( ii++, m_board->Footprints().size(), delta ) )
             return false;   // DRC cancelled
 
+        // Courtyards are built on demand; make sure the malformed flags are current
+        footprint->GetPolyCourtyard( F_CrtYd );
+
         if( ( footprint->GetFlags() & MALFORMED_COURTYARDS ) != 0 )
         {
             if( m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
@@ -256,7 +256,8 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
                 return true;
             };
 
-    auto ftCache = m_board->GetConnectivity()->GetFromToCache();
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    auto ftCache = connectivity->GetFromToCache();
 
     ftCache->Rebuild( m_board );
 
@@ -287,25 +288,39 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
             ent.fromItem = nullptr;
             ent.toItem = nullptr;
 
-            for( BOARD_CONNECTED_ITEM* citem : nitem.second )
+            CN_NET_LENGTHS netLengths = connectivity->GetNetLengths( ent.netcode );
+
+            if( (int) nitem.second.size() == netLengths.m_RoutedItemCount )
             {
-                if( citem->Type() == PCB_VIA_T )
-                {
-                    ent.viaCount++;
-                    ent.totalVia += computeViaThruLength( static_cast<PCB_VIA*>( citem ),
-                                                          nitem.second );
-                }
-                else if( citem->Type() == PCB_TRACE_T )
-                {
-                    ent.totalRoute += static_cast<PCB_TRACK*>( citem )->GetLength();
-                }
-                else if ( citem->Type() == PCB_ARC_T )
-                {
-                    ent.totalRoute += static_cast<PCB_ARC*>( citem )->GetLength();
-                }
-                else if( citem->Type() == PCB_PAD_T )
+                // The rule covers the whole routed net; use the connectivity's cached figures
+                ent.viaCount = netLengths.m_Vias.size();
+                ent.totalRoute = netLengths.m_TrackLength;
+
+                for( PCB_VIA* via : netLengths.m_Vias )
+                    ent.totalVia += computeViaThruLength( via, nitem.second );
+            }
+            else
+            {
+                for( BOARD_CONNECTED_ITEM* citem : nitem.second )
                 {
-                    ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
+                    if( citem->Type() == PCB_VIA_T )
+                    {
+                        ent.viaCount++;
+                        ent.totalVia += computeViaThruLength( static_cast<PCB_VIA*>( citem ),
+                                                              nitem.second );
+                    }
+                    else if( citem->Type() == PCB_TRACE_T )
+                    {
+                        ent.totalRoute += static_cast<PCB_TRACK*>( citem )->GetLength();
+                    }
+                    else if ( citem->Type() == PCB_ARC_T )
+                    {
+                        ent.totalRoute += static_cast<PCB_ARC*>( citem )->GetLength();
+                    }
+                    else if( citem->Type() == PCB_PAD_T )
+                    {
+                        ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
+                    }
                 }
             }
 
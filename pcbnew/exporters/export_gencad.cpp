@@ -51,6 +51,9 @@
 #include <wx/app.h>
 #include <wx/filedlg.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 static bool CreateHeaderInfoData( FILE* aFile, PCB_EDIT_FRAME* frame );
 static void CreateArtworksSection( FILE* aFile );
 static void CreateTracksInfoData( FILE* aFile, BOARD* aPcb );
@@ -916,6 +919,17 @@ static void CreateSignalsSection( FILE* aFile, BOARD* aPcb )
     NETINFO_ITEM* net;
     int           NbNoConn = 1;
 
+    // The net index keeps pads in the order they were added to the net.  Write them in
+    // footprint and pad order, so the file doesn't change with the editing history.
+    std::unordered_map<const PAD*, size_t> padOrder;
+    std::vector<PAD*>                      pads;
+
+    for( FOOTPRINT* footprint : aPcb->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            padOrder.emplace( pad, padOrder.size() );
+    }
+
     fputs( "$SIGNALS\n", aFile );
 
     for( unsigned ii = 0; ii < aPcb->GetNetCount(); ii++ )
@@ -935,20 +949,24 @@ static void CreateSignalsSection( FILE* aFile, BOARD* aPcb )
         fputs( TO_UTF8( msg ), aFile );
         fputs( "\n", aFile );
 
-        for( FOOTPRINT* footprint : aPcb->Footprints() )
-        {
-            for( PAD* pad : footprint->Pads() )
-            {
-                if( pad->GetNetCode() != net->GetNetCode() )
-                    continue;
+        const std::vector<PAD*>& netPads = aPcb->GetItemsInNet( net->GetNetCode() ).m_Pads;
 
-                msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
-                            escapeString( footprint->GetReference() ),
-                            escapeString( pad->GetNumber() ) );
+        pads.assign( netPads.begin(), netPads.end() );
 
-                fputs( TO_UTF8( msg ), aFile );
-                fputs( "\n", aFile );
-            }
+        std::sort( pads.begin(), pads.end(),
+                   [&]( const PAD* a, const PAD* b )
+                   {
+                       return padOrder[a] < padOrder[b];
+                   } );
+
+        for( PAD* pad : pads )
+        {
+            msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
+                        escapeString( pad->GetParent()->GetReference() ),
+                        escapeString( pad->GetNumber() ) );
+
+            fputs( TO_UTF8( msg ), aFile );
+            fputs( "\n", aFile );
         }
     }
 
@@ -55,6 +55,7 @@
 #include <project/net_settings.h>
 #include <plugins/cadstar/cadstar_pcb_archive_plugin.h>
 #include <plugins/kicad/kicad_plugin.h>
+#include <plugins/kicad/zone_fill_cache.h>
 #include <dialogs/dialog_imported_layers.h>
 #include <tools/pcb_actions.h>
 #include "footprint_info_impl.h"
@@ -69,6 +70,30 @@
 #define     USE_INSTRUMENTATION     0
 
 
+/**
+ * @return true if \a aFileName is a compressed board file, e.g. "board.kicad_pcb.gz".
+ */
+static bool isCompressedBoardFile( const wxFileName& aFileName )
+{
+    return aFileName.GetExt().CmpNoCase( GzipFileExtension ) == 0;
+}
+
+
+/**
+ * Give \a aFileName the board file extension, followed by ".gz" if \a aCompressed.
+ */
+static void setBoardFileExtension( wxFileName& aFileName, bool aCompressed )
+{
+    if( isCompressedBoardFile( aFileName ) )
+        aFileName.SetFullName( aFileName.GetName() );
+
+    aFileName.SetExt( KiCadPcbFileExtension );
+
+    if( aCompressed )
+        aFileName.SetFullName( aFileName.GetFullName() + wxT( "." ) + GzipFileExtension );
+}
+
+
 /**
  * Show a wxFileDialog asking for a #BOARD filename to open.
  *
@@ -141,6 +166,9 @@ bool AskLoadBoardFileName( PCB_EDIT_FRAME* aParent, int* aCtl, wxString* aFileNa
             fileExtensions.push_back( plugin->GetFileExtension().ToStdString() );
         }
 
+        fileFilters += wxChar( '|' ) + CompressedPcbFileWildcard();
+        fileExtensions.push_back( KiCadPcbFileExtension + "." + GzipFileExtension );
+
         fileFilters = _( "All KiCad Board Files" ) + AddFileExtListToFilter( fileExtensions ) + "|"
                       + fileFilters;
     }
@@ -248,14 +276,16 @@ protected:
  */
 bool AskSaveBoardFileName( PCB_EDIT_FRAME* aParent, wxString* aFileName, bool* aCreateProject )
 {
-    wxString    wildcard =  PcbFileWildcard();
+    wxString    wildcard = PcbFileWildcard() + wxT( "|" ) + CompressedPcbFileWildcard();
     wxFileName  fn = *aFileName;
 
-    fn.SetExt( KiCadPcbFileExtension );
+    setBoardFileExtension( fn, isCompressedBoardFile( fn ) );
 
     wxFileDialog dlg( aParent, _( "Save Board File As" ), fn.GetPath(), fn.GetFullName(), wildcard,
                       wxFD_SAVE | wxFD_OVERWRITE_PROMPT );
 
+    dlg.SetFilterIndex( isCompressedBoardFile( fn ) ? 1 : 0 );
+
     // Add a "Create a project" checkbox in standalone mode and one isn't loaded
     if( Kiface().IsSingle() && aParent->Prj().IsNullProject() )
         dlg.SetExtraControlCreator( &CREATE_PROJECT_CHECKBOX::Create );
@@ -266,7 +296,7 @@ bool AskSaveBoardFileName( PCB_EDIT_FRAME* aParent, wxString* aFileName, bool* a
     fn = dlg.GetPath();
 
     // always enforce filename extension, user may not have entered it.
-    fn.SetExt( KiCadPcbFileExtension );
+    setBoardFileExtension( fn, dlg.GetFilterIndex() == 1 || isCompressedBoardFile( fn ) );
 
     *aFileName = fn.GetFullPath();
 
@@ -598,8 +628,7 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
     // Release the lock file, until the new file is actually loaded
     ReleaseFile();
 
-    wxFileName pro = fullFileName;
-    pro.SetExt( ProjectFileExtension );
+    wxFileName pro = ChangeFileExtension( fullFileName, ProjectFileExtension );
 
     bool is_new = !wxFileName::IsFileReadable( fullFileName );
 
@@ -970,13 +999,12 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
     }
 
     // TODO: these will break if we ever go multi-board
-    wxFileName projectFile( pcbFileName );
-    wxFileName rulesFile( pcbFileName );
+    wxFileName projectFile( ChangeFileExtension( pcbFileName.GetFullPath(),
+                                                 ProjectFileExtension ) );
+    wxFileName rulesFile( ChangeFileExtension( pcbFileName.GetFullPath(),
+                                               DesignRulesFileExtension ) );
     wxString   msg;
 
-    projectFile.SetExt( ProjectFileExtension );
-    rulesFile.SetExt( DesignRulesFileExtension );
-
     if( !projectFile.FileExists() && aChangeProject )
     {
         Prj().SetReadOnly( false );
@@ -1051,6 +1079,10 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
         return false;
     }
 
+    // The zone fill cache was written along with the temporary file
+    if( ZONE_FILL_CACHE::IsEnabled() )
+        ZONE_FILL_CACHE::Rename( tempFile.GetFullPath(), pcbFileName.GetFullPath() );
+
     if( !Kiface().IsSingle() )
     {
         WX_STRING_REPORTER backupReporter( &upperTxt );
@@ -1098,7 +1130,7 @@ bool PCB_EDIT_FRAME::SavePcbCopy( const wxString& aFileName, bool aCreateProject
     wxFileName  pcbFileName = aFileName;
 
     // Ensure the file ext is the right ext:
-    pcbFileName.SetExt( KiCadPcbFileExtension );
+    setBoardFileExtension( pcbFileName, isCompressedBoardFile( pcbFileName ) );
 
     if( !IsWritable( pcbFileName ) )
     {
@@ -1130,13 +1162,12 @@ bool PCB_EDIT_FRAME::SavePcbCopy( const wxString& aFileName, bool aCreateProject
         return false;
     }
 
-    wxFileName projectFile( pcbFileName );
-    wxFileName rulesFile( pcbFileName );
+    wxFileName projectFile( ChangeFileExtension( pcbFileName.GetFullPath(),
+                                                 ProjectFileExtension ) );
+    wxFileName rulesFile( ChangeFileExtension( pcbFileName.GetFullPath(),
+                                               DesignRulesFileExtension ) );
     wxString   msg;
 
-    projectFile.SetExt( ProjectFileExtension );
-    rulesFile.SetExt( DesignRulesFileExtension );
-
     if( aCreateProject && !projectFile.FileExists() )
         GetSettingsManager()->SaveProjectCopy( projectFile.GetFullPath() );
 
@@ -54,6 +54,7 @@ FOOTPRINT::FOOTPRINT( BOARD* parent ) :
         m_visibleBBoxCacheTimeStamp( 0 ),
         m_textExcludedBBoxCacheTimeStamp( 0 ),
         m_hullCacheTimeStamp( 0 ),
+        m_courtyardCacheTimeStamp( 0 ),
         m_initial_comments( nullptr )
 {
     m_attributes   = 0;
@@ -95,13 +96,14 @@ FOOTPRINT::FOOTPRINT( const FOOTPRINT& aFootprint ) :
     m_path         = aFootprint.m_path;
 
     m_cachedBoundingBox              = aFootprint.m_cachedBoundingBox;
-    m_boundingBoxCacheTimeStamp      = aFootprint.m_boundingBoxCacheTimeStamp;
+    m_boundingBoxCacheTimeStamp      = aFootprint.m_boundingBoxCacheTimeStamp.load();
     m_cachedVisibleBBox              = aFootprint.m_cachedVisibleBBox;
-    m_visibleBBoxCacheTimeStamp      = aFootprint.m_visibleBBoxCacheTimeStamp;
+    m_visibleBBoxCacheTimeStamp      = aFootprint.m_visibleBBoxCacheTimeStamp.load();
     m_cachedTextExcludedBBox         = aFootprint.m_cachedTextExcludedBBox;
-    m_textExcludedBBoxCacheTimeStamp = aFootprint.m_textExcludedBBoxCacheTimeStamp;
+    m_textExcludedBBoxCacheTimeStamp = aFootprint.m_textExcludedBBoxCacheTimeStamp.load();
     m_cachedHull                     = aFootprint.m_cachedHull;
-    m_hullCacheTimeStamp             = aFootprint.m_hullCacheTimeStamp;
+    m_hullCacheTimeStamp             = aFootprint.m_hullCacheTimeStamp.load();
+    m_courtyardCacheTimeStamp        = 0;
 
     m_localClearance                 = aFootprint.m_localClearance;
     m_localSolderMaskMargin          = aFootprint.m_localSolderMaskMargin;
@@ -278,13 +280,14 @@ FOOTPRINT& FOOTPRINT::operator=( FOOTPRINT&& aOther )
     m_path          = aOther.m_path;
 
     m_cachedBoundingBox              = aOther.m_cachedBoundingBox;
-    m_boundingBoxCacheTimeStamp      = aOther.m_boundingBoxCacheTimeStamp;
+    m_boundingBoxCacheTimeStamp      = aOther.m_boundingBoxCacheTimeStamp.load();
     m_cachedVisibleBBox              = aOther.m_cachedVisibleBBox;
-    m_visibleBBoxCacheTimeStamp      = aOther.m_visibleBBoxCacheTimeStamp;
+    m_visibleBBoxCacheTimeStamp      = aOther.m_visibleBBoxCacheTimeStamp.load();
     m_cachedTextExcludedBBox         = aOther.m_cachedTextExcludedBBox;
-    m_textExcludedBBoxCacheTimeStamp = aOther.m_textExcludedBBoxCacheTimeStamp;
+    m_textExcludedBBoxCacheTimeStamp = aOther.m_textExcludedBBoxCacheTimeStamp.load();
     m_cachedHull                     = aOther.m_cachedHull;
-    m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp;
+    m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp.load();
+    m_courtyardCacheTimeStamp        = 0;
 
     m_localClearance                 = aOther.m_localClearance;
     m_localSolderMaskMargin          = aOther.m_localSolderMaskMargin;
@@ -378,13 +381,14 @@ FOOTPRINT& FOOTPRINT::operator=( const FOOTPRINT& aOther )
     m_path          = aOther.m_path;
 
     m_cachedBoundingBox              = aOther.m_cachedBoundingBox;
-    m_boundingBoxCacheTimeStamp      = aOther.m_boundingBoxCacheTimeStamp;
+    m_boundingBoxCacheTimeStamp      = aOther.m_boundingBoxCacheTimeStamp.load();
     m_cachedVisibleBBox              = aOther.m_cachedVisibleBBox;
-    m_visibleBBoxCacheTimeStamp      = aOther.m_visibleBBoxCacheTimeStamp;
+    m_visibleBBoxCacheTimeStamp      = aOther.m_visibleBBoxCacheTimeStamp.load();
     m_cachedTextExcludedBBox         = aOther.m_cachedTextExcludedBBox;
-    m_textExcludedBBoxCacheTimeStamp = aOther.m_textExcludedBBoxCacheTimeStamp;
+    m_textExcludedBBoxCacheTimeStamp = aOther.m_textExcludedBBoxCacheTimeStamp.load();
     m_cachedHull                     = aOther.m_cachedHull;
-    m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp;
+    m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp.load();
+    m_courtyardCacheTimeStamp        = 0;
 
     m_localClearance                 = aOther.m_localClearance;
     m_localSolderMaskMargin          = aOther.m_localSolderMaskMargin;
@@ -560,6 +564,14 @@ void FOOTPRINT::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode )
 
     aBoardItem->ClearEditFlags();
     aBoardItem->SetParent( this );
+
+    // Only a footprint which is itself on the board indexes its children there.  Clones (undo
+    // copies, the copy constructor) and footprints still being built share the parent board,
+    // and must not leave pointers to their children in its index.
+    BOARD* board = GetBoard();
+
+    if( board && board->IsIndexed( this ) )
+        board->IndexItem( aBoardItem );
 }
 
 
@@ -633,6 +645,11 @@ void FOOTPRINT::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aMode )
 
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    BOARD* board = GetBoard();
+
+    if( board && board->IsIndexed( this ) )
+        board->UnindexItem( aBoardItem );
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
@@ -805,20 +822,32 @@ const EDA_RECT FOOTPRINT::GetBoundingBox( bool aIncludeText, bool aIncludeInvisi
 
     if( board )
     {
+        // The cache must be written before its timestamp: readers don't take the lock.
+        std::lock_guard<std::mutex> lock( m_cachesLock );
+
         if( ( aIncludeText && aIncludeInvisibleText ) || noDrawItems )
         {
-            m_boundingBoxCacheTimeStamp = board->GetTimeStamp();
-            m_cachedBoundingBox = area;
+            if( m_boundingBoxCacheTimeStamp < board->GetTimeStamp() )
+            {
+                m_cachedBoundingBox = area;
+                m_boundingBoxCacheTimeStamp = board->GetTimeStamp();
+            }
         }
         else if( aIncludeText )
         {
-            m_visibleBBoxCacheTimeStamp = board->GetTimeStamp();
-            m_cachedVisibleBBox = area;
+            if( m_visibleBBoxCacheTimeStamp < board->GetTimeStamp() )
+            {
+                m_cachedVisibleBBox = area;
+                m_visibleBBoxCacheTimeStamp = board->GetTimeStamp();
+            }
         }
         else
         {
-            m_textExcludedBBoxCacheTimeStamp = board->GetTimeStamp();
-            m_cachedTextExcludedBBox = area;
+            if( m_textExcludedBBoxCacheTimeStamp < board->GetTimeStamp() )
+            {
+                m_cachedTextExcludedBBox = area;
+                m_textExcludedBBoxCacheTimeStamp = board->GetTimeStamp();
+            }
         }
     }
 
@@ -892,16 +921,24 @@ SHAPE_POLY_SET FOOTPRINT::GetBoundingHull() const
     std::vector<wxPoint> convex_hull;
     BuildConvexHull( convex_hull, rawPolys );
 
-    m_cachedHull.RemoveAllContours();
-    m_cachedHull.NewOutline();
+    hull.NewOutline();
 
     for( const wxPoint& pt : convex_hull )
-        m_cachedHull.Append( pt );
+        hull.Append( pt );
 
     if( board )
-        m_hullCacheTimeStamp = board->GetTimeStamp();
+    {
+        // The cache must be written before its timestamp: readers don't take the lock.
+        std::lock_guard<std::mutex> lock( m_cachesLock );
 
-    return m_cachedHull;
+        if( m_hullCacheTimeStamp < board->GetTimeStamp() )
+        {
+            m_cachedHull = hull;
+            m_hullCacheTimeStamp = board->GetTimeStamp();
+        }
+    }
+
+    return hull;
 }
 
 
@@ -1466,6 +1503,7 @@ void FOOTPRINT::Rotate( const wxPoint& aRotCentre, double aAngle )
     m_visibleBBoxCacheTimeStamp = 0;
     m_textExcludedBBoxCacheTimeStamp = 0;
     m_hullCacheTimeStamp = 0;
+    m_courtyardCacheTimeStamp = 0;
 }
 
 
@@ -1533,6 +1571,7 @@ void FOOTPRINT::Flip( const wxPoint& aCentre, bool aFlipLeftRight )
     m_boundingBoxCacheTimeStamp = 0;
     m_visibleBBoxCacheTimeStamp = 0;
     m_textExcludedBBoxCacheTimeStamp = 0;
+    m_courtyardCacheTimeStamp = 0;
 
     m_cachedHull.Mirror( aFlipLeftRight, !aFlipLeftRight, m_pos );
 
@@ -1583,6 +1622,8 @@ void FOOTPRINT::SetPosition( const wxPoint& aPos )
     m_cachedVisibleBBox.Move( delta );
     m_cachedTextExcludedBBox.Move( delta );
     m_cachedHull.Move( delta );
+
+    m_courtyardCacheTimeStamp = 0;
 }
 
 
@@ -1698,6 +1739,7 @@ void FOOTPRINT::SetOrientation( double aNewAngle )
     m_boundingBoxCacheTimeStamp = 0;
     m_visibleBBoxCacheTimeStamp = 0;
     m_textExcludedBBoxCacheTimeStamp = 0;
+    m_courtyardCacheTimeStamp = 0;
 
     m_cachedHull.Rotate( -DECIDEG2RAD( angleChange ), GetPosition() );
 }
@@ -2019,7 +2061,40 @@ std::shared_ptr<SHAPE> FOOTPRINT::GetEffectiveShape( PCB_LAYER_ID aLayer ) const
 }
 
 
+const SHAPE_POLY_SET& FOOTPRINT::GetPolyCourtyard( PCB_LAYER_ID aLayer ) const
+{
+    const BOARD* board = GetBoard();
+
+    if( board && m_courtyardCacheTimeStamp < board->GetTimeStamp() )
+    {
+        std::lock_guard<std::mutex> lock( m_cachesLock );
+
+        // If we had to wait for the lock then someone else probably just rebuilt the courtyards
+        if( m_courtyardCacheTimeStamp < board->GetTimeStamp() )
+        {
+            const_cast<FOOTPRINT*>( this )->buildPolyCourtyards( nullptr );
+            m_courtyardCacheTimeStamp = board->GetTimeStamp();
+        }
+    }
+
+    if( IsBackLayer( aLayer ) )
+        return m_poly_courtyard_back;
+    else
+        return m_poly_courtyard_front;
+}
+
+
 void FOOTPRINT::BuildPolyCourtyards( OUTLINE_ERROR_HANDLER* aErrorHandler )
+{
+    std::lock_guard<std::mutex> lock( m_cachesLock );
+    const BOARD*                board = GetBoard();
+
+    buildPolyCourtyards( aErrorHandler );
+    m_courtyardCacheTimeStamp = board ? board->GetTimeStamp() : 0;
+}
+
+
+void FOOTPRINT::buildPolyCourtyards( OUTLINE_ERROR_HANDLER* aErrorHandler )
 {
     m_poly_courtyard_front.RemoveAllContours();
     m_poly_courtyard_back.RemoveAllContours();
@@ -2134,7 +2209,17 @@ void FOOTPRINT::SwapData( BOARD_ITEM* aImage )
 {
     wxASSERT( aImage->Type() == PCB_FOOTPRINT_T );
 
+    // The children are exchanged with the image's, so the board's indexes must follow
+    BOARD* board = GetBoard();
+    bool   indexed = board && board->IsIndexed( this );
+
+    if( indexed )
+        board->UnindexItem( this );
+
     std::swap( *((FOOTPRINT*) this), *((FOOTPRINT*) aImage) );
+
+    if( indexed )
+        board->IndexItem( this );
 }
 
 
@@ -25,7 +25,9 @@
 #ifndef FOOTPRINT_H
 #define FOOTPRINT_H
 
+#include <atomic>
 #include <deque>
+#include <mutex>
 
 #include <board_item_container.h>
 #include <board_item.h>
@@ -690,15 +692,14 @@ public:
     /**
      * Used in DRC to test the courtyard area (a complex polygon).
      *
+     * The courtyards of a footprint on a board are rebuilt on demand when the board's timestamp
+     * has changed or the footprint has been moved, rotated or flipped since they were built;
+     * this is safe to call from several threads.  Footprints which are not on a board keep the
+     * courtyards last built by BuildPolyCourtyards().
+     *
      * @return the courtyard polygon.
      */
-    const SHAPE_POLY_SET& GetPolyCourtyard( PCB_LAYER_ID aLayer ) const
-    {
-        if( IsBackLayer( aLayer ) )
-            return m_poly_courtyard_back;
-        else
-            return m_poly_courtyard_front;
-    }
+    const SHAPE_POLY_SET& GetPolyCourtyard( PCB_LAYER_ID aLayer ) const;
 
     /**
      * Build complex polygons of the courtyard areas from graphic items on the courtyard layers.
@@ -728,6 +729,11 @@ public:
 #endif
 
 private:
+    /**
+     * Build the courtyard polygons; callers must hold #m_cachesLock.
+     */
+    void buildPolyCourtyards( OUTLINE_ERROR_HANDLER* aErrorHandler );
+
     DRAWINGS        m_drawings;          // BOARD_ITEMs for drawings on the board, owned by pointer.
     PADS            m_pads;              // PAD items, owned by pointer
     FP_ZONES        m_fp_zones;          // FP_ZONE items, owned by pointer
@@ -751,14 +757,19 @@ private:
     // that any edit that could affect the bounding boxes (including edits to the footprint
     // children) marked the bounding boxes dirty.  It would definitely be faster -- but also more
     // fragile.
-    mutable EDA_RECT       m_cachedBoundingBox;
-    mutable int            m_boundingBoxCacheTimeStamp;
-    mutable EDA_RECT       m_cachedVisibleBBox;
-    mutable int            m_visibleBBoxCacheTimeStamp;
-    mutable EDA_RECT       m_cachedTextExcludedBBox;
-    mutable int            m_textExcludedBBoxCacheTimeStamp;
-    mutable SHAPE_POLY_SET m_cachedHull;
-    mutable int            m_hullCacheTimeStamp;
+    //
+    // The timestamps are atomic and the caches are only written under m_cachesLock, so that they
+    // can be rebuilt on demand from several threads.
+    mutable EDA_RECT         m_cachedBoundingBox;
+    mutable std::atomic<int> m_boundingBoxCacheTimeStamp;
+    mutable EDA_RECT         m_cachedVisibleBBox;
+    mutable std::atomic<int> m_visibleBBoxCacheTimeStamp;
+    mutable EDA_RECT         m_cachedTextExcludedBBox;
+    mutable std::atomic<int> m_textExcludedBBoxCacheTimeStamp;
+    mutable SHAPE_POLY_SET   m_cachedHull;
+    mutable std::atomic<int> m_hullCacheTimeStamp;
+    mutable std::atomic<int> m_courtyardCacheTimeStamp;
+    mutable std::mutex       m_cachesLock;
 
     ZONE_CONNECTION m_zoneConnection;
     int             m_thermalWidth;
@@ -782,8 +793,8 @@ private:
     wxArrayString*                m_initial_comments;  // s-expression comments in the footprint,
                                                        // lazily allocated only if needed for speed
 
-    SHAPE_POLY_SET  m_poly_courtyard_front;  // Note that a footprint can have both front and back
-    SHAPE_POLY_SET  m_poly_courtyard_back;   // courtyards populated.
+    mutable SHAPE_POLY_SET m_poly_courtyard_front; // Note that a footprint can have both front
+    mutable SHAPE_POLY_SET m_poly_courtyard_back;  // and back courtyards populated.
 };
 
 #endif     // FOOTPRINT_H
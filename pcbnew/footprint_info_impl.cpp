@@ -45,7 +45,25 @@ void FOOTPRINT_INFO_IMPL::load()
 
     wxASSERT( fptable );
 
-    const FOOTPRINT* footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+    bool             haveInfo = false;
+    const FOOTPRINT* footprint = nullptr;
+
+    // Footprints may only be read now; report those which cannot be with the library errors.
+    static_cast<FOOTPRINT_LIST_IMPL*>( m_owner )->CatchErrors(
+            [&]()
+            {
+                haveInfo = fptable->GetFootprintInfo( m_nickname, m_fpname, m_pad_count,
+                                                      m_unique_pad_count, m_keywords, m_doc );
+
+                if( !haveInfo )
+                    footprint = fptable->GetEnumeratedFootprint( m_nickname, m_fpname );
+            } );
+
+    if( haveInfo )
+    {
+        m_loaded = true;
+        return;
+    }
 
     if( footprint == nullptr ) // Should happen only with malformed/broken libraries
     {
@@ -243,15 +261,11 @@ bool FOOTPRINT_LIST_IMPL::joinWorkers()
 
     size_t total_count = m_queue_out.size();
 
+    // The KiCad plugin reads numbers independently of the locale, but the legacy and imported
+    // library formats still rely on the C locale.  The locale is global, so it is switched
+    // before the threads enumerating the libraries are created and restored once they finish.
     LOCALE_IO toggle_locale;
 
-    // Parse the footprints in parallel. WARNING! This requires changing the locale, which is
-    // GLOBAL. It is only thread safe to construct the LOCALE_IO before the threads are created,
-    // destroy it after they finish, and block the main (GUI) thread while they work. Any deviation
-    // from this will cause nasal demons.
-    //
-    // TODO: blast LOCALE_IO into the sun
-
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
     std::vector<std::thread>                    threads;
 
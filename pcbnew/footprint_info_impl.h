@@ -106,6 +106,8 @@ protected:
     void loader_job();
 
 private:
+    friend class FOOTPRINT_INFO_IMPL;
+
     /**
      * Call aFunc, pushing any IO_ERRORs and std::exceptions it throws onto m_errors.
      *
@@ -421,6 +421,18 @@ public:
                                                      const wxString& aFootprintName,
                                                      const PROPERTIES* aProperties = nullptr );
 
+    /**
+     * Fetch the footprint properties shown in the footprint chooser, without loading the
+     * footprint when the plugin keeps them indexed.  For use after FootprintEnumerate().
+     *
+     * @return false if the plugin does not provide them; use GetEnumeratedFootprint() instead.
+     * @throw IO_ERROR if the footprint cannot be read.
+     */
+    virtual bool GetFootprintInfo( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                   unsigned& aPadCount, unsigned& aUniquePadCount,
+                                   wxString& aKeywords, wxString& aDoc,
+                                   const PROPERTIES* aProperties = nullptr );
+
     /**
      * Check for the existence of a footprint.
      */
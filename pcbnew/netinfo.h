@@ -107,9 +107,11 @@ public:
         return m_netClass.get();
     }
 
-    wxString GetNetClassName() const
+    const wxString& GetNetClassName() const
     {
-        return m_netClass ? m_netClass->GetName() : NETCLASS::Default;
+        static const wxString defaultName( NETCLASS::Default );
+
+        return m_netClass ? m_netClass->GetName() : defaultName;
     }
 
     int GetNetCode() const { return m_netCode; }
@@ -869,7 +869,7 @@ void PAD::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>&
     if( parentFootprint )
         aList.emplace_back( _( "Footprint" ), parentFootprint->GetReference() );
 
-    aList.emplace_back( _( "Pad" ), m_number );
+    aList.emplace_back( _( "Pad" ), m_number.Get() );
 
     if( !GetPinFunction().IsEmpty() )
         aList.emplace_back( _( "Pin Name" ), GetPinFunction() );
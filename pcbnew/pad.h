@@ -25,9 +25,11 @@
 #ifndef PAD_H
 #define PAD_H
 
+#include <atomic>
 #include <mutex>
 #include <zones.h>
 #include <board_connected_item.h>
+#include <interned_string.h>
 #include <convert_to_biu.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_compound.h>
@@ -674,9 +676,9 @@ private:
                                     ERROR_LOC aErrorLoc ) const;
 
 private:
-    wxString      m_number;             // Pad name (pin number in schematic)
-    wxString      m_pinFunction;        // Pin name in schematic
-    wxString      m_pinType;            // Pin electrical type in schematic
+    INTERNED_STRING m_number;           // Pad name (pin number in schematic)
+    wxString        m_pinFunction;      // Pin name in schematic
+    INTERNED_STRING m_pinType;          // Pin electrical type in schematic
 
     wxPoint       m_pos;                // Pad Position on board
 
@@ -689,14 +691,16 @@ private:
      */
     std::vector<std::shared_ptr<PCB_SHAPE>> m_editPrimitives;
 
-    // Must be set to true to force rebuild shapes to draw (after geometry change for instance)
-    mutable bool                              m_shapesDirty;
+    // Must be set to true to force rebuild shapes to draw (after geometry change for instance).
+    // The dirty flags are atomic so that the effective shapes can be built on demand from
+    // several threads: readers only take the lock when the flag is set.
+    mutable std::atomic<bool>                 m_shapesDirty;
     mutable std::mutex                        m_shapesBuildingLock;
     mutable EDA_RECT                          m_effectiveBoundingBox;
     mutable std::shared_ptr<SHAPE_COMPOUND>   m_effectiveShape;
     mutable std::shared_ptr<SHAPE_SEGMENT>    m_effectiveHoleShape;
 
-    mutable bool                              m_polyDirty;
+    mutable std::atomic<bool>                 m_polyDirty;
     mutable std::mutex                        m_polyBuildingLock;
     mutable std::shared_ptr<SHAPE_POLY_SET>   m_effectivePolygon;
     mutable int                               m_effectiveBoundingRadius;
@@ -234,8 +234,7 @@ wxString PCB_BASE_EDIT_FRAME::GetDesignRulesPath()
     if( !GetBoard() )
         return wxEmptyString;
 
-    wxFileName fn = GetBoard()->GetFileName();
-    fn.SetExt( DesignRulesFileExtension );
+    wxFileName fn = ChangeFileExtension( GetBoard()->GetFileName(), DesignRulesFileExtension );
     return Prj().AbsolutePath( fn.GetFullName() );
 }
 
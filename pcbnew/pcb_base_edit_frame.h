@@ -196,6 +196,12 @@ public:
      */
     void ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCount = -1 ) override;
 
+    /**
+     * Estimate the memory held by an undo/redo command, weighting footprint copies by their
+     * children and zone copies by their outline and fill vertex counts.
+     */
+    size_t EstimateUndoCommandSize( const PICKED_ITEMS_LIST& aCommand ) const override;
+
     /**
      * Return the absolute path to the design rules file for the currently-loaded board.
      *
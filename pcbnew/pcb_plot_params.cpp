@@ -24,6 +24,7 @@
 #include <board_design_settings.h>
 #include <convert_to_biu.h>
 #include <layer_ids.h>
+#include <locale_io.h>
 #include <macros.h>
 #include <math/util.h> // for KiROUND
 #include <pcb_plot_params.h>
@@ -638,7 +639,7 @@ double PCB_PLOT_PARAMS_PARSER::parseDouble()
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    double val = strtod( CurText(), nullptr );
+    double val = StrToDoubleC( CurText() );
 
     return val;
 }
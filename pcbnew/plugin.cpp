@@ -86,6 +86,16 @@ const FOOTPRINT* PLUGIN::GetEnumeratedFootprint( const wxString& aLibraryPath,
 }
 
 
+bool PLUGIN::GetFootprintInfo( const wxString& aLibraryPath, const wxString& aFootprintName,
+                               unsigned& aPadCount, unsigned& aUniquePadCount,
+                               wxString& aKeywords, wxString& aDoc,
+                               const PROPERTIES* aProperties )
+{
+    // default implementation
+    return false;
+}
+
+
 bool PLUGIN::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const PROPERTIES* aProperties )
 {
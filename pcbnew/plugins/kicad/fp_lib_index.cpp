@@ -0,0 +1,362 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <plugins/kicad/fp_lib_index.h>
+
+#include <footprint.h>
+#include <macros.h>
+#include <md5_hash.h>
+#include <paths.h>
+#include <trace_helpers.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+/*
+ * The index is a header followed by one entry per footprint, all in the byte order of the
+ * machine which wrote it:
+ *
+ *   header:  magic, version, byte order mark, library path, entry count
+ *   entry:   footprint name, file path, modification time, size,
+ *            properties flag, pad count, unique pad count, keywords, description
+ *
+ * Strings are UTF-8, preceded by their length.
+ */
+
+static const char     INDEX_MAGIC[8] = { 'K', 'I', 'F', 'P', 'I', 'D', 'X', '\n' };
+static const uint32_t INDEX_VERSION = 1;
+static const uint32_t INDEX_BYTE_ORDER = 0x01020304;
+
+
+template <typename T>
+static void put( std::string& aData, T aValue )
+{
+    aData.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+}
+
+
+static void putString( std::string& aData, const wxString& aString )
+{
+    std::string utf8 = TO_UTF8( aString );
+
+    put<uint32_t>( aData, (uint32_t) utf8.size() );
+    aData.append( utf8 );
+}
+
+
+/**
+ * Read values back from the index, failing instead of reading past its end.
+ */
+struct INDEX_CURSOR
+{
+    const char* pos;
+    const char* end;
+
+    template <typename T>
+    bool Get( T& aValue )
+    {
+        if( end - pos < (ptrdiff_t) sizeof( T ) )
+            return false;
+
+        memcpy( &aValue, pos, sizeof( T ) );
+        pos += sizeof( T );
+        return true;
+    }
+
+    bool GetString( wxString& aString )
+    {
+        uint32_t length;
+
+        if( !Get( length ) || end - pos < (ptrdiff_t) length )
+            return false;
+
+        aString = wxString::FromUTF8( pos, length );
+        pos += length;
+        return true;
+    }
+};
+
+
+static bool statFile( const wxString& aFilePath, long long& aModified, long long& aSize )
+{
+    wxStructStat st;
+
+    if( wxStat( aFilePath, &st ) != 0 )
+        return false;
+
+    aModified = (long long) st.st_mtime;
+    aSize = (long long) st.st_size;
+    return true;
+}
+
+
+static wxString normalizedLibraryPath( const wxString& aLibraryPath )
+{
+    wxFileName fn;
+
+    fn.AssignDir( aLibraryPath );
+    fn.Normalize( wxPATH_NORM_DOTS | wxPATH_NORM_ABSOLUTE | wxPATH_NORM_TILDE );
+
+    return fn.GetPath();
+}
+
+
+FP_LIB_INDEX::FP_LIB_INDEX( const wxString& aLibraryPath ) :
+        m_libraryPath( normalizedLibraryPath( aLibraryPath ) ),
+        m_dirty( false )
+{
+}
+
+
+wxString FP_LIB_INDEX::IndexFileName( const wxString& aLibraryPath )
+{
+    std::string path = TO_UTF8( normalizedLibraryPath( aLibraryPath ) );
+    MD5_HASH    hash;
+
+    hash.Hash( reinterpret_cast<uint8_t*>( &path[0] ), (uint32_t) path.size() );
+    hash.Finalize();
+
+    wxFileName fn;
+
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxT( "footprints" ) );
+    fn.SetName( hash.Format( true ) );
+    fn.SetExt( wxT( "index" ) );
+
+    return fn.GetFullPath();
+}
+
+
+bool FP_LIB_INDEX::Load()
+{
+    m_entries.clear();
+    m_dirty = true;
+
+    wxString indexFileName = IndexFileName( m_libraryPath );
+
+    if( !wxFileName::FileExists( indexFileName ) )
+        return false;
+
+    std::vector<char> data;
+
+    {
+        wxFFile file( indexFileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() )
+            return false;
+
+        data.resize( (size_t) file.Length() );
+
+        if( file.Read( data.data(), data.size() ) != data.size() )
+            return false;
+    }
+
+    INDEX_CURSOR cursor{ data.data(), data.data() + data.size() };
+    uint32_t     version = 0;
+    uint32_t     byteOrder = 0;
+    uint32_t     entryCount = 0;
+    wxString     libraryPath;
+
+    if( data.size() < sizeof( INDEX_MAGIC )
+            || memcmp( data.data(), INDEX_MAGIC, sizeof( INDEX_MAGIC ) ) != 0 )
+    {
+        return false;
+    }
+
+    cursor.pos += sizeof( INDEX_MAGIC );
+
+    if( !cursor.Get( version ) || version != INDEX_VERSION
+            || !cursor.Get( byteOrder ) || byteOrder != INDEX_BYTE_ORDER
+            || !cursor.GetString( libraryPath ) || libraryPath != m_libraryPath
+            || !cursor.Get( entryCount ) )
+    {
+        return false;
+    }
+
+    std::map<wxString, ENTRY> entries;
+
+    for( uint32_t ii = 0; ii < entryCount; ++ii )
+    {
+        wxString name;
+        ENTRY    entry;
+        int64_t  modified, size;
+        uint8_t  hasInfo;
+        int32_t  padCount, uniquePadCount;
+
+        if( !cursor.GetString( name ) || !cursor.GetString( entry.m_filePath )
+                || !cursor.Get( modified ) || !cursor.Get( size ) || !cursor.Get( hasInfo )
+                || !cursor.Get( padCount ) || !cursor.Get( uniquePadCount )
+                || !cursor.GetString( entry.m_keywords ) || !cursor.GetString( entry.m_doc ) )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Footprint library index '%s' is damaged." ),
+                        indexFileName );
+            return false;
+        }
+
+        entry.m_modified = modified;
+        entry.m_size = size;
+        entry.m_hasInfo = hasInfo != 0;
+        entry.m_padCount = padCount;
+        entry.m_uniquePadCount = uniquePadCount;
+
+        entries[name] = entry;
+    }
+
+    m_entries = std::move( entries );
+    m_dirty = false;
+    return true;
+}
+
+
+bool FP_LIB_INDEX::Save()
+{
+    if( !m_dirty )
+        return true;
+
+    std::string data( INDEX_MAGIC, sizeof( INDEX_MAGIC ) );
+
+    put( data, INDEX_VERSION );
+    put( data, INDEX_BYTE_ORDER );
+    putString( data, m_libraryPath );
+    put<uint32_t>( data, (uint32_t) m_entries.size() );
+
+    for( const std::pair<const wxString, ENTRY>& pair : m_entries )
+    {
+        const ENTRY& entry = pair.second;
+
+        putString( data, pair.first );
+        putString( data, entry.m_filePath );
+        put<int64_t>( data, entry.m_modified );
+        put<int64_t>( data, entry.m_size );
+        put<uint8_t>( data, entry.m_hasInfo ? 1 : 0 );
+        put<int32_t>( data, entry.m_padCount );
+        put<int32_t>( data, entry.m_uniquePadCount );
+        putString( data, entry.m_keywords );
+        putString( data, entry.m_doc );
+    }
+
+    wxFileName indexFile( IndexFileName( m_libraryPath ) );
+
+    if( !indexFile.DirExists() && !indexFile.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return false;
+
+    // Other instances may be reading or writing the same index; write a temporary file and
+    // move it in place so they never see a partial one.
+    wxString tempFileName = wxFileName::CreateTempFileName( indexFile.GetPathWithSep() );
+
+    {
+        wxFFile file( tempFileName, wxT( "wb" ) );
+
+        if( !file.IsOpened() || !file.Write( data.data(), data.size() ) || !file.Close() )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Could not write footprint library index '%s'." ),
+                        indexFile.GetFullPath() );
+            wxRemoveFile( tempFileName );
+            return false;
+        }
+    }
+
+    if( !wxRenameFile( tempFileName, indexFile.GetFullPath(), true ) )
+    {
+        wxRemoveFile( tempFileName );
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+
+void FP_LIB_INDEX::Sync( const std::vector<wxString>& aFootprintNames,
+                         const std::vector<wxString>& aFilePaths )
+{
+    wxASSERT( aFootprintNames.size() == aFilePaths.size() );
+
+    std::map<wxString, ENTRY> entries;
+
+    for( size_t ii = 0; ii < aFootprintNames.size(); ++ii )
+    {
+        ENTRY& entry = entries[aFootprintNames[ii]];
+
+        entry.m_filePath = aFilePaths[ii];
+        statFile( aFilePaths[ii], entry.m_modified, entry.m_size );
+
+        auto it = m_entries.find( aFootprintNames[ii] );
+
+        if( it != m_entries.end() && it->second.m_filePath == entry.m_filePath
+                && it->second.m_modified == entry.m_modified
+                && it->second.m_size == entry.m_size )
+        {
+            entry = it->second;
+        }
+        else
+        {
+            m_dirty = true;
+        }
+    }
+
+    if( entries.size() != m_entries.size() )
+        m_dirty = true;
+
+    m_entries = std::move( entries );
+}
+
+
+const FP_LIB_INDEX::ENTRY* FP_LIB_INDEX::Find( const wxString& aFootprintName ) const
+{
+    auto it = m_entries.find( aFootprintName );
+
+    return it != m_entries.end() ? &it->second : nullptr;
+}
+
+
+void FP_LIB_INDEX::SetFootprint( const wxString& aFootprintName, const wxString& aFilePath,
+                                 const FOOTPRINT* aFootprint )
+{
+    ENTRY& entry = m_entries[aFootprintName];
+
+    entry.m_filePath = aFilePath;
+    statFile( aFilePath, entry.m_modified, entry.m_size );
+
+    entry.m_hasInfo = true;
+    entry.m_padCount = aFootprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+    entry.m_uniquePadCount = aFootprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+    entry.m_keywords = aFootprint->GetKeywords();
+    entry.m_doc = aFootprint->GetDescription();
+
+    m_dirty = true;
+}
+
+
+void FP_LIB_INDEX::Remove( const wxString& aFootprintName )
+{
+    if( m_entries.erase( aFootprintName ) )
+        m_dirty = true;
+}
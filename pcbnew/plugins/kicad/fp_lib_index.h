@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef FP_LIB_INDEX_H_
+#define FP_LIB_INDEX_H_
+
+#include <wx/string.h>
+
+#include <map>
+#include <vector>
+
+class FOOTPRINT;
+
+
+/**
+ * An index of the footprint files of a footprint library directory.
+ *
+ * Each footprint name maps to the file it is read from, the modification time and size that
+ * file had when it was indexed, and the properties shown in the footprint chooser.  Those
+ * properties are only trusted while the file keeps the same time and size, so the footprint
+ * chooser can be filled without parsing the footprints that did not change.
+ *
+ * The index is kept in the user cache directory under a name derived from the library path,
+ * so it is shared by every project which uses the library.
+ */
+class FP_LIB_INDEX
+{
+public:
+    struct ENTRY
+    {
+        ENTRY() :
+                m_modified( 0 ),
+                m_size( 0 ),
+                m_hasInfo( false ),
+                m_padCount( 0 ),
+                m_uniquePadCount( 0 )
+        { }
+
+        wxString  m_filePath;
+        long long m_modified;
+        long long m_size;
+
+        bool      m_hasInfo;        ///< The properties below are known for this file.
+        int       m_padCount;
+        int       m_uniquePadCount;
+        wxString  m_keywords;
+        wxString  m_doc;
+    };
+
+    FP_LIB_INDEX( const wxString& aLibraryPath );
+
+    /**
+     * @return the name of the index file of the library at \a aLibraryPath.
+     */
+    static wxString IndexFileName( const wxString& aLibraryPath );
+
+    /**
+     * Read the index of the library.
+     *
+     * @return false if there is no index, or it cannot be read.
+     */
+    bool Load();
+
+    /**
+     * Write the index back if it changed since it was loaded.
+     *
+     * @return false if the index could not be written.
+     */
+    bool Save();
+
+    /**
+     * Replace the indexed footprints by those in \a aFilePaths, which are the files listed in
+     * the library directory, named \a aFootprintNames.  The properties known for a footprint
+     * are kept if its file still has the same modification time and size.
+     */
+    void Sync( const std::vector<wxString>& aFootprintNames,
+               const std::vector<wxString>& aFilePaths );
+
+    /**
+     * @return the entry of \a aFootprintName, or nullptr if it is not indexed.
+     */
+    const ENTRY* Find( const wxString& aFootprintName ) const;
+
+    /**
+     * Index \a aFootprint, which was just read from or written to \a aFilePath.
+     */
+    void SetFootprint( const wxString& aFootprintName, const wxString& aFilePath,
+                       const FOOTPRINT* aFootprint );
+
+    void Remove( const wxString& aFootprintName );
+
+private:
+    wxString                  m_libraryPath;
+    std::map<wxString, ENTRY> m_entries;
+    bool                      m_dirty;
+};
+
+#endif  // FP_LIB_INDEX_H_
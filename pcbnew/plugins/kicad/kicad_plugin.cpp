@@ -35,7 +35,6 @@
 #include <fp_shape.h>
 #include <string_utils.h>
 #include <kiface_base.h>
-#include <locale_io.h>
 #include <macros.h>
 #include <pad.h>
 #include <pcb_group.h>
@@ -43,8 +42,10 @@
 #include <pcb_target.h>
 #include <pcb_text.h>
 #include <pcbnew_settings.h>
+#include <plugins/kicad/fp_lib_index.h>
 #include <plugins/kicad/kicad_plugin.h>
 #include <plugins/kicad/pcb_parser.h>
+#include <plugins/kicad/zone_fill_cache.h>
 #include <trace_helpers.h>
 #include <pcb_track.h>
 #include <progress_reporter.h>
@@ -55,6 +56,10 @@
 #include <zone.h>
 #include <zones.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 using namespace PCB_KEYS_T;
 
 
@@ -68,14 +73,29 @@ using namespace PCB_KEYS_T;
  */
 class FP_CACHE_ITEM
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    WX_FILENAME                        m_filename;
+    mutable std::unique_ptr<FOOTPRINT> m_footprint;
 
 public:
+    /**
+     * @param aFootprint is the footprint read from \a aFileName, or nullptr to read it on
+     *                   first use.
+     */
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
     const WX_FILENAME& GetFileName() const { return m_filename; }
-    const FOOTPRINT* GetFootprint()  const { return m_footprint.get(); }
+
+    /**
+     * Return the footprint, parsing its file first if it has not been read yet.
+     *
+     * @throw IO_ERROR if the file cannot be read or parsed.
+     */
+    const FOOTPRINT* GetFootprint() const;
+
+    /**
+     * Return the footprint if it has been read, without reading it.
+     */
+    const FOOTPRINT* GetLoadedFootprint() const { return m_footprint.get(); }
 };
 
 
@@ -85,6 +105,21 @@ FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileNam
 { }
 
 
+const FOOTPRINT* FP_CACHE_ITEM::GetFootprint() const
+{
+    if( !m_footprint )
+    {
+        MAPPED_FILE_LINE_READER reader( m_filename.GetFullPath() );
+        PCB_PARSER              parser( &reader );
+
+        m_footprint.reset( (FOOTPRINT*) parser.Parse() );
+        m_footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+    }
+
+    return m_footprint.get();
+}
+
+
 typedef boost::ptr_map< wxString, FP_CACHE_ITEM >   FOOTPRINT_MAP;
 
 
@@ -95,6 +130,9 @@ class FP_CACHE
     wxString        m_lib_raw_path;     // For quick comparisons.
     FOOTPRINT_MAP   m_footprints;       // Map of footprint filename to FOOTPRINT*.
 
+    bool            m_indexed;          // Footprints are only read when first used.
+    FP_LIB_INDEX    m_index;            // Chooser properties of the footprints, by name.
+
     bool            m_cache_dirty;      // Stored separately because it's expensive to check
                                         // m_cache_timestamp against all the files.
     long long       m_cache_timestamp;  // A hash of the timestamps for all the footprint
@@ -103,6 +141,8 @@ class FP_CACHE
 public:
     FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath );
 
+    ~FP_CACHE();
+
     wxString GetPath() const { return m_lib_raw_path; }
 
     bool IsWritable() const { return m_lib_path.IsOk() && m_lib_path.IsDirWritable(); }
@@ -126,6 +166,16 @@ public:
 
     void Remove( const wxString& aFootprintName );
 
+    /**
+     * Fetch the footprint chooser properties of \a aFootprintName from the library index,
+     * or from the footprint itself if the index does not know them yet.
+     *
+     * @return false if there is no such footprint.
+     * @throw IO_ERROR if the footprint has to be read and cannot be.
+     */
+    bool GetFootprintInfo( const wxString& aFootprintName, unsigned& aPadCount,
+                           unsigned& aUniquePadCount, wxString& aKeywords, wxString& aDoc );
+
     /**
      * Generate a timestamp representing all source files in the cache (including the
      * parent directory).
@@ -153,7 +203,9 @@ public:
 };
 
 
-FP_CACHE::FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath )
+FP_CACHE::FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath ) :
+        m_indexed( ADVANCED_CFG::GetCfg().m_FootprintLibIndex ),
+        m_index( aLibraryPath )
 {
     m_owner = aOwner;
     m_lib_raw_path = aLibraryPath;
@@ -163,6 +215,14 @@ FP_CACHE::FP_CACHE( PCB_IO* aOwner, const wxString& aLibraryPath )
 }
 
 
+FP_CACHE::~FP_CACHE()
+{
+    // Keep the properties indexed since the library was loaded for the next session.
+    if( m_indexed )
+        m_index.Save();
+}
+
+
 void FP_CACHE::Save( FOOTPRINT* aFootprint )
 {
     m_cache_timestamp = 0;
@@ -181,7 +241,10 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
     for( FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
+        const FOOTPRINT* footprint = it->second->GetLoadedFootprint();
+
+        // Footprints which were never read are unchanged on disk.
+        if( !footprint || ( aFootprint && aFootprint != footprint ) )
             continue;
 
         WX_FILENAME fn = it->second->GetFileName();
@@ -201,7 +264,8 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
             FILE_OUTPUTFORMATTER formatter( tempFileName );
 
             m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetFootprint() );
+            m_owner->Format( (BOARD_ITEM*) footprint );
+            formatter.Finish();
         }
 
 #ifdef USE_TMP_FILE
@@ -220,6 +284,9 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
         }
 #endif
         m_cache_timestamp += fn.GetTimestamp();
+
+        if( m_indexed )
+            m_index.SetFootprint( it->first, fn.GetFullPath(), footprint );
     }
 
     m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
@@ -230,6 +297,93 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 }
 
 
+/**
+ * Parse the footprint files \a aPaths into \a aFootprints, or their errors into \a aErrors.
+ *
+ * The footprint list loads several libraries at once, each on its own thread, so the threads
+ * parsing footprints are counted across all the libraries being read.  The calling thread
+ * counts as one of them and parses too; helper threads are only added while hardware threads
+ * are left.  With \a aParallel false the files are parsed on the calling thread alone.
+ */
+static void parseFootprintFiles( const std::vector<wxString>& aPaths,
+                                 std::vector<std::unique_ptr<FOOTPRINT>>& aFootprints,
+                                 std::vector<wxString>& aErrors, bool aParallel )
+{
+    static std::atomic<int> s_workerCount( 0 );
+
+    std::atomic<size_t> nextFile( 0 );
+
+    auto parse_lambda =
+            [&]() -> size_t
+            {
+                PCB_PARSER parser;
+                size_t     num = 0;
+
+                for( size_t i = nextFile++; i < aPaths.size(); i = nextFile++ )
+                {
+                    // Queue I/O errors so only files that fail to parse don't get loaded.
+                    try
+                    {
+                        MAPPED_FILE_LINE_READER reader( aPaths[i] );
+
+                        parser.SetLineReader( &reader );
+
+                        // Make sure each file starts with a fresh state.
+                        parser.InitParserState();
+                        parser.SetBoard( nullptr );     // calls PCB_PARSER::init()
+
+                        aFootprints[i].reset( (FOOTPRINT*) parser.Parse() );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        aErrors[i] = ioe.What();
+                    }
+
+                    parser.PopReader();
+                    num++;
+                }
+
+                return num;
+            };
+
+    int hardwareThreads = std::max( 1, (int) std::thread::hardware_concurrency() );
+    int helpersWanted = aParallel ? std::min( hardwareThreads, (int) aPaths.size() ) - 1 : 0;
+    int busy = s_workerCount.fetch_add( 1 + helpersWanted );
+    int helperCount = std::max( 0, std::min( helpersWanted, hardwareThreads - busy - 1 ) );
+
+    s_workerCount -= helpersWanted - helperCount;
+
+    std::vector<std::future<size_t>> returns( helperCount );
+
+    for( int ii = 0; ii < helperCount; ++ii )
+        returns[ii] = std::async( std::launch::async, parse_lambda );
+
+    std::exception_ptr callerError;
+
+    try
+    {
+        parse_lambda();
+    }
+    catch( ... )
+    {
+        callerError = std::current_exception();
+        nextFile = aPaths.size();
+    }
+
+    // Wait for every helper before rethrowing, they reference this frame.
+    for( int ii = 0; ii < helperCount; ++ii )
+        returns[ii].wait();
+
+    s_workerCount -= helperCount + 1;
+
+    if( callerError )
+        std::rethrow_exception( callerError );
+
+    for( int ii = 0; ii < helperCount; ++ii )
+        returns[ii].get();
+}
+
+
 void FP_CACHE::Load()
 {
     m_cache_dirty = false;
@@ -251,46 +405,93 @@ void FP_CACHE::Load()
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
+    std::vector<wxString> fullNames;
+    std::vector<wxString> paths;
+
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
+            fullNames.push_back( fullName );
+            paths.push_back( fn.GetFullPath() );
+        } while( dir.GetNext( &fullName ) );
+    }
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER    reader( fn.GetFullPath() );
+    std::vector<wxString> fpNames;
+
+    for( const wxString& name : fullNames )
+    {
+        fn.SetFullName( name );
+        fpNames.push_back( fn.GetName() );
+    }
 
-                m_owner->m_parser->SetLineReader( &reader );
+    if( m_indexed )
+    {
+        m_index.Load();
+        m_index.Sync( fpNames, paths );
+    }
 
-                // For better or worse (mostly worse), the parser is a long-lived object.
-                // Make sure we start with a fresh state.
-                m_owner->m_parser->InitParserState();
-                m_owner->m_parser->SetBoard( nullptr );     // calls PCB_PARSER::init()
+    // Footprints whose properties the index holds are only listed here, and parsed when they
+    // are first used.  The others are parsed now, so that their errors are reported with the
+    // library and the index learns their properties.
+    std::vector<size_t>   toParse;
+    std::vector<wxString> parsePaths;
 
-                FOOTPRINT* footprint = (FOOTPRINT*) m_owner->m_parser->Parse();
-                wxString   fpName = fn.GetName();
+    for( size_t i = 0; i < fullNames.size(); ++i )
+    {
+        const FP_LIB_INDEX::ENTRY* entry = m_indexed ? m_index.Find( fpNames[i] ) : nullptr;
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-            }
-            catch( const IO_ERROR& ioe )
-            {
-                if( !cacheError.IsEmpty() )
-                    cacheError += "\n\n";
+        if( entry && entry->m_hasInfo )
+        {
+            fn.SetFullName( fullNames[i] );
+            m_footprints.insert( fpNames[i], new FP_CACHE_ITEM( nullptr, fn ) );
+        }
+        else
+        {
+            toParse.push_back( i );
+            parsePaths.push_back( paths[i] );
+        }
+    }
 
-                cacheError += ioe.What();
-            }
-        } while( dir.GetNext( &fullName ) );
+    std::vector<std::unique_ptr<FOOTPRINT>> footprints( parsePaths.size() );
+    std::vector<wxString>                   errors( parsePaths.size() );
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+    parseFootprintFiles( parsePaths, footprints, errors, m_owner->m_parallelLoad );
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+    wxString cacheError;
+
+    for( size_t k = 0; k < toParse.size(); ++k )
+    {
+        size_t i = toParse[k];
+
+        if( footprints[k] )
+        {
+            fn.SetFullName( fullNames[i] );
+
+            footprints[k]->SetFPID( LIB_ID( wxEmptyString, fpNames[i] ) );
+
+            if( m_indexed )
+                m_index.SetFootprint( fpNames[i], paths[i], footprints[k].get() );
+
+            m_footprints.insert( fpNames[i], new FP_CACHE_ITEM( footprints[k].release(), fn ) );
+        }
+        else if( !errors[k].IsEmpty() )
+        {
+            if( !cacheError.IsEmpty() )
+                cacheError += "\n\n";
+
+            cacheError += errors[k];
+        }
     }
+
+    if( m_indexed )
+        m_index.Save();
+
+    m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
 }
 
 
@@ -310,6 +511,45 @@ void FP_CACHE::Remove( const wxString& aFootprintName )
     wxString fullPath = it->second->GetFileName().GetFullPath();
     m_footprints.erase( aFootprintName );
     wxRemoveFile( fullPath );
+
+    if( m_indexed )
+        m_index.Remove( aFootprintName );
+}
+
+
+bool FP_CACHE::GetFootprintInfo( const wxString& aFootprintName, unsigned& aPadCount,
+                                 unsigned& aUniquePadCount, wxString& aKeywords, wxString& aDoc )
+{
+    FOOTPRINT_MAP::const_iterator it = m_footprints.find( aFootprintName );
+
+    if( it == m_footprints.end() )
+        return false;
+
+    const FP_LIB_INDEX::ENTRY* entry = m_indexed ? m_index.Find( aFootprintName ) : nullptr;
+
+    if( !entry || !entry->m_hasInfo )
+    {
+        const FOOTPRINT* footprint = it->second->GetFootprint();
+
+        if( !m_indexed )
+        {
+            aPadCount = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+            aUniquePadCount = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+            aKeywords = footprint->GetKeywords();
+            aDoc = footprint->GetDescription();
+            return true;
+        }
+
+        m_index.SetFootprint( aFootprintName, it->second->GetFileName().GetFullPath(),
+                              footprint );
+        entry = m_index.Find( aFootprintName );
+    }
+
+    aPadCount = entry->m_padCount;
+    aUniquePadCount = entry->m_uniquePadCount;
+    aKeywords = entry->m_keywords;
+    aDoc = entry->m_doc;
+    return true;
 }
 
 
@@ -337,8 +577,6 @@ long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
 
 void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     wxString sanityResult = aBoard->GroupsSanityCheck();
 
     if( sanityResult != wxEmptyString )
@@ -361,9 +599,14 @@ void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* a
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( aBoard );
 
-    FILE_OUTPUTFORMATTER    formatter( aFileName );
+    std::unique_ptr<OUTPUTFORMATTER> formatter;
 
-    m_out = &formatter;     // no ownership
+    if( GZIP_FILE_OUTPUTFORMATTER::IsGzipFileName( aFileName ) )
+        formatter = std::make_unique<GZIP_FILE_OUTPUTFORMATTER>( aFileName );
+    else
+        formatter = std::make_unique<FILE_OUTPUTFORMATTER>( aFileName );
+
+    m_out = formatter.get();     // no ownership
 
     m_out->Print( 0, "(kicad_pcb (version %d) (generator pcbnew)\n", SEXPR_BOARD_FILE_VERSION );
 
@@ -372,6 +615,12 @@ void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* a
     m_out->Print( 0, ")\n" );
 
     m_out = nullptr;
+    formatter->Finish();    // the cache is keyed on the complete file
+    formatter.reset();
+
+    // Don't checksum the board file or triangulate zones for a cache which is never read
+    if( ZONE_FILL_CACHE::IsEnabled() )
+        ZONE_FILL_CACHE::Save( aBoard, aFileName );
 }
 
 
@@ -399,8 +648,6 @@ BOARD_ITEM* PCB_IO::Parse( const wxString& aClipboardSourceInput )
 
 void PCB_IO::Format( const BOARD_ITEM* aItem, int aNestLevel ) const
 {
-    LOCALE_IO   toggle;     // public API function, perform anything convenient for caller
-
     switch( aItem->Type() )
     {
     case PCB_T:
@@ -664,11 +911,9 @@ void PCB_IO::format( const BOARD* aBoard, int aNestLevel ) const
     formatHeader( aBoard, aNestLevel );
 
     // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-    {
-        Format( footprint, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+    formatInParallel( std::vector<BOARD_ITEM*>( sorted_footprints.begin(),
+                                                sorted_footprints.end() ),
+                      aNestLevel, "\n" );
 
     // Save the graphical items on the board (not owned by a footprint)
     for( BOARD_ITEM* item : sorted_drawings )
@@ -687,8 +932,8 @@ void PCB_IO::format( const BOARD* aBoard, int aNestLevel ) const
         m_out->Print( 0, "\n" );
 
     // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone, aNestLevel );
+    formatInParallel( std::vector<BOARD_ITEM*>( sorted_zones.begin(), sorted_zones.end() ),
+                      aNestLevel, "" );
 
     // Save the groups
     for( BOARD_ITEM* group : sorted_groups )
@@ -696,6 +941,78 @@ void PCB_IO::format( const BOARD* aBoard, int aNestLevel ) const
 }
 
 
+void PCB_IO::formatInParallel( const std::vector<BOARD_ITEM*>& aItems, int aNestLevel,
+                               const char* aSeparator ) const
+{
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   aItems.size() );
+
+    if( !ADVANCED_CFG::GetCfg().m_ParallelBoardSave || parallelThreadCount <= 1 )
+    {
+        for( BOARD_ITEM* item : aItems )
+        {
+            Format( item, aNestLevel );
+            m_out->Print( 0, "%s", aSeparator );
+        }
+
+        return;
+    }
+
+    // Each item is formatted into its own buffer by a private PCB_IO, then the buffers are
+    // written out in the original order so the file is identical to a serial save.
+    std::vector<std::string> buffers( aItems.size() );
+    std::atomic<size_t>      nextItem( 0 );
+    std::atomic<bool>        cancelled( false );
+
+    auto format_lambda =
+            [&]() -> size_t
+            {
+                PCB_IO io( m_ctl );
+                size_t num = 0;
+
+                io.m_board = m_board;
+                *io.m_mapping = *m_mapping;
+
+                for( size_t i = nextItem++; i < aItems.size() && !cancelled; i = nextItem++ )
+                {
+                    try
+                    {
+                        io.Format( aItems[i], aNestLevel );
+                    }
+                    catch( ... )
+                    {
+                        cancelled = true;
+                        throw;
+                    }
+
+                    buffers[i] = io.GetStringOutput( true );
+                    num++;
+                }
+
+                return num;
+            };
+
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, format_lambda );
+
+    // Wait for every worker before rethrowing, they reference this frame.
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].get();
+
+    for( std::string& buffer : buffers )
+    {
+        m_out->Write( buffer );
+        m_out->Print( 0, "%s", aSeparator );
+        std::string().swap( buffer );
+    }
+}
+
+
 void PCB_IO::format( const PCB_DIMENSION_BASE* aDimension, int aNestLevel ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -2262,6 +2579,7 @@ void PCB_IO::format( const ZONE* aZone, int aNestLevel ) const
 PCB_IO::PCB_IO( int aControlFlags ) :
     m_cache( nullptr ),
     m_ctl( aControlFlags ),
+    m_parallelLoad( ADVANCED_CFG::GetCfg().m_ParallelBoardLoad ),
     m_parser( new PCB_PARSER() ),
     m_mapping( new NETINFO_MAPPING() )
 {
@@ -2278,27 +2596,67 @@ PCB_IO::~PCB_IO()
 }
 
 
+void PCB_IO::SetParallelLoad( bool aParallel )
+{
+    m_parallelLoad = aParallel;
+    m_parser->SetParallelLoad( aParallel );
+}
+
+
 BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties,
                      PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter )
 {
-    FILE_LINE_READER reader( aFileName );
+    auto load =
+            [&]( auto& aReader ) -> BOARD*
+            {
+                unsigned lineCount = 0;
+
+                if( aProgressReporter )
+                {
+                    aProgressReporter->Report( wxString::Format( _( "Loading %s..." ),
+                                                                 aFileName ) );
 
-    unsigned lineCount = 0;
+                    if( !aProgressReporter->KeepRefreshing() )
+                        THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-    if( aProgressReporter )
-    {
-        aProgressReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
+                    while( aReader.ReadLine() )
+                        lineCount++;
+
+                    aReader.Rewind();
+                }
+
+                return DoLoad( aReader, aAppendToMe, aProperties, aProgressReporter, lineCount );
+            };
 
-        if( !aProgressReporter->KeepRefreshing() )
-            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+    BOARD*          board;
+    ZONE_FILL_CACHE zoneFillCache;
 
-        while( reader.ReadLine() )
-            lineCount++;
+    // Zone fills held by an up to date cache are not parsed from the board file
+    if( !aAppendToMe && ZONE_FILL_CACHE::IsEnabled() && zoneFillCache.Load( aFileName ) )
+        m_parser->SetZoneFillCache( &zoneFillCache );
 
-        reader.Rewind();
+    try
+    {
+        // Compressed boards are recognized by their content rather than their name.
+        if( GZIP_FILE_LINE_READER::IsGzipFile( aFileName ) )
+        {
+            GZIP_FILE_LINE_READER reader( aFileName );
+            board = load( reader );
+        }
+        else
+        {
+            MAPPED_FILE_LINE_READER reader( aFileName );
+            board = load( reader );
+        }
+    }
+    catch( ... )
+    {
+        m_parser->SetZoneFillCache( nullptr );
+        throw;
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, aProgressReporter, lineCount );
+    m_parser->SetZoneFillCache( nullptr );
+    zoneFillCache.Apply( m_parser->GetSkippedZoneFills() );
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
@@ -2370,9 +2728,8 @@ void PCB_IO::validateCache( const wxString& aLibraryPath, bool checkModified )
 void PCB_IO::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibPath,
                                  bool aBestEfforts, const PROPERTIES* aProperties )
 {
-    LOCALE_IO toggle;     // toggles on, then off, the C locale.
-    wxDir     dir( aLibPath );
-    wxString  errorMsg;
+    wxDir    dir( aLibPath );
+    wxString errorMsg;
 
     init( aProperties );
 
@@ -2401,8 +2758,6 @@ const FOOTPRINT* PCB_IO::getFootprint( const wxString& aLibraryPath,
                                        const PROPERTIES* aProperties,
                                        bool checkModified )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     try
@@ -2420,6 +2775,7 @@ const FOOTPRINT* PCB_IO::getFootprint( const wxString& aLibraryPath,
     if( it == footprints.end() )
         return nullptr;
 
+    // Reads the footprint if it was only listed, and throws if it cannot be parsed.
     return it->second->GetFootprint();
 }
 
@@ -2428,10 +2784,32 @@ const FOOTPRINT* PCB_IO::GetEnumeratedFootprint( const wxString& aLibraryPath,
                                                  const wxString& aFootprintName,
                                                  const PROPERTIES* aProperties )
 {
+    // Throws if the footprint was only listed and cannot be parsed now.
     return getFootprint( aLibraryPath, aFootprintName, aProperties, false );
 }
 
 
+bool PCB_IO::GetFootprintInfo( const wxString& aLibraryPath, const wxString& aFootprintName,
+                               unsigned& aPadCount, unsigned& aUniquePadCount,
+                               wxString& aKeywords, wxString& aDoc,
+                               const PROPERTIES* aProperties )
+{
+    init( aProperties );
+
+    try
+    {
+        validateCache( aLibraryPath, false );
+    }
+    catch( const IO_ERROR& )
+    {
+        // do nothing with the error
+    }
+
+    return m_cache->GetFootprintInfo( aFootprintName, aPadCount, aUniquePadCount, aKeywords,
+                                      aDoc );
+}
+
+
 bool PCB_IO::FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const PROPERTIES* aProperties )
 {
@@ -2475,8 +2853,6 @@ FOOTPRINT* PCB_IO::FootprintLoad( const wxString& aLibraryPath,
 void PCB_IO::FootprintSave( const wxString& aLibraryPath, const FOOTPRINT* aFootprint,
                             const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     // In this public PLUGIN API function, we can safely assume it was
@@ -2569,8 +2945,6 @@ void PCB_IO::FootprintSave( const wxString& aLibraryPath, const FOOTPRINT* aFoot
 void PCB_IO::FootprintDelete( const wxString& aLibraryPath, const wxString& aFootprintName,
                               const PROPERTIES* aProperties )
 {
-    LOCALE_IO   toggle;     // toggles on, then off, the C locale.
-
     init( aProperties );
 
     validateCache( aLibraryPath );
@@ -2600,8 +2974,6 @@ void PCB_IO::FootprintLibCreate( const wxString& aLibraryPath, const PROPERTIES*
                                           aLibraryPath.GetData() ) );
     }
 
-    LOCALE_IO   toggle;
-
     init( aProperties );
 
     delete m_cache;
@@ -2689,8 +3061,6 @@ bool PCB_IO::FootprintLibDelete( const wxString& aLibraryPath, const PROPERTIES*
 
 bool PCB_IO::IsFootprintLibWritable( const wxString& aLibraryPath )
 {
-    LOCALE_IO   toggle;
-
     init( nullptr );
 
     validateCache( aLibraryPath );
@@ -172,6 +172,10 @@ public:
                                              const wxString& aFootprintName,
                                              const PROPERTIES* aProperties = nullptr ) override;
 
+    bool GetFootprintInfo( const wxString& aLibraryPath, const wxString& aFootprintName,
+                           unsigned& aPadCount, unsigned& aUniquePadCount, wxString& aKeywords,
+                           wxString& aDoc, const PROPERTIES* aProperties = nullptr ) override;
+
     bool FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                           const PROPERTIES* aProperties = nullptr ) override;
 
@@ -220,6 +224,12 @@ public:
 
     void SetOutputFormatter( OUTPUTFORMATTER* aFormatter ) { m_out = aFormatter; }
 
+    /**
+     * Parse board items and the footprint files of a library on worker threads, or not.
+     * Defaults to the ParallelBoardLoad advanced setting.
+     */
+    void SetParallelLoad( bool aParallel );
+
     BOARD_ITEM* Parse( const wxString& aClipboardSourceInput );
 
 protected:
@@ -273,6 +283,13 @@ private:
 
     void format( const ZONE* aZone, int aNestLevel = 0 ) const;
 
+    /**
+     * Format \a aItems in order, each followed by \a aSeparator.  When enabled in the advanced
+     * config, the items are formatted on worker threads and concatenated in order.
+     */
+    void formatInParallel( const std::vector<BOARD_ITEM*>& aItems, int aNestLevel,
+                           const char* aSeparator ) const;
+
     void formatLayer( const BOARD_ITEM* aItem ) const;
 
     void formatLayers( LSET aLayerMask, int aNestLevel = 0 ) const;
@@ -293,6 +310,7 @@ protected:
     STRING_FORMATTER    m_sf;
     OUTPUTFORMATTER*    m_out;      ///< output any Format()s to this, no ownership
     int                 m_ctl;
+    bool                m_parallelLoad; ///< parse on worker threads
     PCB_PARSER*         m_parser;
     NETINFO_MAPPING*    m_mapping;  ///< mapping for net codes, so only not empty net codes
                                     ///< are stored with consecutive integers as net codes
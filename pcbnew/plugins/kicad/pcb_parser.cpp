@@ -27,7 +27,14 @@
  * @brief Pcbnew s-expression file format parser implementation.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <climits>
+#include <future>
+#include <mutex>
+#include <thread>
+
 #include <confirm.h>
 #include <macros.h>
 #include <title_block.h>
@@ -54,6 +61,7 @@
 #include <locale_io.h>
 #include <zones.h>
 #include <plugins/kicad/pcb_parser.h>
+#include <plugins/kicad/zone_fill_cache.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
 #include <math/util.h>                           // KiROUND, Clamp
 #include <string_utils.h>
@@ -72,6 +80,9 @@ void PCB_PARSER::init()
     m_layerIndices.clear();
     m_layerMasks.clear();
     m_resetKIIDMap.clear();
+    m_legacyZoneFillFound = false;
+    m_zoneNetNames.clear();
+    m_skippedZoneFills.clear();
 
     // Add untranslated default (i.e. English) layernames.
     // Some may be overridden later if parsing a board rather than a footprint.
@@ -170,7 +181,7 @@ double PCB_PARSER::parseDouble()
 
     errno = 0;
 
-    double fval = strtod( CurText(), &tmp );
+    double fval = StrToDoubleC( CurText(), &tmp );
 
     if( errno )
     {
@@ -627,7 +638,6 @@ BOARD_ITEM* PCB_PARSER::Parse()
 {
     T               token;
     BOARD_ITEM*     item;
-    LOCALE_IO       toggle;
 
     m_groupInfos.clear();
 
@@ -696,8 +706,10 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
 
     parseHeader();
 
-    std::vector<BOARD_ITEM*> bulkAddedItems;
-    BOARD_ITEM* item = nullptr;
+    std::vector<BOARD_ITEM*>    bulkAddedItems;
+    std::vector<DEFERRED_ITEMS> deferredItems;
+    BOARD_ITEM*                 item = nullptr;
+    bool                        deferItems = m_parallelLoad;
 
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
@@ -711,6 +723,15 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
         if( token == T_page && m_requiredVersion <= 20200119 )
             token = T_paper;
 
+        // Footprints, zones and tracks make up most of a board file.  They are only located
+        // here, and parsed on worker threads once the layers and nets are known.
+        if( deferItems && ( token == T_footprint || token == T_module || token == T_zone
+                            || token == T_segment || token == T_arc || token == T_via ) )
+        {
+            deferItem( deferredItems );
+            continue;
+        }
+
         switch( token )
         {
         case T_host:            // legacy token
@@ -834,6 +855,8 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
         }
     }
 
+    addDeferredItems( deferredItems, bulkAddedItems );
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -933,6 +956,300 @@ BOARD* PCB_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_PARSER::deferItem( std::vector<DEFERRED_ITEMS>& aDeferred )
+{
+    // Large enough to amortize a worker's setup, small enough to spread a board over all cores
+    const size_t BATCH_SIZE = 256 * 1024;
+
+    if( aDeferred.empty() || aDeferred.back().text.size() >= BATCH_SIZE )
+        aDeferred.emplace_back();
+
+    DEFERRED_ITEMS& deferred = aDeferred.back();
+    std::string&    text = deferred.text;
+
+    deferred.blockLines.emplace_back( deferred.lineCount + 1, CurLineNumber() );
+
+    // Copy from the keyword to the matching right paren, following the lexer's rules for
+    // quoted strings and comment lines.  Every line copied ends with a newline, so line
+    // numbers in the text can be mapped back to the file.
+    const char* head = start + curOffset;
+    const char* cur = head;
+    int         depth = 1;
+
+    text += '(';
+
+    while( true )
+    {
+        bool inString = false;
+
+        while( cur < limit && depth > 0 )
+        {
+            char c = *cur++;
+
+            if( inString )
+            {
+                if( c == '\\' && cur < limit )
+                    ++cur;
+                else if( c == '"' )
+                    inString = false;
+            }
+            else if( c == '"' )
+            {
+                inString = true;
+            }
+            else if( c == '(' )
+            {
+                ++depth;
+            }
+            else if( c == ')' )
+            {
+                --depth;
+            }
+        }
+
+        text.append( head, cur );
+        deferred.lineCount++;
+
+        if( depth == 0 )
+            break;
+
+        if( readLine() == 0 )
+            Expecting( T_RIGHT );
+
+        head = start;
+        cur = start;
+
+        while( cur < limit && isspace( (unsigned char) *cur ) )
+            ++cur;
+
+        if( cur < limit && *cur == '#' )    // the lexer skips comment lines
+            cur = limit;
+    }
+
+    if( text.back() != '\n' )
+        text += '\n';
+
+    // Resume tokenizing after the block
+    next = cur;
+}
+
+
+void PCB_PARSER::parseDeferredItems( DEFERRED_ITEMS& aDeferred )
+{
+    for( T token = NextTok();  token != T_EOF;  token = NextTok() )
+    {
+        if( token != T_LEFT )
+            Expecting( T_LEFT );
+
+        switch( NextTok() )
+        {
+        case T_module:      // legacy token
+        case T_footprint:
+            aDeferred.items.push_back( parseFOOTPRINT() );
+            break;
+
+        case T_segment:
+            aDeferred.items.push_back( parsePCB_TRACK() );
+            break;
+
+        case T_arc:
+            aDeferred.items.push_back( parseARC() );
+            break;
+
+        case T_via:
+            aDeferred.items.push_back( parsePCB_VIA() );
+            break;
+
+        case T_zone:
+            aDeferred.items.push_back( parseZONE( m_board ) );
+            break;
+
+        default:
+            Expecting( "footprint, segment, arc, via or zone" );
+        }
+    }
+
+    aDeferred.groupInfos = std::move( m_groupInfos );
+    aDeferred.zoneNetNames = std::move( m_zoneNetNames );
+    aDeferred.legacyZoneFillFound = m_legacyZoneFillFound;
+
+    m_groupInfos.clear();
+    m_zoneNetNames.clear();
+    m_legacyZoneFillFound = false;
+}
+
+
+void PCB_PARSER::addDeferredItems( std::vector<DEFERRED_ITEMS>& aDeferred,
+                                   std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    if( aDeferred.empty() )
+        return;
+
+    const wxString      source = CurSource();
+    std::atomic<size_t> nextBatch( 0 );
+    std::atomic<bool>   cancelled( false );
+    std::mutex          stateLock;
+
+    auto parse_lambda =
+            [&]() -> size_t
+            {
+                PCB_PARSER parser;
+                size_t     num = 0;
+
+                parser.m_board = m_board;
+                parser.m_layerIndices = m_layerIndices;
+                parser.m_layerMasks = m_layerMasks;
+                parser.m_netCodes = m_netCodes;
+                parser.m_tooRecent = m_tooRecent;
+                parser.m_requiredVersion = m_requiredVersion;
+                parser.m_resetKIIDs = m_resetKIIDs;
+                parser.m_deferBoardChanges = true;
+                parser.m_zoneFillCache = m_zoneFillCache;
+
+                for( size_t i = nextBatch++; i < aDeferred.size() && !cancelled; i = nextBatch++ )
+                {
+                    DEFERRED_ITEMS&    deferred = aDeferred[i];
+                    STRING_LINE_READER reader( deferred.text, source );
+
+                    parser.SetLineReader( &reader );
+                    parser.InitParserState();
+
+                    try
+                    {
+                        parser.parseDeferredItems( deferred );
+                    }
+                    catch( ... )
+                    {
+                        deferred.error = std::current_exception();
+                        cancelled = true;
+                    }
+
+                    parser.PopReader();
+                    std::string().swap( deferred.text );
+                    num++;
+                }
+
+                std::lock_guard<std::mutex> lock( stateLock );
+
+                m_undefinedLayers.insert( parser.m_undefinedLayers.begin(),
+                                          parser.m_undefinedLayers.end() );
+                m_resetKIIDMap.insert( parser.m_resetKIIDMap.begin(),
+                                       parser.m_resetKIIDMap.end() );
+                m_skippedZoneFills.insert( m_skippedZoneFills.end(),
+                                           parser.m_skippedZoneFills.begin(),
+                                           parser.m_skippedZoneFills.end() );
+
+                return num;
+            };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   aDeferred.size() );
+
+    if( parallelThreadCount <= 1 )
+    {
+        parse_lambda();
+    }
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, parse_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            // Here we balance returns with a 100ms timeout to allow UI updating
+            std::future_status status;
+
+            do
+            {
+                if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+                    cancelled = true;
+
+                status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+            } while( status != std::future_status::ready );
+        }
+    }
+
+    // Everything below runs on this thread, in file order
+    auto deleteItems =
+            [&]()
+            {
+                for( DEFERRED_ITEMS& deferred : aDeferred )
+                {
+                    for( BOARD_ITEM* item : deferred.items )
+                        delete item;
+
+                    deferred.items.clear();
+                }
+            };
+
+    try
+    {
+        bool legacyZoneFillFound = false;
+
+        for( DEFERRED_ITEMS& deferred : aDeferred )
+        {
+            if( deferred.error )
+            {
+                try
+                {
+                    std::rethrow_exception( deferred.error );
+                }
+                catch( PARSE_ERROR& parse_error )
+                {
+                    // Map the line back from the batch to the file
+                    int line = parse_error.lineNumber;
+                    auto it = std::upper_bound( deferred.blockLines.begin(),
+                                                deferred.blockLines.end(),
+                                                std::make_pair( line, INT_MAX ) );
+
+                    if( it != deferred.blockLines.begin() )
+                        line = std::prev( it )->second + line - std::prev( it )->first;
+
+                    THROW_PARSE_ERROR( parse_error.ParseProblem(), source,
+                                       parse_error.inputLine.c_str(), line,
+                                       parse_error.byteIndex );
+                }
+            }
+
+            legacyZoneFillFound |= deferred.legacyZoneFillFound;
+        }
+
+        if( cancelled )
+            THROW_IO_ERROR( ( "Open cancelled by user." ) );
+
+        if( legacyZoneFillFound )
+            confirmLegacyZoneFill();
+    }
+    catch( ... )
+    {
+        deleteItems();
+        throw;
+    }
+
+    for( DEFERRED_ITEMS& deferred : aDeferred )
+    {
+        // Net names are fixed up before the zones reach the board's net index
+        for( const std::pair<ZONE*, wxString>& zoneNetName : deferred.zoneNetNames )
+            resolveZoneNetName( zoneNetName.first, zoneNetName.second );
+
+        for( BOARD_ITEM* item : deferred.items )
+        {
+            m_board->Add( item, ADD_MODE::BULK_APPEND );
+            aBulkAddedItems.push_back( item );
+        }
+
+        m_groupInfos.insert( m_groupInfos.end(), deferred.groupInfos.begin(),
+                             deferred.groupInfos.end() );
+
+        deferred.items.clear();
+    }
+
+    aDeferred.clear();
+}
+
+
 void PCB_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem = [&]( const KIID& aId )
@@ -4917,6 +5234,7 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     bool         inFootprint = false;
     PCB_LAYER_ID filledLayer;
     bool         addedFilledPolygons = false;
+    std::set<PCB_LAYER_ID> skippedFillLayers;   // taken from m_zoneFillCache instead
 
     if( dynamic_cast<FOOTPRINT*>( aParent ) )      // The zone belongs a footprint
         inFootprint = true;
@@ -5070,24 +5388,12 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
                     {
                         // SEGMENT fill mode no longer supported.  Make sure user is OK with
                         // converting them.
-                        if( m_showLegacyZoneWarning )
-                        {
-                            KIDIALOG dlg( nullptr,
-                                          _( "The legacy segment fill mode is no longer supported."
-                                             "\nConvert zones to polygon fills?"),
-                                          _( "Legacy Zone Warning" ),
-                                          wxYES_NO | wxICON_WARNING );
-
-                            dlg.DoNotShowCheckbox( __FILE__, __LINE__ );
-
-                            if( dlg.ShowModal() == wxID_NO )
-                                THROW_IO_ERROR( wxT( "CANCEL" ) );
-
-                            m_showLegacyZoneWarning = false;
-                        }
+                        if( m_deferBoardChanges )
+                            m_legacyZoneFillFound = true;
+                        else
+                            confirmLegacyZoneFill();
 
                         zone->SetFillMode( ZONE_FILL_MODE::POLYGONS );
-                        m_board->SetModified();
                     }
                     else if( token == T_hatch )
                     {
@@ -5314,6 +5620,15 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
                 {
                     filledLayer = parseBoardItemLayer();
                     NeedRIGHT();
+
+                    if( m_zoneFillCache && !inFootprint
+                            && m_zoneFillCache->Contains( zone->m_Uuid, filledLayer ) )
+                    {
+                        skipCurrent();
+                        skippedFillLayers.insert( filledLayer );
+                        break;
+                    }
+
                     token = NextTok();
 
                     if( token != T_LEFT )
@@ -5442,29 +5757,15 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     // Ensure the zone net name is valid, and matches the net code, for copper zones
     if( zone_has_net && ( zone->GetNet()->GetNetname() != netnameFromfile ) )
     {
-        // Can happens which old boards, with nonexistent nets ...
-        // or after being edited by hand
-        // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        if( m_deferBoardChanges )
+            m_zoneNetNames.emplace_back( zone.get(), netnameFromfile );
+        else
+            resolveZoneNetName( zone.get(), netnameFromfile );
     }
 
+    for( PCB_LAYER_ID layer : skippedFillLayers )
+        m_skippedZoneFills.emplace_back( zone.get(), layer );
+
     // Clear flags used in zone edition:
     zone->SetNeedRefill( false );
 
@@ -5472,6 +5773,54 @@ ZONE* PCB_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 }
 
 
+void PCB_PARSER::resolveZoneNetName( ZONE* aZone, const wxString& aNetName )
+{
+    // Can happens which old boards, with nonexistent nets ...
+    // or after being edited by hand
+    // We try to fix the mismatch.
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
+void PCB_PARSER::confirmLegacyZoneFill()
+{
+    if( m_showLegacyZoneWarning )
+    {
+        KIDIALOG dlg( nullptr,
+                      _( "The legacy segment fill mode is no longer supported."
+                         "\nConvert zones to polygon fills?"),
+                      _( "Legacy Zone Warning" ),
+                      wxYES_NO | wxICON_WARNING );
+
+        dlg.DoNotShowCheckbox( __FILE__, __LINE__ );
+
+        if( dlg.ShowModal() == wxID_NO )
+            THROW_IO_ERROR( wxT( "CANCEL" ) );
+
+        m_showLegacyZoneWarning = false;
+    }
+
+    m_board->SetModified();
+}
+
+
 PCB_TARGET* PCB_PARSER::parsePCB_TARGET()
 {
     wxCHECK_MSG( CurTok() == T_target, nullptr,
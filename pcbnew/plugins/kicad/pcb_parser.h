@@ -30,6 +30,7 @@
 #ifndef _PCBNEW_PARSER_H_
 #define _PCBNEW_PARSER_H_
 
+#include <advanced_config.h>
 #include <convert_to_biu.h>                      // IU_PER_MM
 #include <core/wx_stl_compat.h>
 #include <hashtables.h>
@@ -37,6 +38,7 @@
 #include <pcb_lexer.h>
 #include <kiid.h>
 
+#include <exception>
 #include <unordered_map>
 
 
@@ -62,6 +64,7 @@ class FP_3DMODEL;
 class SHAPE_LINE_CHAIN;
 struct LAYER;
 class PROGRESS_REPORTER;
+class ZONE_FILL_CACHE;
 
 
 /**
@@ -75,6 +78,9 @@ public:
         PCB_LEXER( aReader ),
         m_board( nullptr ),
         m_resetKIIDs( false ),
+        m_deferBoardChanges( false ),
+        m_parallelLoad( ADVANCED_CFG::GetCfg().m_ParallelBoardLoad ),
+        m_zoneFillCache( nullptr ),
         m_progressReporter( nullptr ),
         m_lineReader( nullptr ),
         m_lastProgressLine( 0 ),
@@ -116,6 +122,31 @@ public:
         m_lineCount = aLineCount;
     }
 
+    /**
+     * Parse the footprints, zones and tracks of a board on worker threads.  Defaults to the
+     * ParallelBoardLoad advanced setting.
+     */
+    void SetParallelLoad( bool aParallel )
+    {
+        m_parallelLoad = aParallel;
+    }
+
+    /**
+     * Skip the filled polygons of board zones which are held by \a aCache.  They are listed
+     * by GetSkippedZoneFills() after parsing, to be taken from the cache.
+     *
+     * @param aCache is the zone fill cache of the board file, or nullptr to parse all fills.
+     */
+    void SetZoneFillCache( const ZONE_FILL_CACHE* aCache )
+    {
+        m_zoneFillCache = aCache;
+    }
+
+    const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& GetSkippedZoneFills() const
+    {
+        return m_skippedZoneFills;
+    }
+
     BOARD_ITEM* Parse();
 
     /**
@@ -360,6 +391,38 @@ private:
      */
     void resolveGroups( BOARD_ITEM* aParent );
 
+    struct DEFERRED_ITEMS;
+
+    /**
+     * Copy the footprint, zone or track block whose keyword is the current token into
+     * \a aDeferred, and skip past it.  Blocks are batched so each worker gets a reasonable
+     * amount of text to parse.
+     */
+    void deferItem( std::vector<DEFERRED_ITEMS>& aDeferred );
+
+    /**
+     * Parse deferred items on worker threads, then add them to the board in file order.
+     */
+    void addDeferredItems( std::vector<DEFERRED_ITEMS>& aDeferred,
+                           std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
+    /**
+     * Parse the item blocks of \a aDeferred (already set as the line reader) into detached
+     * items.  Run on a worker parser.
+     */
+    void parseDeferredItems( DEFERRED_ITEMS& aDeferred );
+
+    /**
+     * Fix the net of a copper zone whose net name in the file doesn't match its net code,
+     * adding a net to the board if needed.
+     */
+    void resolveZoneNetName( ZONE* aZone, const wxString& aNetName );
+
+    /**
+     * Ask the user to confirm the conversion of a legacy segment zone fill.
+     */
+    void confirmLegacyZoneFill();
+
     typedef std::unordered_map< std::string, PCB_LAYER_ID > LAYER_ID_MAP;
     typedef std::unordered_map< std::string, LSET >         LSET_MAP;
     typedef std::unordered_map< wxString, KIID >            KIID_MAP;
@@ -378,6 +441,17 @@ private:
 
     bool                m_showLegacyZoneWarning;
 
+    /// True when parsing detached items on a worker thread: changes to the board itself are
+    /// recorded below and applied by the main parser.
+    bool                m_deferBoardChanges;
+    bool                m_legacyZoneFillFound;
+    std::vector<std::pair<ZONE*, wxString>> m_zoneNetNames;
+
+    bool                m_parallelLoad;      ///< parse board items on worker threads
+
+    const ZONE_FILL_CACHE* m_zoneFillCache;  ///< optional; may be nullptr
+    std::vector<std::pair<ZONE*, PCB_LAYER_ID>> m_skippedZoneFills;
+
     PROGRESS_REPORTER*  m_progressReporter;  ///< optional; may be nullptr
     const LINE_READER*  m_lineReader;        ///< for progress reporting
     unsigned            m_lastProgressLine;
@@ -397,6 +471,19 @@ private:
     };
 
     std::vector<GROUP_INFO> m_groupInfos;
+
+    struct DEFERRED_ITEMS
+    {
+        std::string                             text;
+        int                                     lineCount = 0;
+        std::vector<std::pair<int, int>>        blockLines;   ///< first line in text, in file
+
+        std::vector<BOARD_ITEM*>                items;
+        std::vector<GROUP_INFO>                 groupInfos;
+        std::vector<std::pair<ZONE*, wxString>> zoneNetNames;
+        bool                                    legacyZoneFillFound = false;
+        std::exception_ptr                      error;
+    };
 };
 
 
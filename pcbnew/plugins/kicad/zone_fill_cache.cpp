@@ -0,0 +1,492 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <plugins/kicad/zone_fill_cache.h>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <md5_hash.h>
+#include <trace_helpers.h>
+#include <zone.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+/*
+ * The cache is a header followed by one entry per zone and layer, all in the byte order of
+ * the machine which wrote it:
+ *
+ *   header:  magic, version, byte order mark, checksum of the board file, entry count
+ *   entry:   zone uuid, layer, checksum of the fill,
+ *            outlines (point count, points), islands,
+ *            triangulated polygons (vertex count, vertices, triangle count, triangles)
+ *
+ * Checksums are the 32 hex digit MD5 strings.
+ */
+
+static const char     CACHE_MAGIC[8] = { 'K', 'I', 'Z', 'O', 'N', 'E', 'S', '\n' };
+static const uint32_t CACHE_VERSION = 1;
+static const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+static const size_t   CHECKSUM_LENGTH = 32;
+
+
+template <typename T>
+static void put( std::string& aData, T aValue )
+{
+    aData.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+}
+
+
+static void putString( std::string& aData, const std::string& aString )
+{
+    put<uint32_t>( aData, (uint32_t) aString.size() );
+    aData.append( aString );
+}
+
+
+/**
+ * Read values back from the cache, failing instead of reading past its end.
+ */
+struct CACHE_CURSOR
+{
+    const char* pos;
+    const char* end;
+
+    template <typename T>
+    bool Get( T& aValue )
+    {
+        if( end - pos < (ptrdiff_t) sizeof( T ) )
+            return false;
+
+        memcpy( &aValue, pos, sizeof( T ) );
+        pos += sizeof( T );
+        return true;
+    }
+
+    bool GetString( std::string& aString )
+    {
+        uint32_t length;
+
+        if( !Get( length ) || end - pos < (ptrdiff_t) length )
+            return false;
+
+        aString.assign( pos, length );
+        pos += length;
+        return true;
+    }
+
+    bool GetPoint( VECTOR2I& aPoint )
+    {
+        int32_t x, y;
+
+        if( !Get( x ) || !Get( y ) )
+            return false;
+
+        aPoint = VECTOR2I( x, y );
+        return true;
+    }
+};
+
+
+static bool fileChecksum( const wxString& aFileName, std::string& aChecksum )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    std::vector<uint8_t> block( 1024 * 1024 );
+    MD5_HASH             hash;
+    size_t               count;
+
+    while( ( count = file.Read( block.data(), block.size() ) ) > 0 )
+        hash.Hash( block.data(), (uint32_t) count );
+
+    if( file.Error() )
+        return false;
+
+    hash.Finalize();
+    aChecksum = hash.Format( true );
+    return true;
+}
+
+
+static std::string fillChecksum( const SHAPE_POLY_SET& aFill )
+{
+    MD5_HASH hash = aFill.GetHash();
+
+    return hash.Format( true );
+}
+
+
+wxString ZONE_FILL_CACHE::CacheFileName( const wxString& aBoardFileName )
+{
+    return aBoardFileName + wxT( ".zones" );
+}
+
+
+bool ZONE_FILL_CACHE::IsEnabled()
+{
+    return ADVANCED_CFG::GetCfg().m_ZoneFillCache;
+}
+
+
+bool ZONE_FILL_CACHE::Save( BOARD* aBoard, const wxString& aBoardFileName )
+{
+    std::string checksum;
+
+    if( !fileChecksum( aBoardFileName, checksum ) )
+        return false;
+
+    std::string data( CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+    std::string entries;
+    uint32_t    entryCount = 0;
+
+    put( data, CACHE_VERSION );
+    put( data, CACHE_BYTE_ORDER );
+    data.append( checksum );
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const SHAPE_POLY_SET& fill = zone->GetFilledPolysList( layer );
+
+            if( fill.IsEmpty() )
+                continue;
+
+            // The board file only keeps the outline of each fill polygon, as straight
+            // segments.  Fills which don't fit that are left to the board file.
+            bool cacheable = true;
+
+            for( int ii = 0; ii < fill.OutlineCount() && cacheable; ++ii )
+                cacheable = fill.HoleCount( ii ) == 0 && fill.COutline( ii ).ArcCount() == 0;
+
+            if( !cacheable )
+                continue;
+
+            zone->CacheTriangulation( layer );
+
+            if( !fill.IsTriangulationUpToDate() )
+                continue;
+
+            putString( entries, TO_UTF8( zone->m_Uuid.AsString() ) );
+            put<int32_t>( entries, layer );
+            entries.append( fillChecksum( fill ) );
+
+            put<uint32_t>( entries, fill.OutlineCount() );
+
+            for( int ii = 0; ii < fill.OutlineCount(); ++ii )
+            {
+                const SHAPE_LINE_CHAIN& chain = fill.COutline( ii );
+
+                put<uint32_t>( entries, chain.PointCount() );
+
+                for( int jj = 0; jj < chain.PointCount(); ++jj )
+                {
+                    put<int32_t>( entries, chain.CPoint( jj ).x );
+                    put<int32_t>( entries, chain.CPoint( jj ).y );
+                }
+            }
+
+            std::vector<int32_t> islands;
+
+            for( int ii = 0; ii < fill.OutlineCount(); ++ii )
+            {
+                if( zone->IsIsland( layer, ii ) )
+                    islands.push_back( ii );
+            }
+
+            put<uint32_t>( entries, islands.size() );
+
+            for( int32_t island : islands )
+                put( entries, island );
+
+            put<uint32_t>( entries, fill.TriangulatedPolyCount() );
+
+            for( unsigned ii = 0; ii < fill.TriangulatedPolyCount(); ++ii )
+            {
+                const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = fill.TriangulatedPolygon( ii );
+
+                put<uint32_t>( entries, tri->Vertices().size() );
+
+                for( const VECTOR2I& vertex : tri->Vertices() )
+                {
+                    put<int32_t>( entries, vertex.x );
+                    put<int32_t>( entries, vertex.y );
+                }
+
+                put<uint32_t>( entries, tri->Triangles().size() );
+
+                for( const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI& triangle : tri->Triangles() )
+                {
+                    put<int32_t>( entries, triangle.a );
+                    put<int32_t>( entries, triangle.b );
+                    put<int32_t>( entries, triangle.c );
+                }
+            }
+
+            entryCount++;
+        }
+    }
+
+    put( data, entryCount );
+    data.append( entries );
+
+    wxString cacheFileName = CacheFileName( aBoardFileName );
+    wxFFile  file( cacheFileName, wxT( "wb" ) );
+
+    if( !file.IsOpened() || !file.Write( data.data(), data.size() ) || !file.Close() )
+    {
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Could not write zone fill cache '%s'." ),
+                    cacheFileName );
+        return false;
+    }
+
+    return true;
+}
+
+
+void ZONE_FILL_CACHE::Rename( const wxString& aBoardFileName, const wxString& aNewBoardFileName )
+{
+    wxString cacheFileName = CacheFileName( aBoardFileName );
+    wxString newCacheFileName = CacheFileName( aNewBoardFileName );
+
+    // A cache left from an earlier save would be stale; don't keep it beside the new board
+    if( !wxFileName::FileExists( cacheFileName ) )
+        wxRemoveFile( newCacheFileName );
+    else if( !wxRenameFile( cacheFileName, newCacheFileName, true ) )
+        wxRemoveFile( cacheFileName );
+}
+
+
+bool ZONE_FILL_CACHE::Load( const wxString& aBoardFileName )
+{
+    m_entries.clear();
+
+    wxString cacheFileName = CacheFileName( aBoardFileName );
+
+    if( !wxFileName::FileExists( cacheFileName ) )
+        return false;
+
+    std::vector<char> data;
+
+    {
+        wxFFile file( cacheFileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() )
+            return false;
+
+        data.resize( (size_t) file.Length() );
+
+        if( file.Read( data.data(), data.size() ) != data.size() )
+            return false;
+    }
+
+    CACHE_CURSOR cursor{ data.data(), data.data() + data.size() };
+    uint32_t     version = 0;
+    uint32_t     byteOrder = 0;
+    uint32_t     entryCount = 0;
+    std::string  checksum;
+    std::string  boardChecksum;
+
+    if( data.size() < sizeof( CACHE_MAGIC ) + 2 * sizeof( uint32_t ) + CHECKSUM_LENGTH
+            || memcmp( data.data(), CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) != 0 )
+    {
+        return false;
+    }
+
+    cursor.pos += sizeof( CACHE_MAGIC );
+    cursor.Get( version );
+    cursor.Get( byteOrder );
+    checksum.assign( cursor.pos, CHECKSUM_LENGTH );
+    cursor.pos += CHECKSUM_LENGTH;
+
+    if( version != CACHE_VERSION || byteOrder != CACHE_BYTE_ORDER || !cursor.Get( entryCount ) )
+        return false;
+
+    if( !fileChecksum( aBoardFileName, boardChecksum ) || boardChecksum != checksum )
+    {
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Zone fill cache '%s' is stale." ),
+                    cacheFileName );
+        return false;
+    }
+
+    auto readEntry =
+            [&]( ENTRY& aEntry, std::string& aFillChecksum ) -> bool
+            {
+                uint32_t count;
+
+                if( cursor.end - cursor.pos < (ptrdiff_t) CHECKSUM_LENGTH )
+                    return false;
+
+                aFillChecksum.assign( cursor.pos, CHECKSUM_LENGTH );
+                cursor.pos += CHECKSUM_LENGTH;
+
+                if( !cursor.Get( count ) )
+                    return false;
+
+                for( uint32_t ii = 0; ii < count; ++ii )
+                {
+                    uint32_t          pointCount;
+                    SHAPE_LINE_CHAIN& chain = aEntry.fill.Outline( aEntry.fill.NewOutline() );
+                    VECTOR2I          pt;
+
+                    if( !cursor.Get( pointCount ) )
+                        return false;
+
+                    for( uint32_t jj = 0; jj < pointCount; ++jj )
+                    {
+                        if( !cursor.GetPoint( pt ) )
+                            return false;
+
+                        chain.Append( pt, true );
+                    }
+                }
+
+                if( !cursor.Get( count ) )
+                    return false;
+
+                for( uint32_t ii = 0; ii < count; ++ii )
+                {
+                    int32_t island;
+
+                    if( !cursor.Get( island ) )
+                        return false;
+
+                    aEntry.islands.insert( island );
+                }
+
+                if( !cursor.Get( count ) )
+                    return false;
+
+                std::vector<std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>> triangulation;
+
+                for( uint32_t ii = 0; ii < count; ++ii )
+                {
+                    uint32_t vertexCount;
+                    uint32_t triangleCount;
+                    VECTOR2I pt;
+
+                    triangulation.push_back(
+                            std::make_unique<SHAPE_POLY_SET::TRIANGULATED_POLYGON>() );
+
+                    if( !cursor.Get( vertexCount ) )
+                        return false;
+
+                    for( uint32_t jj = 0; jj < vertexCount; ++jj )
+                    {
+                        if( !cursor.GetPoint( pt ) )
+                            return false;
+
+                        triangulation.back()->AddVertex( pt );
+                    }
+
+                    if( !cursor.Get( triangleCount ) )
+                        return false;
+
+                    for( uint32_t jj = 0; jj < triangleCount; ++jj )
+                    {
+                        int32_t a, b, c;
+
+                        if( !cursor.Get( a ) || !cursor.Get( b ) || !cursor.Get( c ) )
+                            return false;
+
+                        if( a < 0 || b < 0 || c < 0 || (uint32_t) a >= vertexCount
+                                || (uint32_t) b >= vertexCount || (uint32_t) c >= vertexCount )
+                        {
+                            return false;
+                        }
+
+                        triangulation.back()->AddTriangle( a, b, c );
+                    }
+                }
+
+                aEntry.fill.SetTriangulation( std::move( triangulation ) );
+                return true;
+            };
+
+    for( uint32_t ii = 0; ii < entryCount; ++ii )
+    {
+        std::string uuid;
+        int32_t     layer;
+        std::string entryChecksum;
+        ENTRY       entry;
+
+        if( !cursor.GetString( uuid ) || !cursor.Get( layer )
+                || layer < 0 || layer >= PCB_LAYER_ID_COUNT
+                || !readEntry( entry, entryChecksum )
+                || fillChecksum( entry.fill ) != entryChecksum )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Zone fill cache '%s' is damaged." ),
+                        cacheFileName );
+            m_entries.clear();
+            return false;
+        }
+
+        m_entries[ std::make_pair( KIID( wxString( uuid ) ), PCB_LAYER_ID( layer ) ) ] = std::move( entry );
+    }
+
+    return true;
+}
+
+
+bool ZONE_FILL_CACHE::Contains( const KIID& aZone, PCB_LAYER_ID aLayer ) const
+{
+    return m_entries.count( std::make_pair( aZone, aLayer ) ) > 0;
+}
+
+
+void ZONE_FILL_CACHE::Apply( const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aSkippedFills )
+{
+    std::set<ZONE*> zones;
+
+    for( const std::pair<ZONE*, PCB_LAYER_ID>& skipped : aSkippedFills )
+    {
+        ZONE*        zone = skipped.first;
+        PCB_LAYER_ID layer = skipped.second;
+        auto         it = m_entries.find( std::make_pair( zone->m_Uuid, layer ) );
+
+        wxCHECK2( it != m_entries.end(), continue );
+
+        zone->SetFilledPolysList( layer, it->second.fill );
+
+        for( int island : it->second.islands )
+            zone->SetIsIsland( layer, island );
+
+        zones.insert( zone );
+    }
+
+    for( ZONE* zone : zones )
+        zone->CalculateFilledArea();
+}
@@ -0,0 +1,108 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_FILL_CACHE_H_
+#define ZONE_FILL_CACHE_H_
+
+#include <geometry/shape_poly_set.h>
+#include <kiid.h>
+#include <layer_ids.h>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+class BOARD;
+class ZONE;
+
+
+/**
+ * A binary sidecar file holding the zone fills of a board file, with their triangulations.
+ *
+ * When a board is loaded with a valid cache, the filled polygons are not parsed from the
+ * board file and need not be triangulated again for display.  A cache is only valid for the
+ * exact board file it was written along with, which is checked with a checksum of that file.
+ * Anything else, including a damaged cache, makes it stale and it is ignored until the board
+ * is saved again.
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    /**
+     * @return the name of the cache file of \a aBoardFileName.
+     */
+    static wxString CacheFileName( const wxString& aBoardFileName );
+
+    /**
+     * @return true if boards are loaded and saved with their caches, as set by the
+     *         ZoneFillCache advanced setting.
+     */
+    static bool IsEnabled();
+
+    /**
+     * Write the cache of \a aBoard, which has just been saved as \a aBoardFileName.
+     *
+     * Zone fills which are not triangulated yet are triangulated first.
+     *
+     * @return false if the cache could not be written.
+     */
+    static bool Save( BOARD* aBoard, const wxString& aBoardFileName );
+
+    /**
+     * Move the cache of \a aBoardFileName along with it, for saves which write a temporary
+     * board file and then rename it to \a aNewBoardFileName.
+     */
+    static void Rename( const wxString& aBoardFileName, const wxString& aNewBoardFileName );
+
+    /**
+     * Read the cache of \a aBoardFileName with a single read.
+     *
+     * @return false if there is no cache, or it is stale.
+     */
+    bool Load( const wxString& aBoardFileName );
+
+    /**
+     * @return true if the cache holds the fill of \a aZone on \a aLayer, so the parser can
+     *         skip it.
+     */
+    bool Contains( const KIID& aZone, PCB_LAYER_ID aLayer ) const;
+
+    /**
+     * Give the cached fills to the zones whose filled polygons were skipped when parsing.
+     *
+     * @param aSkippedFills lists each zone and layer which was skipped.
+     */
+    void Apply( const std::vector<std::pair<ZONE*, PCB_LAYER_ID>>& aSkippedFills );
+
+private:
+    struct ENTRY
+    {
+        SHAPE_POLY_SET fill;
+        std::set<int>  islands;
+    };
+
+    std::map<std::pair<KIID, PCB_LAYER_ID>, ENTRY> m_entries;
+};
+
+#endif  // ZONE_FILL_CACHE_H_
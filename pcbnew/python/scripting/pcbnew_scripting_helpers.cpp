@@ -125,8 +125,7 @@ PROJECT* GetDefaultProject()
 
 BOARD* LoadBoard( wxString& aFileName, IO_MGR::PCB_FILE_T aFormat )
 {
-    wxFileName pro = aFileName;
-    pro.SetExt( ProjectFileExtension );
+    wxFileName pro = ChangeFileExtension( aFileName, ProjectFileExtension );
     pro.MakeAbsolute();
     wxString projectPath = pro.GetFullPath();
 
@@ -218,8 +217,7 @@ bool SaveBoard( wxString& aFileName, BOARD* aBoard, IO_MGR::PCB_FILE_T aFormat )
         return false;
     }
 
-    wxFileName pro = aFileName;
-    pro.SetExt( ProjectFileExtension );
+    wxFileName pro = ChangeFileExtension( aFileName, ProjectFileExtension );
     pro.MakeAbsolute();
     wxString projectPath = pro.GetFullPath();
 
@@ -406,8 +404,7 @@ bool WriteDRCReport( BOARD* aBoard, const wxString& aFileName, EDA_UNITS aUnits,
 
     wxCHECK( engine, false );
 
-    wxFileName fn = aBoard->GetFileName();
-    fn.SetExt( DesignRulesFileExtension );
+    wxFileName fn = ChangeFileExtension( aBoard->GetFileName(), DesignRulesFileExtension );
     wxString drcRulesPath = s_SettingsManager->Prj().AbsolutePath( fn.GetFullName() );
 
     try
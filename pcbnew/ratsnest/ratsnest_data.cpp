@@ -41,6 +41,7 @@ using namespace std::placeholders;
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <unordered_map>
 
 #include <delaunator.hpp>
 
@@ -106,9 +107,10 @@ private:
     std::vector<int> m_depth;
 };
 
-void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
+bool RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
 {
     disjoint_set dset( m_nodes.size() );
+    size_t       unions = 0;
 
     m_rnEdges.clear();
 
@@ -124,22 +126,23 @@ void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
 
         if( dset.unite( u, v ) )
         {
+            unions++;
+
             if( tmp.GetWeight() > 0 )
                 m_rnEdges.push_back( tmp );
         }
     }
+
+    return unions + 1 >= m_nodes.size();
 }
 
 
 class RN_NET::TRIANGULATOR_STATE
 {
 private:
-    std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP> m_allNodes;
-
-
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
-    bool areNodesColinear( const std::vector<CN_ANCHOR_PTR>& aNodes ) const
+    bool areNodesColinear( const std::vector<CN_ANCHOR*>& aNodes ) const
     {
         if ( aNodes.size() <= 2 )
             return true;
@@ -160,32 +163,30 @@ private:
 
 public:
 
-    void Clear()
-    {
-        m_allNodes.clear();
-    }
-
-    void AddNode( CN_ANCHOR_PTR aNode )
-    {
-        m_allNodes.insert( aNode );
-    }
-
-    void Triangulate( std::vector<CN_EDGE>& mstEdges)
+    /**
+     * Build the candidate edges for the spanning tree.  \a aNodes is the net's node set, which
+     * is already sorted by position and keeps the anchors alive, so only raw pointers are
+     * handled here.
+     */
+    void Triangulate( const std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP>& aNodes,
+                      std::vector<CN_EDGE>& mstEdges )
     {
         std::vector<double>          node_pts;
 
-        using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
+        using ANCHOR_LIST = std::vector<CN_ANCHOR*>;
 
         ANCHOR_LIST              anchors;
-        std::vector<ANCHOR_LIST> anchorChains( m_allNodes.size() );
+        std::vector<ANCHOR_LIST> anchorChains( aNodes.size() );
 
-        node_pts.reserve( 2 * m_allNodes.size() );
-        anchors.reserve( m_allNodes.size() );
+        node_pts.reserve( 2 * aNodes.size() );
+        anchors.reserve( aNodes.size() );
 
-        CN_ANCHOR_PTR prev = nullptr;
+        CN_ANCHOR* prev = nullptr;
 
-        for( const auto& n : m_allNodes )
+        for( const CN_ANCHOR_PTR& node : aNodes )
         {
+            CN_ANCHOR* n = node.get();
+
             if( !prev || prev->Pos() != n->Pos() )
             {
                 node_pts.push_back( n->Pos().x );
@@ -208,8 +209,8 @@ public:
             // and chain the nodes together.
             for( size_t i = 0; i < anchors.size() - 1; i++ )
             {
-                auto src = anchors[i];
-                auto dst = anchors[i + 1];
+                CN_ANCHOR* src = anchors[i];
+                CN_ANCHOR* dst = anchors[i + 1];
                 mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
             }
         }
@@ -220,8 +221,8 @@ public:
 
             for( size_t i = 0; i < triangles.size(); i += 3 )
             {
-                auto src = anchors[triangles[i]];
-                auto dst = anchors[triangles[i + 1]];
+                CN_ANCHOR* src = anchors[triangles[i]];
+                CN_ANCHOR* dst = anchors[triangles[i + 1]];
                 mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
 
                 src = anchors[triangles[i + 1]];
@@ -238,8 +239,8 @@ public:
                 if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
                     continue;
 
-                auto src = anchors[triangles[i]];
-                auto dst = anchors[triangles[delaunator.halfedges[i]]];
+                CN_ANCHOR* src = anchors[triangles[i]];
+                CN_ANCHOR* dst = anchors[triangles[delaunator.halfedges[i]]];
                 mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
             }
         }
@@ -252,14 +253,14 @@ public:
                 continue;
 
             std::sort( chain.begin(), chain.end(),
-                    [] ( const CN_ANCHOR_PTR& a, const CN_ANCHOR_PTR& b ) {
+                    [] ( const CN_ANCHOR* a, const CN_ANCHOR* b ) {
                 return a->GetCluster().get() < b->GetCluster().get();
             } );
 
             for( unsigned int j = 1; j < chain.size(); j++ )
             {
-                const auto& prevNode    = chain[j - 1];
-                const auto& curNode     = chain[j];
+                CN_ANCHOR* prevNode = chain[j - 1];
+                CN_ANCHOR* curNode  = chain[j];
                 int weight = prevNode->GetCluster() != curNode->GetCluster() ? 1 : 0;
                 mstEdges.emplace_back( prevNode, curNode, weight );
             }
@@ -288,7 +289,7 @@ void RN_NET::compute()
             auto last = ++m_nodes.begin();
 
             // There can be only one possible connection, but it is missing
-            CN_EDGE edge ( *m_nodes.begin(), *last );
+            CN_EDGE edge( m_nodes.begin()->get(), last->get() );
             edge.GetSourceNode()->SetTag( 0 );
             edge.GetTargetNode()->SetTag( 1 );
 
@@ -305,20 +306,13 @@ void RN_NET::compute()
     }
 
 
-    m_triangulator->Clear();
-
-    for( const auto& n : m_nodes )
-    {
-        m_triangulator->AddNode( n );
-    }
-
     std::vector<CN_EDGE> triangEdges;
     triangEdges.reserve( m_nodes.size() + m_boardEdges.size() );
 
     #ifdef PROFILE
     PROF_COUNTER cnt("triangulate");
     #endif
-    m_triangulator->Triangulate( triangEdges );
+    m_triangulator->Triangulate( m_nodes, triangEdges );
     #ifdef PROFILE
     cnt.Show();
     #endif
@@ -340,9 +334,175 @@ void RN_NET::compute()
 
 
 
+bool RN_NET::computeIncremental()
+{
+    // Below this, a full recompute is as cheap as working out what changed
+    const size_t minNodes = 64;
+
+    // Number of nearest nodes each changed node is connected to as candidate edges
+    const size_t nearestCount = 6;
+
+    if( m_nodes.size() < minNodes || m_prevNodes.empty() )
+        return false;
+
+    // Beyond this many changed nodes the local candidate set stops being a good approximation
+    // of the triangulation (and is no longer cheaper)
+    const size_t maxChanged = std::max<size_t>( 8, m_nodes.size() / 32 );
+
+    std::vector<CN_ANCHOR*>                                nodes;
+    std::unordered_map<CN_ANCHOR*, size_t>                 nodeIndex;
+    std::unordered_map<CN_CLUSTER*, std::vector<size_t>>   clusterNodes;
+    std::unordered_map<CN_CLUSTER*, size_t>                prevClusterSizes;
+    std::vector<size_t>                                    changed;
+    size_t                                                 added = 0;
+
+    nodes.reserve( m_nodes.size() );
+    nodeIndex.reserve( m_nodes.size() );
+
+    for( const std::pair<CN_ANCHOR* const, CN_CLUSTER_PTR>& entry : m_prevClusters )
+        prevClusterSizes[ entry.second.get() ]++;
+
+    for( const CN_ANCHOR_PTR& node : m_nodes )
+    {
+        nodeIndex[ node.get() ] = nodes.size();
+        clusterNodes[ node->GetCluster().get() ].push_back( nodes.size() );
+
+        if( !m_prevClusters.count( node.get() ) )
+            added++;
+
+        nodes.push_back( node.get() );
+    }
+
+    size_t removed = m_prevNodes.size() + added - m_nodes.size();
+
+    // A cluster is unchanged if its nodes are exactly those of one previous cluster.  All the
+    // nodes of the other ones are changed: when a deleted track splits a cluster, the edge
+    // which joined its halves is gone and neither half has new nodes to reconnect from.
+    for( const std::pair<CN_CLUSTER* const, std::vector<size_t>>& cluster : clusterNodes )
+    {
+        CN_CLUSTER* prevCluster = nullptr;
+        bool        same = true;
+
+        for( size_t idx : cluster.second )
+        {
+            auto it = m_prevClusters.find( nodes[idx] );
+
+            if( it == m_prevClusters.end()
+                    || ( prevCluster && prevCluster != it->second.get() ) )
+            {
+                same = false;
+                break;
+            }
+
+            prevCluster = it->second.get();
+        }
+
+        if( same && prevClusterSizes[ prevCluster ] == cluster.second.size() )
+            continue;
+
+        changed.insert( changed.end(), cluster.second.begin(), cluster.second.end() );
+
+        if( changed.size() + removed > maxChanged )
+            return false;
+    }
+
+    std::vector<CN_EDGE> candidates;
+    candidates.reserve( m_boardEdges.size() + m_prevRnEdges.size() + 2 * nearestCount * maxChanged );
+
+    for( const CN_EDGE& edge : m_boardEdges )
+        candidates.push_back( edge );
+
+    // Keep the previous tree edges that still join two live nodes.  Where an edge lost one of
+    // its ends, the remaining end has to find a new connection.
+    for( const CN_EDGE& edge : m_prevRnEdges )
+    {
+        auto src = nodeIndex.find( edge.GetSourceNode() );
+        auto dst = nodeIndex.find( edge.GetTargetNode() );
+
+        if( src != nodeIndex.end() && dst != nodeIndex.end() )
+            candidates.push_back( edge );
+        else if( src != nodeIndex.end() )
+            changed.push_back( src->second );
+        else if( dst != nodeIndex.end() )
+            changed.push_back( dst->second );
+    }
+
+    std::sort( changed.begin(), changed.end() );
+    changed.erase( std::unique( changed.begin(), changed.end() ), changed.end() );
+
+    auto edgeWeight =
+            []( CN_ANCHOR* a, CN_ANCHOR* b ) -> unsigned
+            {
+                unsigned dist = a->Dist( *b );
+
+                if( dist == 0 && a->GetCluster() != b->GetCluster() )
+                    return 1;
+
+                return dist;
+            };
+
+    // The nodes are sorted by x, so the nearest ones can be found by sweeping both ways from
+    // the changed node until the x distance alone exceeds the worst of the current best.
+    for( size_t idx : changed )
+    {
+        CN_ANCHOR*                                             node = nodes[idx];
+        std::vector<std::pair<VECTOR2I::extended_type, size_t>> best;
+
+        auto consider =
+                [&]( size_t aOther ) -> bool
+                {
+                    VECTOR2I::extended_type distX = nodes[aOther]->Pos().x - node->Pos().x;
+
+                    if( best.size() == nearestCount && distX * distX > best.back().first )
+                        return false;
+
+                    // The board edges already join the node to its own cluster
+                    if( nodes[aOther]->GetCluster() == node->GetCluster() )
+                        return true;
+
+                    VECTOR2I::extended_type d =
+                            ( nodes[aOther]->Pos() - node->Pos() ).SquaredEuclideanNorm();
+
+                    if( best.size() < nearestCount || d < best.back().first )
+                    {
+                        if( best.size() == nearestCount )
+                            best.pop_back();
+
+                        best.insert( std::upper_bound( best.begin(), best.end(),
+                                                       std::make_pair( d, aOther ) ),
+                                     std::make_pair( d, aOther ) );
+                    }
+
+                    return true;
+                };
+
+        for( size_t ii = idx + 1; ii < nodes.size() && consider( ii ); ++ii )
+            ;
+
+        for( size_t ii = idx; ii > 0 && consider( ii - 1 ); --ii )
+            ;
+
+        for( const auto& entry : best )
+        {
+            CN_ANCHOR* other = nodes[entry.second];
+            candidates.emplace_back( node, other, edgeWeight( node, other ) );
+        }
+    }
+
+    std::sort( candidates.begin(), candidates.end() );
+
+    return kruskalMST( candidates );
+}
+
+
 void RN_NET::Update()
 {
-    compute();
+    if( !computeIncremental() )
+        compute();
+
+    m_prevNodes.clear();
+    m_prevRnEdges.clear();
+    m_prevClusters.clear();
 
     m_dirty = false;
 }
@@ -350,6 +510,19 @@ void RN_NET::Update()
 
 void RN_NET::Clear()
 {
+    // Keep the previous state around so that Update() can patch it instead of recomputing
+    // it all.  Nothing is kept if the net was never computed.
+    if( !m_dirty )
+    {
+        m_prevClusters.clear();
+
+        for( const CN_ANCHOR_PTR& node : m_nodes )
+            m_prevClusters[ node.get() ] = node->GetCluster();
+
+        m_prevNodes = std::move( m_nodes );
+        m_prevRnEdges = std::move( m_rnEdges );
+    }
+
     m_rnEdges.clear();
     m_boardEdges.clear();
     m_nodes.clear();
@@ -360,7 +533,7 @@ void RN_NET::Clear()
 
 void RN_NET::AddCluster( CN_CLUSTER_PTR aCluster )
 {
-    CN_ANCHOR_PTR firstAnchor;
+    CN_ANCHOR* firstAnchor = nullptr;
 
     for( auto item : *aCluster )
     {
@@ -378,28 +551,28 @@ void RN_NET::AddCluster( CN_CLUSTER_PTR aCluster )
 
             if( firstAnchor )
             {
-                if( firstAnchor != anchors[i] )
+                if( firstAnchor != anchors[i].get() )
                 {
-                    m_boardEdges.emplace_back( firstAnchor, anchors[i], 0 );
+                    m_boardEdges.emplace_back( firstAnchor, anchors[i].get(), 0 );
                 }
             }
             else
             {
-                firstAnchor = anchors[i];
+                firstAnchor = anchors[i].get();
             }
         }
     }
 }
 
 
-bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode1,
-        CN_ANCHOR_PTR& aNode2 ) const
+bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR*& aNode1,
+        CN_ANCHOR*& aNode2 ) const
 {
     bool rv = false;
 
     VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
 
-    auto verify = [&]( auto& aTestNode1, auto& aTestNode2 )
+    auto verify = [&]( const CN_ANCHOR_PTR& aTestNode1, const CN_ANCHOR_PTR& aTestNode2 )
         {
             auto squaredDist = ( aTestNode1->Pos() - aTestNode2->Pos() ).SquaredEuclideanNorm();
 
@@ -407,8 +580,8 @@ bool RN_NET::NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode
             {
                 rv      = true;
                 distMax = squaredDist;
-                aNode1  = aTestNode1;
-                aNode2  = aTestNode2;
+                aNode1  = aTestNode1.get();
+                aNode2  = aTestNode2.get();
             }
         };
 
@@ -36,6 +36,7 @@
 #include <math/box2.h>
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <connectivity/connectivity_algo.h>
@@ -141,19 +142,44 @@ public:
      */
     const CN_ANCHOR_PTR GetClosestNode( const CN_ANCHOR_PTR& aNode ) const;
 
-    bool NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode1,
-                               CN_ANCHOR_PTR& aNode2 ) const;
+    bool NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR*& aNode1,
+                               CN_ANCHOR*& aNode2 ) const;
 
 protected:
     ///< Recompute ratsnest from scratch.
     void compute();
 
-    ///< Compute the minimum spanning tree using Kruskal's algorithm
-    void kruskalMST( const std::vector<CN_EDGE> &aEdges );
+    /**
+     * Update the ratsnest from the one computed before the last Clear(), when only a few
+     * nodes have been added or removed since.  Candidate edges are the previous tree edges
+     * that are still valid plus edges from the changed area to its nearest nodes in other
+     * clusters.  The changed area is every node of a cluster which gained, lost or exchanged
+     * nodes, so a cluster split by a deleted track looks for new connections on both sides.
+     *
+     * @return false if the change was too large or the candidate edges do not span the net,
+     *         in which case the caller must fall back to compute().
+     */
+    bool computeIncremental();
+
+    /**
+     * Compute the minimum spanning tree using Kruskal's algorithm.
+     *
+     * @return true if the edges connected all the nodes.
+     */
+    bool kruskalMST( const std::vector<CN_EDGE> &aEdges );
 
     ///< Vector of nodes
     std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP> m_nodes;
 
+    ///< Nodes and ratsnest edges before the last Clear(), used by computeIncremental().  The
+    ///< nodes keep the anchors referenced by the edges alive.
+    std::multiset<CN_ANCHOR_PTR, CN_PTR_CMP> m_prevNodes;
+    std::vector<CN_EDGE>                     m_prevRnEdges;
+
+    ///< Clusters of m_prevNodes before the last Clear(); AddCluster() overwrites the ones the
+    ///< anchors hold.
+    std::unordered_map<CN_ANCHOR*, CN_CLUSTER_PTR> m_prevClusters;
+
     ///< Vector of edges that make pre-defined connections
     std::vector<CN_EDGE> m_boardEdges;
 
@@ -177,8 +177,8 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
             //if ( !edge.IsVisible() )
             //    continue;
 
-            const auto& sourceNode = edge.GetSourceNode();
-            const auto& targetNode = edge.GetTargetNode();
+            const CN_ANCHOR* sourceNode = edge.GetSourceNode();
+            const CN_ANCHOR* targetNode = edge.GetTargetNode();
             const VECTOR2I source( sourceNode->Pos() );
             const VECTOR2I target( targetNode->Pos() );
 
@@ -332,6 +332,9 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
         THROW_IO_ERROR( _("Session file is missing the \"library_out\" section") );
 
     // delete all the old tracks and vias
+    for( PCB_TRACK* track : aBoard->Tracks() )
+        aBoard->UnindexItem( track );
+
     aBoard->Tracks().clear();
 
     aBoard->DeleteMARKERs();
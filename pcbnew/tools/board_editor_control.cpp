@@ -535,6 +535,9 @@ int BOARD_EDITOR_CONTROL::RepairBoard( const TOOL_EVENT& aEvent )
 
                 ids.insert( aItem->m_Uuid );
 
+                // Whoever claims a KIID must also own it in the board's index
+                board()->IndexItem( static_cast<BOARD_ITEM*>( aItem ) );
+
                 BOARD_CONNECTED_ITEM* cItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem );
 
                 if( cItem && cItem->GetNetCode() )
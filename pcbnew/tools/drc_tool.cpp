@@ -37,6 +37,7 @@
 #include <drc/drc_engine.h>
 #include <drc/drc_results_provider.h>
 #include <netlist_reader/pcb_netlist.h>
+#include <advanced_config.h>
 
 DRC_TOOL::DRC_TOOL() :
         PCB_TOOL_BASE( "pcbnew.DRCTool" ),
@@ -170,6 +171,7 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
     }
 
     m_drcEngine->SetProgressReporter( aProgressReporter );
+    m_drcEngine->SetRuleProfiling( ADVANCED_CFG::GetCfg().m_DRCProfileRules );
 
     m_drcEngine->SetViolationHandler(
             [&]( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
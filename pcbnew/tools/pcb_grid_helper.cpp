@@ -30,6 +30,7 @@
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_group.h>
+#include <pcb_marker.h>
 #include <pcb_track.h>
 #include <zone.h>
 #include <geometry/shape_circle.h>
@@ -315,32 +316,70 @@ std::set<BOARD_ITEM*> PCB_GRID_HELPER::queryVisible( const BOX2I& aArea,
                                                      const std::vector<BOARD_ITEM*>& aSkip ) const
 {
     std::set<BOARD_ITEM*> items;
-    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> selectedItems;
 
+    BOARD*                        board = static_cast<BOARD*>( m_toolMgr->GetModel() );
     KIGFX::VIEW*                  view = m_toolMgr->GetView();
     RENDER_SETTINGS*              settings = view->GetPainter()->GetSettings();
     const std::set<unsigned int>& activeLayers = settings->GetHighContrastLayers();
     bool                          isHighContrast = settings->GetHighContrast();
+    bool                          isFootprintEditor =
+            static_cast<PCB_TOOL_BASE*>( m_toolMgr->GetCurrentTool() )->IsFootprintEditor();
 
-    view->Query( aArea, selectedItems );
+    auto addIfVisible =
+            [&]( BOARD_ITEM* aItem ) -> bool
+            {
+                // If we are in the footprint editor, don't use the footprint itself
+                if( isFootprintEditor && aItem->Type() == PCB_FOOTPRINT_T )
+                    return true;
 
-    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& it : selectedItems )
-    {
-        BOARD_ITEM* item = static_cast<BOARD_ITEM*>( it.first );
+                if( !view->IsVisible( aItem ) )
+                    return true;
 
-        // If we are in the footprint editor, don't use the footprint itself
-        if( static_cast<PCB_TOOL_BASE*>( m_toolMgr->GetCurrentTool() )->IsFootprintEditor()
-                && item->Type() == PCB_FOOTPRINT_T )
-        {
-            continue;
-        }
+                int layers[KIGFX::VIEW::VIEW_MAX_LAYERS];
+                int layers_count;
+
+                aItem->ViewGetLayers( layers, layers_count );
+
+                // The item must be visible and on an active layer
+                for( int i = 0; i < layers_count; ++i )
+                {
+                    if( view->IsLayerVisible( layers[i] )
+                            && ( !isHighContrast || activeLayers.count( layers[i] ) )
+                            && aItem->ViewGetLOD( layers[i], view ) < view->GetScale() )
+                    {
+                        items.insert( aItem );
+                        break;
+                    }
+                }
+
+                return true;
+            };
+
+    board->QueryItems( aArea, LSET::AllLayersMask(), addIfVisible );
+
+    // Markers and groups are not in the board's spatial index
+    auto addIfInArea =
+            [&]( BOARD_ITEM* aItem )
+            {
+                EDA_RECT bbox = aItem->GetBoundingBox();
+                bbox.Normalize();
 
-        // The item must be visible and on an active layer
-        if( view->IsVisible( item )
-                && ( !isHighContrast || activeLayers.count( it.second ) )
-                && item->ViewGetLOD( it.second, view ) < view->GetScale() )
+                if( BOX2I( bbox.GetOrigin(), bbox.GetSize() ).Intersects( aArea ) )
+                    addIfVisible( aItem );
+            };
+
+    for( PCB_MARKER* marker : board->Markers() )
+        addIfInArea( marker );
+
+    for( PCB_GROUP* group : board->Groups() )
+        addIfInArea( group );
+
+    if( isFootprintEditor )
+    {
+        for( FOOTPRINT* footprint : board->Footprints() )
         {
-            items.insert ( item );
+            for( PCB_GROUP* group : footprint->Groups() )
+                addIfInArea( group );
         }
     }
 
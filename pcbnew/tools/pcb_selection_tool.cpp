@@ -1244,11 +1244,12 @@ void PCB_SELECTION_TOOL::selectAllItemsOnNet( int aNetCode, bool aSelect )
     constexpr KICAD_T types[] = { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, EOT };
     auto connectivity = board()->GetConnectivity();
 
-    for( BOARD_CONNECTED_ITEM* item : connectivity->GetNetItems( aNetCode, types ) )
-    {
-        if( itemPassesFilter( item, true ) )
-            aSelect ? select( item ) : unselect( item );
-    }
+    connectivity->ForEachNetItem( aNetCode, types,
+            [&]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                if( itemPassesFilter( aItem, true ) )
+                    aSelect ? select( aItem ) : unselect( aItem );
+            } );
 }
 
 
@@ -1334,20 +1335,24 @@ void PCB_SELECTION_TOOL::selectAllItemsOnSheet( wxString& aSheetPath )
     std::list<int> removeCodeList;
     constexpr KICAD_T padType[] = { PCB_PAD_T, EOT };
 
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = board()->GetConnectivity();
+
     for( int netCode : netcodeList )
     {
-        for( BOARD_CONNECTED_ITEM* mitem : board()->GetConnectivity()->GetNetItems( netCode,
-                                                                                    padType ) )
-        {
-            if( mitem->Type() == PCB_PAD_T && !alg::contains( footprintList, mitem->GetParent() ) )
-            {
-                // if we cannot find the footprint of the pad in the footprintList then we can
-                // assume that that footprint is not located in the same schematic, therefore
-                // invalidate this netcode.
-                removeCodeList.push_back( netCode );
-                break;
-            }
-        }
+        bool foreignPad = false;
+
+        connectivity->ForEachNetItem( netCode, padType,
+                [&]( BOARD_CONNECTED_ITEM* aItem )
+                {
+                    // if we cannot find the footprint of the pad in the footprintList then we
+                    // can assume that that footprint is not located in the same schematic,
+                    // therefore invalidate this netcode.
+                    if( !alg::contains( footprintList, aItem->GetParent() ) )
+                        foreignPad = true;
+                } );
+
+        if( foreignPad )
+            removeCodeList.push_back( netCode );
     }
 
     // remove all duplicates
@@ -1364,9 +1369,11 @@ void PCB_SELECTION_TOOL::selectAllItemsOnSheet( wxString& aSheetPath )
 
     for( int netCode : netcodeList )
     {
-        for( BOARD_CONNECTED_ITEM* item : board()->GetConnectivity()->GetNetItems( netCode,
-                                                                                   trackViaType ) )
-            localConnectionList.push_back( item );
+        connectivity->ForEachNetItem( netCode, trackViaType,
+                [&]( BOARD_CONNECTED_ITEM* aItem )
+                {
+                    localConnectionList.push_back( aItem );
+                } );
     }
 
     for( BOARD_ITEM* i : footprintList )
@@ -2259,27 +2266,52 @@ void PCB_SELECTION_TOOL::unhighlightInternal( BOARD_ITEM* aItem, int aMode, bool
 
 bool PCB_SELECTION_TOOL::selectionContains( const VECTOR2I& aPoint ) const
 {
-    GENERAL_COLLECTORS_GUIDE   guide = getCollectorsGuide();
-    GENERAL_COLLECTOR          collector;
+    GENERAL_COLLECTORS_GUIDE guide = getCollectorsGuide();
 
     // Since we're just double-checking, we want a considerably sloppier check than the initial
     // selection (for which most tools use 5 pixels).  So we increase this to an effective 20
     // pixels by artificially inflating the value of a pixel by 4X.
-    guide.SetOnePixelInIU( guide.OnePixelInIU() * 4 );
+    int   accuracy = 5 * guide.OnePixelInIU() * 4;
+    BOX2I area( aPoint - VECTOR2I( accuracy, accuracy ), VECTOR2I( 2 * accuracy, 2 * accuracy ) );
+    bool  found = false;
 
-    collector.Collect( board(), m_isFootprintEditor ? GENERAL_COLLECTOR::FootprintItems
-                                                    : GENERAL_COLLECTOR::AllBoardItems,
-                       (wxPoint) aPoint, guide );
+    auto hitSelected =
+            [&]( BOARD_ITEM* aItem ) -> bool
+            {
+                if( aItem->IsSelected() && aItem->HitTest( (wxPoint) aPoint, accuracy ) )
+                    found = true;
 
-    for( int i = collector.GetCount() - 1; i >= 0; --i )
+                return !found;
+            };
+
+    board()->QueryItems( area, LSET::AllLayersMask(), hitSelected );
+
+    // Markers and groups are not in the board's spatial index
+    for( PCB_MARKER* marker : board()->Markers() )
     {
-        BOARD_ITEM* item = collector[i];
+        if( !found )
+            hitSelected( marker );
+    }
 
-        if( item->IsSelected() && item->HitTest( (wxPoint) aPoint, 5 * guide.OnePixelInIU() ) )
-            return true;
+    for( PCB_GROUP* group : board()->Groups() )
+    {
+        if( !found )
+            hitSelected( group );
     }
 
-    return false;
+    if( m_isFootprintEditor )
+    {
+        for( FOOTPRINT* footprint : board()->Footprints() )
+        {
+            for( PCB_GROUP* group : footprint->Groups() )
+            {
+                if( !found )
+                    hitSelected( group );
+            }
+        }
+    }
+
+    return found;
 }
 
 
@@ -31,7 +31,6 @@
 #include <tool/tool_manager.h>
 #include <tools/pcb_actions.h>
 #include <tools/global_edit_tool.h>
-#include <drc/drc_rtree.h>
 #include <tracks_cleaner.h>
 
 TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit ) :
@@ -79,47 +78,32 @@ void TRACKS_CLEANER::removeShortingTrackSegments()
 
     std::set<BOARD_ITEM *> toRemove;
 
+    static const KICAD_T connectedTypes[] = { PCB_PAD_T, PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, EOT };
+
     for( PCB_TRACK* segment : m_brd->Tracks() )
     {
         // Assume that the user knows what they are doing
         if( segment->IsLocked() )
             continue;
 
-        for( PAD* testedPad : connectivity->GetConnectedPads( segment ) )
-        {
-            if( segment->GetNetCode() != testedPad->GetNetCode() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
-
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
-
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
-
-                toRemove.insert( segment );
-            }
-        }
+        connectivity->ForEachNeighbor( segment, connectedTypes,
+                [&]( BOARD_CONNECTED_ITEM* aTestedItem )
+                {
+                    if( segment->GetNetCode() == aTestedItem->GetNetCode() )
+                        return;
 
-        for( PCB_TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
-        {
-            if( segment->GetNetCode() != testedTrack->GetNetCode() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
+                    std::shared_ptr<CLEANUP_ITEM> item;
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+                    if( segment->Type() == PCB_VIA_T )
+                        item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
+                    else
+                        item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
 
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
+                    item->SetItems( segment );
+                    m_itemsList->push_back( item );
 
-                toRemove.insert( segment );
-            }
-        }
+                    toRemove.insert( segment );
+                } );
     }
 
     if( !m_dryRun )
@@ -142,7 +126,7 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( PCB_TRACK* aTrack, bool aTstStart
     if( !citem->Valid() )
         return false;
 
-    auto anchors = citem->Anchors();
+    const auto& anchors = citem->Anchors();
 
     VECTOR2I refpoint = aTstStart ? aTrack->GetStart() : aTrack->GetEnd();
 
@@ -270,13 +254,8 @@ void TRACKS_CLEANER::deleteTracksInPads()
 void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                               bool aDeleteDuplicateSegments, bool aMergeSegments )
 {
-    DRC_RTREE rtree;
-
     for( PCB_TRACK* track : m_brd->Tracks() )
-    {
         track->ClearFlags( IS_DELETED | SKIP_STRUCT );
-        rtree.Insert( track, track->GetLayer() );
-    }
 
     std::set<BOARD_ITEM*> toRemove;
 
@@ -292,17 +271,16 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
             if( via->GetStart() != via->GetEnd() )
                 via->SetEnd( via->GetStart() );
 
-            rtree.QueryColliding( via, via->GetLayer(), via->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_VIA_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
+            // A duplicate via covers this one's position
+            m_brd->QueryItems( BOX2I( via->GetPosition(), VECTOR2I( 0, 0 ) ), via->GetLayer(),
                     [&]( BOARD_ITEM* aItem ) -> bool
                     {
+                        if( aItem == via || aItem->Type() != PCB_VIA_T
+                                || aItem->HasFlag( SKIP_STRUCT ) || aItem->HasFlag( IS_DELETED ) )
+                        {
+                            return true;
+                        }
+
                         PCB_VIA* other = static_cast<PCB_VIA*>( aItem );
 
                         if( via->GetPosition() == other->GetPosition()
@@ -356,17 +334,16 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
 
         if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T )
         {
-            rtree.QueryColliding( track, track->GetLayer(), track->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_TRACE_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
+            // A duplicate segment covers this one's start point
+            m_brd->QueryItems( BOX2I( track->GetStart(), VECTOR2I( 0, 0 ) ), track->GetLayer(),
                     [&]( BOARD_ITEM* aItem ) -> bool
                     {
+                        if( aItem == track || aItem->Type() != PCB_TRACE_T
+                                || aItem->HasFlag( SKIP_STRUCT ) || aItem->HasFlag( IS_DELETED ) )
+                        {
+                            return true;
+                        }
+
                         PCB_TRACK* other = static_cast<PCB_TRACK*>( aItem );
 
                         if( track->IsPointOnEnds( other->GetStart() )
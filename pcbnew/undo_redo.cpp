@@ -35,6 +35,7 @@ using namespace std::placeholders;
 #include <pcb_target.h>
 #include <footprint.h>
 #include <pad.h>
+#include <zone.h>
 #include <pcb_dimension.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
@@ -575,6 +576,70 @@ void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aIt
 }
 
 
+size_t PCB_BASE_EDIT_FRAME::EstimateUndoCommandSize( const PICKED_ITEMS_LIST& aCommand ) const
+{
+    const size_t itemCost = 512;
+    size_t       size = sizeof( PICKED_ITEMS_LIST ) + aCommand.GetCount() * sizeof( ITEM_PICKER );
+
+    std::function<size_t( const EDA_ITEM* )> itemSize =
+            [&]( const EDA_ITEM* aItem ) -> size_t
+            {
+                switch( aItem->Type() )
+                {
+                case PCB_FOOTPRINT_T:
+                {
+                    const FOOTPRINT* fp = static_cast<const FOOTPRINT*>( aItem );
+                    size_t           fpSize = itemCost;
+
+                    for( const PAD* pad : fp->Pads() )
+                        fpSize += itemSize( pad );
+
+                    for( const BOARD_ITEM* item : fp->GraphicalItems() )
+                        fpSize += itemSize( item );
+
+                    for( const FP_ZONE* zone : fp->Zones() )
+                        fpSize += itemSize( zone );
+
+                    return fpSize + 2 * itemCost;   // reference and value texts
+                }
+
+                case PCB_ZONE_T:
+                case PCB_FP_ZONE_T:
+                {
+                    const ZONE* zone = static_cast<const ZONE*>( aItem );
+                    size_t      points = zone->Outline()->FullPointCount();
+
+                    for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                    {
+                        if( zone->HasFilledPolysForLayer( layer ) )
+                            points += zone->GetFilledPolysList( layer ).FullPointCount();
+                    }
+
+                    return itemCost + points * sizeof( VECTOR2I );
+                }
+
+                default:
+                    return itemCost;
+                }
+            };
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ++ii )
+    {
+        if( const EDA_ITEM* link = aCommand.GetPickedItemLink( ii ) )
+            size += itemSize( link );
+
+        // The command owns deleted items until it is discarded
+        if( aCommand.GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+        {
+            if( const EDA_ITEM* item = aCommand.GetPickedItem( ii ) )
+                size += itemSize( item );
+        }
+    }
+
+    return size;
+}
+
+
 void PCB_BASE_EDIT_FRAME::RollbackFromUndo()
 {
     PICKED_ITEMS_LIST* undo = PopCommandFromUndoList();
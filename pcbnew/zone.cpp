@@ -43,6 +43,7 @@
 
 ZONE::ZONE( BOARD_ITEM_CONTAINER* aParent, bool aInFP ) :
         BOARD_CONNECTED_ITEM( aParent, aInFP ? PCB_FP_ZONE_T : PCB_ZONE_T ),
+        m_bboxCacheTimeStamp( 0 ),
         m_area( 0.0 )
 {
     m_CornerSelection = nullptr;                // no corner is selected
@@ -85,7 +86,8 @@ ZONE::ZONE( BOARD_ITEM_CONTAINER* aParent, bool aInFP ) :
 ZONE::ZONE( const ZONE& aZone )
         : BOARD_CONNECTED_ITEM( aZone ),
         m_Poly( nullptr ),
-        m_CornerSelection( nullptr )
+        m_CornerSelection( nullptr ),
+        m_bboxCacheTimeStamp( 0 )
 {
     InitDataFromSrcInCopyCtor( aZone );
 }
@@ -121,6 +123,7 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     // Replace the outlines for aZone outlines.
     delete m_Poly;
     m_Poly = new SHAPE_POLY_SET( *aZone.m_Poly );
+    m_bboxCacheTimeStamp = 0;
 
     m_cornerSmoothingType     = aZone.m_cornerSmoothingType;
     m_cornerRadius            = aZone.m_cornerRadius;
@@ -176,7 +179,7 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
 
     SetLocalFlags( aZone.GetLocalFlags() );
 
-    m_netinfo                 = aZone.m_netinfo;
+    SetNet( aZone.m_netinfo );
 
     m_hv45                    = aZone.m_hv45;
     m_area                    = aZone.m_area;
@@ -333,6 +336,39 @@ const EDA_RECT ZONE::GetBoundingBox() const
 }
 
 
+const EDA_RECT ZONE::GetCachedBoundingBox() const
+{
+    const BOARD* board = GetBoard();
+
+    if( !board )
+        return GetBoundingBox();
+
+    if( m_bboxCacheTimeStamp < board->GetTimeStamp() )
+    {
+        std::lock_guard<std::mutex> lock( m_bboxCacheLock );
+
+        // If we had to wait for the lock then someone else probably just rebuilt the cache
+        if( m_bboxCacheTimeStamp < board->GetTimeStamp() )
+        {
+            m_bboxCache = GetBoundingBox();
+            m_bboxCacheTimeStamp = board->GetTimeStamp();
+        }
+    }
+
+    return m_bboxCache;
+}
+
+
+void ZONE::CacheBoundingBox()
+{
+    std::lock_guard<std::mutex> lock( m_bboxCacheLock );
+    const BOARD*                board = GetBoard();
+
+    m_bboxCache = GetBoundingBox();
+    m_bboxCacheTimeStamp = board ? board->GetTimeStamp() : 0;
+}
+
+
 int ZONE::GetThermalReliefGap( PAD* aPad, wxString* aSource ) const
 {
     if( aPad->GetEffectiveThermalGap() == 0 )
@@ -676,6 +712,7 @@ void ZONE::Move( const wxPoint& offset )
 {
     /* move outlines */
     m_Poly->Move( offset );
+    m_bboxCacheTimeStamp = 0;
 
     HatchBorder();
 
@@ -701,6 +738,7 @@ void ZONE::MoveEdge( const wxPoint& offset, int aEdge )
     {
         m_Poly->SetVertex( aEdge, m_Poly->CVertex( aEdge ) + VECTOR2I( offset ) );
         m_Poly->SetVertex( next_corner, m_Poly->CVertex( next_corner ) + VECTOR2I( offset ) );
+        m_bboxCacheTimeStamp = 0;
         HatchBorder();
 
         SetNeedRefill( true );
@@ -713,6 +751,7 @@ void ZONE::Rotate( const wxPoint& aCentre, double aAngle )
     aAngle = -DECIDEG2RAD( aAngle );
 
     m_Poly->Rotate( aAngle, VECTOR2I( aCentre ) );
+    m_bboxCacheTimeStamp = 0;
     HatchBorder();
 
     /* rotate filled areas: */
@@ -750,6 +789,7 @@ void ZONE::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 {
     // ZONEs mirror about the x-axis (why?!?)
     m_Poly->Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
+    m_bboxCacheTimeStamp = 0;
 
     HatchBorder();
 
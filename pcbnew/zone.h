@@ -26,6 +26,7 @@
 #define ZONE_H
 
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <gr_basic.h>
@@ -140,10 +141,17 @@ public:
     const EDA_RECT GetBoundingBox() const override;
 
     /**
-     * ONLY TO BE USED BY CLIENTS WHICH SET UP THE CACHE!
+     * Return the bounding box, cached until the board's timestamp changes or the zone is moved.
+     *
+     * The cache is rebuilt on demand and may be requested from several threads at once.  Zones
+     * which don't belong to a board aren't cached.
+     */
+    const EDA_RECT GetCachedBoundingBox() const;
+
+    /**
+     * Force an update of the cached bounding box.
      */
-    const EDA_RECT GetCachedBoundingBox() const { return m_bboxCache; }
-    void CacheBoundingBox() { m_bboxCache = GetBoundingBox(); }
+    void CacheBoundingBox();
 
     /**
      * Return any local clearances set in the "classic" (ie: pre-rule) system.  These are
@@ -917,7 +925,9 @@ protected:
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> m_RawPolysList;
 
     /// Temp variables used while filling
-    EDA_RECT                               m_bboxCache;
+    mutable EDA_RECT                       m_bboxCache;
+    mutable std::atomic<int>               m_bboxCacheTimeStamp;
+    mutable std::mutex                     m_bboxCacheLock;
     std::map<PCB_LAYER_ID, bool>           m_fillFlags;
 
     /// A hash value used in zone filling calculations to see if the filled areas are up to date
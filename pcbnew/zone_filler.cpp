@@ -45,6 +45,7 @@
 #include <confirm.h>
 #include <convert_to_biu.h>
 #include <math/util.h>      // for KiROUND
+#include <wx/log.h>
 #include "zone_filler.h"
 
 static const double s_RoundPadThermalSpokeAngle = 450;      // in deci-degrees
@@ -82,10 +83,6 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
-    // Rebuild just in case. This really needs to be reliable.
-    connectivity->Clear();
-    connectivity->Build( m_board, m_progressReporter );
-
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
 
     m_worstClearance = bds.GetBiggestClearanceValue();
@@ -102,35 +99,21 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
     m_boardOutline.RemoveAllContours();
     m_brdOutlinesValid = m_board->GetBoardPolygonOutlines( m_boardOutline );
 
-    // Update and cache zone bounding boxes and pad effective shapes so that we don't have to
-    // make them thread-safe.
+    // Zone bounding boxes, pad effective shapes and footprint courtyards (which rules may
+    // depend on through insideCourtyard() and similar expressions) are built on demand by the
+    // fill threads.  Bump the timestamp so none built before an uncommitted change is reused.
+    m_board->IncrementTimeStamp();
+
     for( ZONE* zone : m_board->Zones() )
-    {
-        zone->CacheBoundingBox();
         m_worstClearance = std::max( m_worstClearance, zone->GetLocalClearance() );
-    }
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
         for( PAD* pad : footprint->Pads() )
-        {
-            if( pad->IsDirty() )
-            {
-                pad->BuildEffectiveShapes( UNDEFINED_LAYER );
-                pad->BuildEffectivePolygon();
-            }
-
             m_worstClearance = std::max( m_worstClearance, pad->GetLocalClearance() );
-        }
 
         for( ZONE* zone : footprint->Zones() )
-        {
-            zone->CacheBoundingBox();
             m_worstClearance = std::max( m_worstClearance, zone->GetLocalClearance() );
-        }
-
-        // Rules may depend on insideCourtyard() or other expressions
-        footprint->BuildPolyCourtyards();
     }
 
     // Sort by priority to reduce deferrals waiting on higher priority zones.
@@ -303,10 +286,23 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         m_progressReporter->KeepRefreshing();
     }
 
+    // FindIsolatedCopperIslands() re-inserts the filled zones.  The rest of the connectivity is
+    // kept up to date by commits, unless something (a script, typically) changed the board
+    // without one.
+    if( !connectivity->MatchesBoard( m_board ) )
+    {
+        connectivity->Clear();
+        connectivity->Build( m_board, m_progressReporter );
+    }
+
     connectivity->SetProgressReporter( m_progressReporter );
     connectivity->FindIsolatedCopperIslands( islandsList );
     connectivity->SetProgressReporter( nullptr );
 
+    // To enable add "ZoneFillVerifyConnectivity=1" to kicad_advanced settings file.
+    if( ADVANCED_CFG::GetCfg().m_ZoneFillVerifyConnectivity )
+        verifyIsolatedIslands( islandsList );
+
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
@@ -495,6 +491,39 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 }
 
 
+void ZONE_FILLER::verifyIsolatedIslands( const std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aIslands )
+{
+    CONNECTIVITY_DATA                         reference;
+    std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> referenceIslands;
+
+    reference.Build( m_board );
+
+    for( const CN_ZONE_ISOLATED_ISLAND_LIST& zone : aIslands )
+        referenceIslands.emplace_back( zone.m_zone );
+
+    reference.FindIsolatedCopperIslands( referenceIslands );
+
+    for( size_t ii = 0; ii < aIslands.size(); ++ii )
+    {
+        std::map<PCB_LAYER_ID, std::vector<int>> found = aIslands[ii].m_islands;
+        std::map<PCB_LAYER_ID, std::vector<int>> expected = referenceIslands[ii].m_islands;
+
+        for( auto& layerIslands : found )
+            std::sort( layerIslands.second.begin(), layerIslands.second.end() );
+
+        for( auto& layerIslands : expected )
+            std::sort( layerIslands.second.begin(), layerIslands.second.end() );
+
+        if( found != expected )
+        {
+            wxLogWarning( wxT( "Zone %s: incremental connectivity found different isolated islands "
+                               "than a full rebuild." ),
+                          aIslands[ii].m_zone->GetSelectMenuText( EDA_UNITS::MILLIMETRES ) );
+        }
+    }
+}
+
+
 /**
  * Return true if the given pad has a thermal connection with the given zone.
  */
@@ -728,21 +757,36 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                 }
             };
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( checkForCancel( m_progressReporter ) )
-                return;
+    BOX2I zoneArea( zone_boundingbox.GetOrigin(), zone_boundingbox.GetSize() );
+    bool  cancelled = false;
 
-            if( pad->GetNetCode() != aZone->GetNetCode()
-                    || pad->GetNetCode() <= 0
-                    || aZone->GetPadConnection( pad ) == ZONE_CONNECTION::NONE )
+    // Pads are looked up on every layer: a hole goes through the layers its pad is not on
+    m_board->QueryItems( zoneArea, LSET::AllLayersMask(),
+            [&]( BOARD_ITEM* aItem ) -> bool
             {
-                knockoutPadClearance( pad );
-            }
-        }
-    }
+                if( aItem->Type() != PCB_PAD_T )
+                    return true;
+
+                if( checkForCancel( m_progressReporter ) )
+                {
+                    cancelled = true;
+                    return false;
+                }
+
+                PAD* pad = static_cast<PAD*>( aItem );
+
+                if( pad->GetNetCode() != aZone->GetNetCode()
+                        || pad->GetNetCode() <= 0
+                        || aZone->GetPadConnection( pad ) == ZONE_CONNECTION::NONE )
+                {
+                    knockoutPadClearance( pad );
+                }
+
+                return true;
+            } );
+
+    if( cancelled )
+        return;
 
     // Add non-connected track clearances
     //
@@ -800,19 +844,32 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                 }
             };
 
-    for( PCB_TRACK* track : m_board->Tracks() )
-    {
-        if( !track->IsOnLayer( aLayer ) )
-            continue;
+    m_board->QueryItems( zoneArea, aLayer,
+            [&]( BOARD_ITEM* aItem ) -> bool
+            {
+                if( aItem->Type() != PCB_TRACE_T && aItem->Type() != PCB_ARC_T
+                        && aItem->Type() != PCB_VIA_T )
+                {
+                    return true;
+                }
 
-        if( track->GetNetCode() == aZone->GetNetCode()  && ( aZone->GetNetCode() != 0) )
-            continue;
+                PCB_TRACK* track = static_cast<PCB_TRACK*>( aItem );
 
-        if( checkForCancel( m_progressReporter ) )
-            return;
+                if( track->GetNetCode() == aZone->GetNetCode()  && ( aZone->GetNetCode() != 0) )
+                    return true;
 
-        knockoutTrackClearance( track );
-    }
+                if( checkForCancel( m_progressReporter ) )
+                {
+                    cancelled = true;
+                    return false;
+                }
+
+                knockoutTrackClearance( track );
+                return true;
+            } );
+
+    if( cancelled )
+        return;
 
     // Add graphic item clearances.  They are by definition unconnected, and have no clearance
     // definitions of their own.
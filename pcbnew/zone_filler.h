@@ -34,6 +34,7 @@ class BOARD;
 class COMMIT;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
+struct CN_ZONE_ISOLATED_ISLAND_LIST;
 
 
 class ZONE_FILLER
@@ -49,6 +50,9 @@ public:
      * a lock on the connectivity data before calling Fill to prevent access to stale data by other
      * coroutines (for example, ratsnest redraw).  This will generally be required if a UI-based
      * progress reporter has been installed.
+     *
+     * The board connectivity must be up to date on entry (as maintained by commits); only the
+     * filled zones are re-inserted into it.
      */
     bool Fill( std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
@@ -120,6 +124,12 @@ private:
     bool addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
                                  SHAPE_POLY_SET& aRawPolys );
 
+    /**
+     * Debug check: compares the islands found with the incrementally updated connectivity
+     * against those found with connectivity rebuilt from scratch, and reports any difference.
+     */
+    void verifyIsolatedIslands( const std::vector<CN_ZONE_ISOLATED_ISLAND_LIST>& aIslands );
+
     BOARD*                m_board;
     SHAPE_POLY_SET        m_boardOutline;       // the board outlines, if exists
     bool                  m_brdOutlinesValid;   // true if m_boardOutline is well-formed
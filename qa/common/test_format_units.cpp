@@ -76,4 +76,46 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
 }
 
 
+/**
+ * Check formatting of values smaller than the display precision, where trailing zeros
+ * must still be stripped
+ */
+BOOST_AUTO_TEST_CASE( SmallUnitFormat )
+{
+    LOCALE_IO toggle;
+
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 0 ), "0" );
+
+#ifdef EESCHEMA
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 1 ), "0.0001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( -10 ), "-0.001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 10000 ), "1" );
+#elif GERBVIEW
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 1 ), "0.00001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( -10 ), "-0.0001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 100000 ), "1" );
+#elif PCBNEW
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 1 ), "0.000001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( -10 ), "-0.00001" );
+    BOOST_CHECK_EQUAL( FormatInternalUnits( 1000000 ), "1" );
+#endif
+}
+
+
+/**
+ * Check formatting of angles in tenths of a degree
+ */
+BOOST_AUTO_TEST_CASE( AngleFormat )
+{
+    LOCALE_IO toggle;
+
+    BOOST_CHECK_EQUAL( FormatAngle( 0.0 ), "0" );
+    BOOST_CHECK_EQUAL( FormatAngle( -0.0 ), "-0" );
+    BOOST_CHECK_EQUAL( FormatAngle( 900.0 ), "90" );
+    BOOST_CHECK_EQUAL( FormatAngle( -1.0 ), "-0.1" );
+    BOOST_CHECK_EQUAL( FormatAngle( 3599.0 ), "359.9" );
+    BOOST_CHECK_EQUAL( FormatAngle( 12.5 ), "1.25" );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <interned_string.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( InternedString )
+
+
+/**
+ * Equal values share one pool entry, different values don't
+ */
+BOOST_AUTO_TEST_CASE( SharedStorage )
+{
+    INTERNED_STRING a( wxT( "GND" ) );
+    INTERNED_STRING b( wxString( "GN" ) + wxT( "D" ) );
+    INTERNED_STRING c( wxT( "VCC" ) );
+
+    BOOST_CHECK( a == b );
+    BOOST_CHECK( &a.Get() == &b.Get() );
+    BOOST_CHECK( a != c );
+    BOOST_CHECK( a.Get() == wxT( "GND" ) );
+}
+
+
+/**
+ * Default-constructed and empty strings are the same entry
+ */
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    INTERNED_STRING a;
+    INTERNED_STRING b( wxEmptyString );
+
+    BOOST_CHECK( a.IsEmpty() );
+    BOOST_CHECK( a == b );
+
+    b = wxT( "1" );
+    BOOST_CHECK( !b.IsEmpty() );
+    BOOST_CHECK( a != b );
+
+    b = wxString();
+    BOOST_CHECK( a == b );
+}
+
+
+/**
+ * Assignment re-points the string and leaves other copies unchanged
+ */
+BOOST_AUTO_TEST_CASE( Assignment )
+{
+    INTERNED_STRING a( wxT( "A1" ) );
+    INTERNED_STRING b = a;
+
+    b = wxT( "B2" );
+
+    BOOST_CHECK( a.Get() == wxT( "A1" ) );
+    BOOST_CHECK( b.Get() == wxT( "B2" ) );
+
+    const wxString& ref = b;
+    BOOST_CHECK( &ref == &b.Get() );
+}
+
+
+/**
+ * Strings keep their value when the other users of their entry go away, and a value is
+ * interned again once all of its users are gone
+ */
+BOOST_AUTO_TEST_CASE( Release )
+{
+    std::unique_ptr<INTERNED_STRING> first = std::make_unique<INTERNED_STRING>( wxT( "R10" ) );
+    INTERNED_STRING                  copy = *first;
+
+    first.reset();
+
+    BOOST_CHECK( copy.Get() == wxT( "R10" ) );
+
+    INTERNED_STRING moved( std::move( copy ) );
+    moved = wxString();
+
+    BOOST_CHECK( moved.IsEmpty() );
+    BOOST_CHECK( moved.Get().IsEmpty() );
+
+    INTERNED_STRING again( wxT( "R10" ) );
+
+    BOOST_CHECK( again.Get() == wxT( "R10" ) );
+    BOOST_CHECK( again == INTERNED_STRING( wxString( "R1" ) + wxT( "0" ) ) );
+}
+
+
+/**
+ * UTF-8 strings have a pool of their own
+ */
+BOOST_AUTO_TEST_CASE( Utf8 )
+{
+    INTERNED_UTF8 a( UTF8( "Device" ) );
+    INTERNED_UTF8 b( UTF8( std::string( "Dev" ) + "ice" ) );
+    INTERNED_UTF8 empty( UTF8( "" ) );
+
+    BOOST_CHECK( a == b );
+    BOOST_CHECK( &a.Get() == &b.Get() );
+    BOOST_CHECK( a.Get() == "Device" );
+    BOOST_CHECK( empty.IsEmpty() );
+    BOOST_CHECK( empty == INTERNED_UTF8() );
+}
+
+
+/**
+ * Threads interning and dropping the same values end up with consistent strings
+ */
+BOOST_AUTO_TEST_CASE( Threads )
+{
+    const int                threadCount = 8;
+    std::vector<std::thread> threads;
+    std::vector<char>        ok( threadCount, 1 );  // Not vector<bool>: written concurrently
+
+    for( int t = 0; t < threadCount; ++t )
+    {
+        threads.emplace_back(
+                [t, &ok]()
+                {
+                    for( int ii = 0; ii < 2000; ++ii )
+                    {
+                        wxString        value = wxString::Format( wxT( "%d" ), ii % 50 );
+                        INTERNED_STRING a( value );
+                        INTERNED_STRING b = a;
+
+                        a = wxString::Format( wxT( "%d" ), ii % 7 );
+
+                        if( b.Get() != value || b != INTERNED_STRING( value ) )
+                            ok[t] = 0;
+                    }
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( int t = 0; t < threadCount; ++t )
+        BOOST_CHECK( ok[t] );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <locale_io.h>
+
+#include <clocale>
+#include <cstring>
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( LocaleIo )
+
+
+/**
+ * Parse C-locale numbers, with and without trailing text
+ */
+BOOST_AUTO_TEST_CASE( StrToDouble )
+{
+    const char* text = "-12.375)";
+    char*       end = nullptr;
+
+    BOOST_CHECK_EQUAL( StrToDoubleC( text, &end ), -12.375 );
+    BOOST_CHECK_EQUAL( *end, ')' );
+
+    BOOST_CHECK_EQUAL( StrToDoubleC( "1e-3" ), 0.001 );
+
+    const char* bad = "abc";
+
+    StrToDoubleC( bad, &end );
+    BOOST_CHECK( end == bad );
+}
+
+
+/**
+ * Output matches snprintf() in the C locale, including the length of truncated output
+ */
+BOOST_AUTO_TEST_CASE( Snprintf )
+{
+    char buf[50];
+
+    BOOST_CHECK_EQUAL( SnprintfC( buf, sizeof( buf ), "%.10g", 0.1 ), 3 );
+    BOOST_CHECK_EQUAL( std::string( buf ), "0.1" );
+
+    SnprintfC( buf, sizeof( buf ), "%.10f %d", -2.5, 7 );
+    BOOST_CHECK_EQUAL( std::string( buf ), "-2.5000000000 7" );
+
+    char small[4];
+
+    BOOST_CHECK_EQUAL( SnprintfC( small, sizeof( small ), "%.3f", 3.14159 ), 5 );
+    BOOST_CHECK_EQUAL( std::string( small ), "3.1" );
+}
+
+
+/**
+ * The result doesn't depend on the process locale, when one with a decimal comma is available
+ */
+BOOST_AUTO_TEST_CASE( CommaLocale )
+{
+    std::string previous = setlocale( LC_NUMERIC, nullptr );
+
+    if( !setlocale( LC_NUMERIC, "de_DE.UTF-8" ) && !setlocale( LC_NUMERIC, "fr_FR.UTF-8" ) )
+        return;
+
+    char buf[50];
+    SnprintfC( buf, sizeof( buf ), "%.10g", 1.25 );
+
+    BOOST_CHECK_EQUAL( std::string( buf ), "1.25" );
+    BOOST_CHECK_EQUAL( StrToDoubleC( "1.25" ), 1.25 );
+
+    setlocale( LC_NUMERIC, previous.c_str() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <richio.h>
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <string>
+
+
+BOOST_AUTO_TEST_SUITE( RichIo )
+
+
+/**
+ * Text written compressed reads back line by line, including lines longer than a block
+ */
+BOOST_AUTO_TEST_CASE( GzipRoundTrip )
+{
+    wxString tempName = wxFileName::CreateTempFileName( wxT( "qa_richio" ) );
+    wxString fileName = tempName + wxT( ".gz" );
+    std::string longLine( 300 * 1024, 'x' );
+
+    {
+        GZIP_FILE_OUTPUTFORMATTER formatter( fileName );
+
+        formatter.Print( 0, "(kicad_pcb (version %d)\n", 20211014 );
+        formatter.Print( 1, "(net 0 \"\")\n" );
+        formatter.Print( 0, "%s\n", longLine.c_str() );
+        formatter.Print( 0, ")" );
+    }
+
+    BOOST_CHECK( GZIP_FILE_OUTPUTFORMATTER::IsGzipFileName( fileName ) );
+    BOOST_CHECK( GZIP_FILE_LINE_READER::IsGzipFile( fileName ) );
+
+    GZIP_FILE_LINE_READER reader( fileName );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        BOOST_CHECK_EQUAL( std::string( reader.ReadLine() ), "(kicad_pcb (version 20211014)\n" );
+        BOOST_CHECK_EQUAL( std::string( reader.ReadLine() ), "  (net 0 \"\")\n" );
+        BOOST_CHECK_EQUAL( std::string( reader.ReadLine() ), longLine + "\n" );
+        BOOST_CHECK_EQUAL( std::string( reader.ReadLine() ), ")" );
+        BOOST_CHECK_EQUAL( reader.LineNumber(), 4 );
+        BOOST_CHECK( reader.ReadLine() == nullptr );
+
+        reader.Rewind();
+    }
+
+    wxRemoveFile( fileName );
+    wxRemoveFile( tempName );
+}
+
+
+/**
+ * Plain text files are not taken for compressed ones
+ */
+BOOST_AUTO_TEST_CASE( GzipDetection )
+{
+    wxString fileName = wxFileName::CreateTempFileName( wxT( "qa_richio" ) );
+
+    {
+        FILE_OUTPUTFORMATTER formatter( fileName );
+
+        formatter.Print( 0, "(kicad_sch)\n" );
+    }
+
+    BOOST_CHECK( !GZIP_FILE_OUTPUTFORMATTER::IsGzipFileName( fileName ) );
+    BOOST_CHECK( !GZIP_FILE_LINE_READER::IsGzipFile( fileName ) );
+    BOOST_CHECK( !GZIP_FILE_LINE_READER::IsGzipFile( fileName + wxT( ".missing" ) ) );
+
+    wxRemoveFile( fileName );
+}
+
+
+#ifdef __linux__
+/**
+ * Buffered output which can't be written is reported by Finish()
+ */
+BOOST_AUTO_TEST_CASE( FinishReportsWriteErrors )
+{
+    FILE_OUTPUTFORMATTER formatter( wxT( "/dev/full" ), wxT( "wb" ) );
+
+    // Small enough to stay in the stdio buffer until the file is flushed
+    BOOST_CHECK_NO_THROW( formatter.Print( 0, "(kicad_pcb)\n" ) );
+    BOOST_CHECK_THROW( formatter.Finish(), IO_ERROR );
+}
+#endif
+
+
+BOOST_AUTO_TEST_SUITE_END()
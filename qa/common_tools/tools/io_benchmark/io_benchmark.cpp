@@ -22,6 +22,7 @@
  */
 
 #include <wx/wx.h>
+#include <dsnlexer.h>
 #include <richio.h>
 
 #include <chrono>
@@ -156,6 +157,28 @@ static void bench_line_reader_reuse( const wxFileName& aFile, int aReps, BENCH_R
 }
 
 
+/**
+ * Benchmark tokenizing the file with a DSNLEXER on a given LINE_READER implementation,
+ * which is what the s-expression file loaders do.
+ * The LINE_READER is recreated for each cycle.
+ */
+template<typename LR>
+static void bench_lexer( const wxFileName& aFile, int aReps, BENCH_REPORT& report )
+{
+    for( int i = 0; i < aReps; ++i)
+    {
+        LR       fstr( aFile.GetFullPath() );
+        DSNLEXER lexer( nullptr, 0, &fstr );
+
+        for( int tok = lexer.NextTok(); tok != DSN_EOF; tok = lexer.NextTok() )
+            report.charAcc += (unsigned char) lexer.CurText()[0];
+
+        // The line number is incremented when reading the EOF too
+        report.linesRead += fstr.LineNumber() - 1;
+    }
+}
+
+
 /**
  * Benchmark using STRING_LINE_READER on string data read into memory from a file
  * using std::ifstream, but read the data fresh from the file each time
@@ -314,6 +337,10 @@ static std::vector<BENCHMARK> benchmarkList =
     { 'R', bench_line_reader_reuse<FILE_LINE_READER>, "RichIO FILE_L_R, reused" },
     { 'n', bench_line_reader<IFSTREAM_LINE_READER>, "std::ifstream L_R" },
     { 'N', bench_line_reader_reuse<IFSTREAM_LINE_READER>, "std::ifstream L_R, reused" },
+    { 'm', bench_line_reader<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_FILE_L_R" },
+    { 'M', bench_line_reader_reuse<MAPPED_FILE_LINE_READER>, "RichIO MAPPED_FILE_L_R, reused" },
+    { 'x', bench_lexer<FILE_LINE_READER>, "DSNLEXER on FILE_L_R" },
+    { 'X', bench_lexer<MAPPED_FILE_LINE_READER>, "DSNLEXER on MAPPED_FILE_L_R" },
     { 's', bench_string_lr, "RichIO STRING_L_R"},
     { 'S', bench_string_lr_reuse, "RichIO STRING_L_R, reused"},
     { 'w', bench_wxis<wxFileInputStream>, "wxFileIStream" },
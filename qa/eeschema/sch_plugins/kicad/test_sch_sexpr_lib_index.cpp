@@ -0,0 +1,304 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file test_sch_sexpr_lib_index.cpp
+ * Test the symbol library index which lets symbols be listed without being parsed.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <lib_symbol.h>
+#include <properties.h>
+#include <richio.h>
+#include <sch_plugins/kicad/sch_sexpr_parser.h>
+#include <sch_plugins/kicad/sch_sexpr_plugin.h>
+#include <symbol_info.h>
+#include <symbol_lib_table.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+
+/**
+ * A library with a power symbol, a multi-unit symbol and a symbol extending each of them.
+ */
+static const char* s_library =
+    "(kicad_symbol_lib (version 20211014) (generator kicad_symbol_editor)\n"
+    "  (symbol \"GND\" (power) (pin_names (offset 0)) (in_bom yes) (on_board yes)\n"
+    "    (property \"Reference\" \"#PWR\" (id 0) (at 0 -6.35 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (property \"Value\" \"GND\" (id 1) (at 0 -3.81 0)\n"
+    "      (effects (font (size 1.27 1.27))))\n"
+    "    (property \"ki_keywords\" \"power-flag\" (id 4) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (property \"ki_description\" \"Power symbol, ground\" (id 5) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (symbol \"GND_0_1\"\n"
+    "      (polyline (pts (xy 0 0) (xy 0 -1.27)) (stroke (width 0)) (fill (type none))))\n"
+    "    (symbol \"GND_1_1\"\n"
+    "      (pin power_in line (at 0 0 270) (length 0) hide\n"
+    "        (name \"GND\" (effects (font (size 1.27 1.27))))\n"
+    "        (number \"1\" (effects (font (size 1.27 1.27)))))))\n"
+    "  (symbol \"GNDA\" (extends \"GND\")\n"
+    "    (property \"Reference\" \"#PWR\" (id 0) (at 0 -6.35 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (property \"Value\" \"GNDA\" (id 1) (at 0 -3.81 0)\n"
+    "      (effects (font (size 1.27 1.27)))))\n"
+    "  (symbol \"OPAMP_Dual\" (in_bom yes) (on_board yes)\n"
+    "    (property \"Reference\" \"U\" (id 0) (at 0 5.08 0)\n"
+    "      (effects (font (size 1.27 1.27))))\n"
+    "    (property \"Value\" \"OPAMP_Dual\" (id 1) (at 0 -5.08 0)\n"
+    "      (effects (font (size 1.27 1.27))))\n"
+    "    (property \"Footprint\" \"Package_SO:SOIC-8\" (id 2) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (property \"ki_keywords\" \"dual opamp\" (id 4) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (property \"ki_description\" \"Dual operational amplifier\" (id 5) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide))\n"
+    "    (symbol \"OPAMP_Dual_1_1\"\n"
+    "      (pin input line (at -7.62 2.54 0) (length 2.54)\n"
+    "        (name \"+\" (effects (font (size 1.27 1.27))))\n"
+    "        (number \"3\" (effects (font (size 1.27 1.27))))))\n"
+    "    (symbol \"OPAMP_Dual_2_1\"\n"
+    "      (pin input line (at -7.62 2.54 0) (length 2.54)\n"
+    "        (name \"+\" (effects (font (size 1.27 1.27))))\n"
+    "        (number \"5\" (effects (font (size 1.27 1.27))))))\n"
+    "    (symbol \"OPAMP_Dual_3_1\"\n"
+    "      (pin power_in line (at -2.54 7.62 270) (length 3.81)\n"
+    "        (name \"V+\" (effects (font (size 1.27 1.27))))\n"
+    "        (number \"8\" (effects (font (size 1.27 1.27)))))))\n"
+    "  (symbol \"TL072\" (extends \"OPAMP_Dual\")\n"
+    "    (property \"Reference\" \"U\" (id 0) (at 0 5.08 0)\n"
+    "      (effects (font (size 1.27 1.27))))\n"
+    "    (property \"Value\" \"TL072\" (id 1) (at 0 -5.08 0)\n"
+    "      (effects (font (size 1.27 1.27))))\n"
+    "    (property \"ki_description\" \"Dual JFET operational amplifier\" (id 5) (at 0 0 0)\n"
+    "      (effects (font (size 1.27 1.27)) hide)))\n"
+    ")\n";
+
+
+class TEST_SCH_SEXPR_LIB_INDEX_FIXTURE
+{
+public:
+    TEST_SCH_SEXPR_LIB_INDEX_FIXTURE()
+    {
+        m_tempName = wxFileName::CreateTempFileName( wxT( "qa_symlib" ) );
+        m_libPath = m_tempName + wxT( ".kicad_sym" );
+
+        wxFFile file( m_libPath, wxT( "wb" ) );
+        file.Write( s_library, strlen( s_library ) );
+    }
+
+    ~TEST_SCH_SEXPR_LIB_INDEX_FIXTURE()
+    {
+        wxRemoveFile( m_libPath );
+        wxRemoveFile( m_tempName );
+    }
+
+    const SYMBOL_INFO* find( const std::vector<SYMBOL_INFO>& aList, const wxString& aName )
+    {
+        for( const SYMBOL_INFO& info : aList )
+        {
+            if( info.GetName() == aName )
+                return &info;
+        }
+
+        return nullptr;
+    }
+
+    wxString m_tempName;
+    wxString m_libPath;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchSexprLibIndex, TEST_SCH_SEXPR_LIB_INDEX_FIXTURE )
+
+
+/**
+ * Each listed range holds exactly its symbol, and the listed properties are those parsed
+ */
+BOOST_AUTO_TEST_CASE( IndexRanges )
+{
+    std::string                      data( s_library );
+    std::vector<LIB_SYMBOL_LOCATION> locations;
+    int                              version;
+
+    {
+        STRING_LINE_READER reader( data, m_libPath );
+        SCH_SEXPR_PARSER   parser( &reader );
+
+        version = parser.IndexLib( locations );
+    }
+
+    BOOST_CHECK_EQUAL( version, 20211014 );
+    BOOST_REQUIRE_EQUAL( locations.size(), 4 );
+
+    std::vector<size_t> lineStarts = { 0 };
+
+    for( size_t ii = 0; ii < data.size(); ++ii )
+    {
+        if( data[ii] == '\n' )
+            lineStarts.push_back( ii + 1 );
+    }
+
+    LIB_SYMBOL_MAP symbols;
+
+    for( const LIB_SYMBOL_LOCATION& location : locations )
+    {
+        BOOST_TEST_CONTEXT( "Symbol " << location.m_name )
+        {
+            size_t start = lineStarts[location.m_startLine - 1] + location.m_startOffset;
+            size_t end = lineStarts[location.m_endLine - 1] + location.m_endOffset;
+            std::string text = data.substr( start, end - start );
+
+            BOOST_CHECK_EQUAL( text.substr( 0, 9 ), "(symbol \"" );
+            BOOST_CHECK_EQUAL( text.back(), ')' );
+
+            STRING_LINE_READER reader( text, m_libPath );
+            SCH_SEXPR_PARSER   parser( &reader );
+
+            parser.NeedLEFT();
+            parser.NextTok();
+
+            LIB_SYMBOL* symbol = parser.ParseSymbol( symbols, version );
+
+            BOOST_REQUIRE( symbol );
+            symbols[symbol->GetName()] = symbol;
+
+            BOOST_CHECK_EQUAL( symbol->GetName(), location.m_name );
+            BOOST_CHECK_EQUAL( symbol->IsRoot(), location.m_parent.IsEmpty() );
+            BOOST_CHECK_EQUAL( symbol->GetFootprintField().GetText(), location.m_footprint );
+
+            if( symbol->IsRoot() )
+            {
+                BOOST_CHECK_EQUAL( symbol->IsPower(), location.m_power );
+                BOOST_CHECK_EQUAL( symbol->GetUnitCount(), location.m_unitCount );
+                BOOST_CHECK_EQUAL( symbol->GetDescription(), location.m_description );
+                BOOST_CHECK_EQUAL( symbol->GetKeyWords(), location.m_keywords );
+            }
+        }
+    }
+
+    BOOST_CHECK_EQUAL( locations[2].m_unitCount, 3 );
+    BOOST_CHECK_EQUAL( locations[3].m_parent, "OPAMP_Dual" );
+
+    // Derived symbols last, as they hold a link to the symbol they extend.
+    for( const wxString& name : { "GNDA", "TL072", "GND", "OPAMP_Dual" } )
+        delete symbols[name];
+}
+
+
+/**
+ * Derived symbols take the units, power flag and missing properties of the symbol they extend,
+ * both when listed and when parsed
+ */
+BOOST_AUTO_TEST_CASE( ExtendsResolution )
+{
+    SCH_SEXPR_PLUGIN         plugin;
+    std::vector<SYMBOL_INFO> listed;
+
+    plugin.EnumerateSymbolInfo( listed, m_libPath );
+
+    BOOST_REQUIRE_EQUAL( listed.size(), 4 );
+
+    const SYMBOL_INFO* tl072 = find( listed, "TL072" );
+    const SYMBOL_INFO* gnda = find( listed, "GNDA" );
+
+    BOOST_REQUIRE( tl072 && gnda );
+    BOOST_CHECK( !tl072->IsRoot() );
+    BOOST_CHECK_EQUAL( tl072->GetUnitCount(), 3 );
+    BOOST_CHECK_EQUAL( tl072->m_description, "Dual JFET operational amplifier" );
+    BOOST_CHECK_EQUAL( tl072->m_keywords, "dual opamp" );
+    BOOST_CHECK( !gnda->IsRoot() );
+    BOOST_CHECK( gnda->IsPower() );
+    BOOST_CHECK_EQUAL( gnda->m_description, "Power symbol, ground" );
+
+    // Loading the derived symbol alone parses the symbol it extends.
+    LIB_SYMBOL* symbol = plugin.LoadSymbol( m_libPath, "TL072" );
+
+    BOOST_REQUIRE( symbol );
+    BOOST_REQUIRE( symbol->IsAlias() );
+    BOOST_CHECK_EQUAL( symbol->GetParent().lock()->GetName(), "OPAMP_Dual" );
+    BOOST_CHECK_EQUAL( symbol->GetUnitCount(), 3 );
+
+    // Once every symbol is parsed, the same properties are listed from the symbols.
+    std::vector<LIB_SYMBOL*> symbols;
+
+    plugin.EnumerateSymbolLib( symbols, m_libPath );
+
+    BOOST_REQUIRE_EQUAL( symbols.size(), 4 );
+
+    std::vector<SYMBOL_INFO> parsed;
+
+    plugin.EnumerateSymbolInfo( parsed, m_libPath );
+
+    BOOST_REQUIRE_EQUAL( parsed.size(), listed.size() );
+
+    for( size_t ii = 0; ii < listed.size(); ++ii )
+    {
+        BOOST_TEST_CONTEXT( "Symbol " << listed[ii].GetName() )
+        {
+            BOOST_CHECK_EQUAL( parsed[ii].GetName(), listed[ii].GetName() );
+            BOOST_CHECK_EQUAL( parsed[ii].IsRoot(), listed[ii].IsRoot() );
+            BOOST_CHECK_EQUAL( parsed[ii].IsPower(), listed[ii].IsPower() );
+            BOOST_CHECK_EQUAL( parsed[ii].GetUnitCount(), listed[ii].GetUnitCount() );
+            BOOST_CHECK_EQUAL( parsed[ii].GetSearchText(), listed[ii].GetSearchText() );
+            BOOST_CHECK_EQUAL( parsed[ii].GetDescription(), listed[ii].GetDescription() );
+        }
+    }
+}
+
+
+/**
+ * The power symbol filter keeps derived symbols of power symbols, without parsing any symbol
+ */
+BOOST_AUTO_TEST_CASE( PowerFilter )
+{
+    SCH_SEXPR_PLUGIN plugin;
+    PROPERTIES       props;
+
+    props[ SYMBOL_LIB_TABLE::PropPowerSymsOnly ] = "";
+
+    std::vector<SYMBOL_INFO> listed;
+    wxArrayString            names;
+
+    plugin.EnumerateSymbolInfo( listed, m_libPath, &props );
+    plugin.EnumerateSymbolLib( names, m_libPath, &props );
+
+    BOOST_REQUIRE_EQUAL( listed.size(), 2 );
+    BOOST_CHECK_EQUAL( listed[0].GetName(), "GND" );
+    BOOST_CHECK_EQUAL( listed[1].GetName(), "GNDA" );
+
+    BOOST_REQUIRE_EQUAL( names.size(), 2 );
+    BOOST_CHECK_EQUAL( names[0], "GND" );
+    BOOST_CHECK_EQUAL( names[1], "GNDA" );
+
+    // Parsed symbols give the same answer.
+    std::vector<LIB_SYMBOL*> symbols;
+
+    plugin.EnumerateSymbolLib( symbols, m_libPath, &props );
+
+    BOOST_REQUIRE_EQUAL( symbols.size(), 2 );
+    BOOST_CHECK_EQUAL( symbols[0]->GetName(), "GND" );
+    BOOST_CHECK_EQUAL( symbols[1]->GetName(), "GNDA" );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include "eeschema_test_utils.h"
+
+#include <sch_plugins/kicad/sch_sexpr_plugin.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <schematic.h>
+#include <settings/settings_manager.h>
+#include <wildcards_and_files_ext.h>
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+
+/**
+ * The identity of a schematic item: its uuid, type and position.
+ */
+typedef std::tuple<wxString, KICAD_T, int, int> ITEM_KEY;
+
+
+class TEST_SCH_PARALLEL_LOAD_FIXTURE
+{
+public:
+    TEST_SCH_PARALLEL_LOAD_FIXTURE() :
+            m_serial( nullptr ),
+            m_parallel( nullptr ),
+            m_manager( true )
+    {
+    }
+
+    virtual ~TEST_SCH_PARALLEL_LOAD_FIXTURE()
+    {
+        m_serial.Reset();
+        m_parallel.Reset();
+    }
+
+    void loadSchematic( SCHEMATIC& aSchematic, const wxFileName& aFileName, bool aParallel );
+
+    /**
+     * Collect the items of every screen of \a aSchematic, keyed by the screen file name.
+     */
+    std::map<wxString, std::vector<ITEM_KEY>> collectItems( SCHEMATIC& aSchematic );
+
+    SCHEMATIC        m_serial;
+    SCHEMATIC        m_parallel;
+    SETTINGS_MANAGER m_manager;
+};
+
+
+void TEST_SCH_PARALLEL_LOAD_FIXTURE::loadSchematic( SCHEMATIC& aSchematic,
+                                                    const wxFileName& aFileName, bool aParallel )
+{
+    SCH_SEXPR_PLUGIN plugin;
+
+    plugin.SetParallelLoad( aParallel );
+
+    aSchematic.Reset();
+    aSchematic.CurrentSheet().clear();
+    aSchematic.SetProject( &m_manager.Prj() );
+    aSchematic.SetRoot( plugin.Load( aFileName.GetFullPath(), &aSchematic ) );
+
+    BOOST_REQUIRE( plugin.GetError().IsEmpty() );
+}
+
+
+std::map<wxString, std::vector<ITEM_KEY>>
+TEST_SCH_PARALLEL_LOAD_FIXTURE::collectItems( SCHEMATIC& aSchematic )
+{
+    std::map<wxString, std::vector<ITEM_KEY>> items;
+    SCH_SCREENS                               screens( aSchematic.Root() );
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+    {
+        wxFileName             fn( screen->GetFileName() );
+        std::vector<ITEM_KEY>& screenItems = items[ fn.GetFullName() ];
+
+        for( SCH_ITEM* item : screen->Items() )
+        {
+            wxPoint pos = item->GetPosition();
+
+            screenItems.emplace_back( item->m_Uuid.AsString(), item->Type(), pos.x, pos.y );
+        }
+
+        // The rtree doesn't promise an iteration order
+        std::sort( screenItems.begin(), screenItems.end() );
+    }
+
+    return items;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( SchParallelLoad, TEST_SCH_PARALLEL_LOAD_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( ParallelMatchesSerial )
+{
+    std::vector<wxString> tests = { "complex_hierarchy/complex_hierarchy",
+                                    "complex_hierarchy_shared/complex_hierarchy",
+                                    "group_bus_matching/group_bus_matching" };
+
+    for( const wxString& relPath : tests )
+    {
+        BOOST_TEST_CONTEXT( relPath )
+        {
+            wxFileName fn = KI_TEST::GetEeschemaTestDataDir();
+            fn.AppendDir( "netlists" );
+
+            wxString path = fn.GetFullPath() + relPath + wxT( "." )
+                            + KiCadSchematicFileExtension;
+
+            wxFileName pro( path );
+            pro.SetExt( ProjectFileExtension );
+
+            m_manager.LoadProject( pro.GetFullPath() );
+            m_manager.Prj().SetElem( PROJECT::ELEM_SCH_SYMBOL_LIBS, nullptr );
+
+            loadSchematic( m_serial, wxFileName( path ), false );
+            loadSchematic( m_parallel, wxFileName( path ), true );
+
+            std::map<wxString, std::vector<ITEM_KEY>> serialItems = collectItems( m_serial );
+            std::map<wxString, std::vector<ITEM_KEY>> parallelItems = collectItems( m_parallel );
+
+            BOOST_REQUIRE_EQUAL( serialItems.size(), parallelItems.size() );
+            BOOST_CHECK( serialItems.size() > 1 );
+
+            for( const std::pair<const wxString, std::vector<ITEM_KEY>>& screen : serialItems )
+            {
+                BOOST_TEST_CONTEXT( screen.first )
+                {
+                    BOOST_REQUIRE( parallelItems.count( screen.first ) );
+
+                    const std::vector<ITEM_KEY>& other = parallelItems[ screen.first ];
+
+                    BOOST_REQUIRE_EQUAL( screen.second.size(), other.size() );
+                    BOOST_CHECK( screen.second == other );
+                }
+            }
+
+            // Both loads must have built the same sheet hierarchy
+            BOOST_CHECK_EQUAL( m_serial.GetSheets().size(), m_parallel.GetSheets().size() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
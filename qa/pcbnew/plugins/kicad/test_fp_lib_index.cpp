@@ -0,0 +1,302 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <plugins/kicad/fp_lib_index.h>
+#include <plugins/kicad/kicad_plugin.h>
+
+#include <wx/datetime.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+/**
+ * A footprint library written from the footprints of a QA board, with no index yet.
+ */
+struct FP_LIB_INDEX_FIXTURE
+{
+    FP_LIB_INDEX_FIXTURE()
+    {
+        std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+                KI_TEST::GetPcbnewTestDataDir() + "complex_hierarchy.kicad_pcb" );
+
+        BOOST_REQUIRE( board );
+
+        m_tempFile = wxFileName::CreateTempFileName( wxT( "qa_fpindex" ) );
+        m_libPath = m_tempFile + wxT( ".pretty" );
+
+        wxArrayString names;
+
+        {
+            PCB_IO io;
+
+            io.FootprintLibCreate( m_libPath );
+
+            for( FOOTPRINT* footprint : board->Footprints() )
+                io.FootprintSave( m_libPath, footprint );
+
+            io.FootprintEnumerate( names, m_libPath, false );
+        }
+
+        wxRemoveFile( FP_LIB_INDEX::IndexFileName( m_libPath ) );
+
+        BOOST_REQUIRE( names.size() > 1 );
+
+        for( const wxString& name : names )
+        {
+            m_names.push_back( name );
+            m_paths.push_back( filePath( name ) );
+        }
+    }
+
+    ~FP_LIB_INDEX_FIXTURE()
+    {
+        wxRemoveFile( FP_LIB_INDEX::IndexFileName( m_libPath ) );
+        PCB_IO().FootprintLibDelete( m_libPath );
+        wxRemoveFile( m_tempFile );
+    }
+
+    wxString filePath( const wxString& aName ) const
+    {
+        return m_libPath + wxFileName::GetPathSeparator() + aName + wxT( ".kicad_mod" );
+    }
+
+    /**
+     * Index every footprint of the library with its properties, and save the index.
+     */
+    void writeIndex()
+    {
+        PCB_IO       io;
+        FP_LIB_INDEX index( m_libPath );
+
+        index.Sync( m_names, m_paths );
+
+        for( size_t ii = 0; ii < m_names.size(); ++ii )
+        {
+            const FOOTPRINT* footprint = io.GetEnumeratedFootprint( m_libPath, m_names[ii] );
+
+            BOOST_REQUIRE( footprint );
+            index.SetFootprint( m_names[ii], m_paths[ii], footprint );
+        }
+
+        BOOST_REQUIRE( index.Save() );
+    }
+
+    wxString              m_tempFile;
+    wxString              m_libPath;
+    std::vector<wxString> m_names;
+    std::vector<wxString> m_paths;
+};
+
+
+static std::string readFile( const wxString& aPath )
+{
+    wxFFile     file( aPath, wxT( "rb" ) );
+    std::string data( (size_t) file.Length(), '\0' );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    BOOST_REQUIRE( file.Read( &data[0], data.size() ) == data.size() );
+
+    return data;
+}
+
+
+static void writeFile( const wxString& aPath, const std::string& aData )
+{
+    wxFFile file( aPath, wxT( "wb" ) );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    BOOST_REQUIRE( file.Write( aData.data(), aData.size() ) );
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( FootprintLibIndex, FP_LIB_INDEX_FIXTURE )
+
+
+/**
+ * The index reads back the file, time, size and chooser properties it saved
+ */
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    writeIndex();
+
+    FP_LIB_INDEX loaded( m_libPath );
+    PCB_IO       io;
+
+    BOOST_REQUIRE( loaded.Load() );
+
+    for( size_t ii = 0; ii < m_names.size(); ++ii )
+    {
+        BOOST_TEST_CONTEXT( m_names[ii] )
+        {
+            const FP_LIB_INDEX::ENTRY* entry = loaded.Find( m_names[ii] );
+            const FOOTPRINT*           footprint = io.GetEnumeratedFootprint( m_libPath,
+                                                                              m_names[ii] );
+            wxFileName                 fn( m_paths[ii] );
+
+            BOOST_REQUIRE( entry && footprint );
+            BOOST_CHECK( entry->m_hasInfo );
+            BOOST_CHECK_EQUAL( entry->m_filePath, m_paths[ii] );
+            BOOST_CHECK_EQUAL( entry->m_size, (long long) fn.GetSize().GetValue() );
+            BOOST_CHECK_EQUAL( entry->m_modified, fn.GetModificationTime().GetTicks() );
+            BOOST_CHECK_EQUAL( entry->m_padCount,
+                               (int) footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ) );
+            BOOST_CHECK_EQUAL( entry->m_uniquePadCount,
+                               (int) footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH ) );
+            BOOST_CHECK_EQUAL( entry->m_keywords, footprint->GetKeywords() );
+            BOOST_CHECK_EQUAL( entry->m_doc, footprint->GetDescription() );
+        }
+    }
+
+    BOOST_CHECK( !loaded.Find( wxT( "no_such_footprint" ) ) );
+}
+
+
+/**
+ * The properties of a footprint are dropped when its file changes time or size, and kept for
+ * the files which did not change
+ */
+BOOST_AUTO_TEST_CASE( StaleEntries )
+{
+    writeIndex();
+
+    wxFileName resized( m_paths[0] );
+    wxFileName touched( m_paths[1] );
+    wxDateTime modified = touched.GetModificationTime();
+
+    writeFile( resized.GetFullPath(), readFile( resized.GetFullPath() ) + "\n" );
+
+    modified.Add( wxTimeSpan::Hours( 1 ) );
+    BOOST_REQUIRE( touched.SetTimes( nullptr, &modified, nullptr ) );
+
+    FP_LIB_INDEX index( m_libPath );
+
+    BOOST_REQUIRE( index.Load() );
+    index.Sync( m_names, m_paths );
+
+    for( size_t ii = 0; ii < m_names.size(); ++ii )
+    {
+        BOOST_TEST_CONTEXT( m_names[ii] )
+        {
+            const FP_LIB_INDEX::ENTRY* entry = index.Find( m_names[ii] );
+
+            BOOST_REQUIRE( entry );
+            BOOST_CHECK_EQUAL( entry->m_hasInfo, ii > 1 );
+        }
+    }
+
+    // A footprint which is no longer in the library is dropped
+    std::vector<wxString> names( m_names.begin() + 1, m_names.end() );
+    std::vector<wxString> paths( m_paths.begin() + 1, m_paths.end() );
+
+    index.Sync( names, paths );
+
+    BOOST_CHECK( !index.Find( m_names[0] ) );
+}
+
+
+/**
+ * A truncated or overwritten index is not read, and the library is parsed again in full
+ */
+BOOST_AUTO_TEST_CASE( DamagedIndex )
+{
+    writeIndex();
+
+    wxString    indexFile = FP_LIB_INDEX::IndexFileName( m_libPath );
+    std::string data = readFile( indexFile );
+
+    BOOST_REQUIRE( data.size() > 16 );
+
+    for( const std::string& damaged : { data.substr( 0, data.size() - 3 ),
+                                        data.substr( 0, 10 ),
+                                        std::string( data.size(), 'x' ) } )
+    {
+        BOOST_TEST_CONTEXT( "Index of " << damaged.size() << " bytes" )
+        {
+            writeFile( indexFile, damaged );
+
+            FP_LIB_INDEX index( m_libPath );
+
+            BOOST_CHECK( !index.Load() );
+            BOOST_CHECK( !index.Find( m_names[0] ) );
+
+            PCB_IO        io;
+            wxArrayString names;
+            unsigned      padCount = 0;
+            unsigned      uniquePadCount = 0;
+            wxString      keywords;
+            wxString      doc;
+
+            BOOST_CHECK_NO_THROW( io.FootprintEnumerate( names, m_libPath, false ) );
+            BOOST_CHECK_EQUAL( names.size(), m_names.size() );
+            BOOST_CHECK( io.GetFootprintInfo( m_libPath, m_names[0], padCount, uniquePadCount,
+                                              keywords, doc ) );
+        }
+    }
+
+    // The enumeration above wrote a good index again
+    FP_LIB_INDEX index( m_libPath );
+
+    BOOST_CHECK( index.Load() );
+}
+
+
+/**
+ * A footprint which was only listed from the index, and cannot be parsed when it is first
+ * used, reports the parse error instead of being returned
+ */
+BOOST_AUTO_TEST_CASE( MalformedLazyFootprint )
+{
+    writeIndex();
+
+    // Damage the file without changing its size or time, so the index still trusts it
+    wxFileName  broken( m_paths[0] );
+    wxDateTime  modified = broken.GetModificationTime();
+    std::string data = readFile( broken.GetFullPath() );
+
+    BOOST_REQUIRE( !data.empty() && data[0] == '(' );
+    data[0] = '{';
+
+    writeFile( broken.GetFullPath(), data );
+    BOOST_REQUIRE( broken.SetTimes( nullptr, &modified, nullptr ) );
+
+    PCB_IO        io;
+    wxArrayString names;
+
+    BOOST_CHECK_NO_THROW( io.FootprintEnumerate( names, m_libPath, false ) );
+    BOOST_CHECK_EQUAL( names.size(), m_names.size() );
+
+    BOOST_CHECK_THROW( io.GetEnumeratedFootprint( m_libPath, m_names[0] ), IO_ERROR );
+
+    // Still not returned on a second try, and the other footprints are not affected
+    BOOST_CHECK_THROW( io.GetEnumeratedFootprint( m_libPath, m_names[0] ), IO_ERROR );
+    BOOST_CHECK( io.GetEnumeratedFootprint( m_libPath, m_names[1] ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
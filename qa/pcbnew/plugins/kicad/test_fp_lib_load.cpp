@@ -0,0 +1,141 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <plugins/kicad/fp_lib_index.h>
+#include <plugins/kicad/kicad_plugin.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+/**
+ * What a footprint library load gives: the footprint names, each footprint as it is written
+ * back, and the error reported for the files which could not be read.
+ */
+struct LIBRARY_LOAD
+{
+    std::vector<wxString>    m_names;
+    std::vector<std::string> m_footprints;
+    wxString                 m_error;
+};
+
+
+static LIBRARY_LOAD loadLibrary( const wxString& aLibPath, bool aParallel )
+{
+    LIBRARY_LOAD  result;
+    wxArrayString names;
+
+    // Without an index every footprint file is parsed when the library is enumerated.
+    wxRemoveFile( FP_LIB_INDEX::IndexFileName( aLibPath ) );
+
+    PCB_IO io;
+    io.SetParallelLoad( aParallel );
+
+    try
+    {
+        io.FootprintEnumerate( names, aLibPath, false );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        result.m_error = ioe.What();
+    }
+
+    for( const wxString& name : names )
+    {
+        std::unique_ptr<FOOTPRINT> footprint( io.FootprintLoad( aLibPath, name, true ) );
+
+        BOOST_REQUIRE( footprint );
+
+        io.Format( footprint.get() );
+        result.m_names.push_back( name );
+        result.m_footprints.push_back( io.GetStringOutput( true ) );
+    }
+
+    return result;
+}
+
+
+BOOST_AUTO_TEST_SUITE( FootprintLibLoad )
+
+
+/**
+ * The footprint files of a library are parsed on several threads, which must give the same
+ * footprints and the same error text, in the same order, as parsing them one by one
+ */
+BOOST_AUTO_TEST_CASE( ParallelSameAsSerial )
+{
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            KI_TEST::GetPcbnewTestDataDir() + "complex_hierarchy.kicad_pcb" );
+
+    BOOST_REQUIRE( board );
+
+    wxFileName tempFile( wxFileName::CreateTempFileName( wxT( "qa_fplib" ) ) );
+    wxString   libPath = tempFile.GetFullPath() + wxT( ".pretty" );
+
+    {
+        PCB_IO io;
+
+        io.FootprintLibCreate( libPath );
+
+        for( FOOTPRINT* footprint : board->Footprints() )
+            io.FootprintSave( libPath, footprint );
+    }
+
+    // Files that fail to parse, interleaved with the good ones
+    for( const wxString& name : { wxT( "aa_broken" ), wxT( "mm_broken" ), wxT( "zz_broken" ) } )
+    {
+        wxFFile file( libPath + wxFileName::GetPathSeparator() + name + wxT( ".kicad_mod" ),
+                      wxT( "w" ) );
+
+        BOOST_REQUIRE( file.IsOpened() );
+        file.Write( wxT( "(footprint " ) + name + wxT( " (layer F.Cu) (pad \"1\" smd" ) );
+    }
+
+    LIBRARY_LOAD serial = loadLibrary( libPath, false );
+    LIBRARY_LOAD parallel = loadLibrary( libPath, true );
+
+    BOOST_CHECK( !serial.m_names.empty() );
+    BOOST_CHECK( !serial.m_error.IsEmpty() );
+    BOOST_CHECK_EQUAL( serial.m_error, parallel.m_error );
+
+    BOOST_REQUIRE_EQUAL( serial.m_names.size(), parallel.m_names.size() );
+
+    for( size_t ii = 0; ii < serial.m_names.size(); ++ii )
+    {
+        BOOST_CHECK_EQUAL( serial.m_names[ii], parallel.m_names[ii] );
+        BOOST_CHECK_EQUAL( serial.m_footprints[ii], parallel.m_footprints[ii] );
+    }
+
+    wxRemoveFile( FP_LIB_INDEX::IndexFileName( libPath ) );
+    PCB_IO().FootprintLibDelete( libPath );
+    wxRemoveFile( tempFile.GetFullPath() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
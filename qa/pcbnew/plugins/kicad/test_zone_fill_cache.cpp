@@ -0,0 +1,278 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <zone.h>
+#include <plugins/kicad/kicad_plugin.h>
+#include <plugins/kicad/pcb_parser.h>
+#include <plugins/kicad/zone_fill_cache.h>
+#include <richio.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+/**
+ * A QA board saved to a temporary file along with its zone fill cache.
+ */
+struct ZONE_FILL_CACHE_FIXTURE
+{
+    void saveBoard( const std::string& aName )
+    {
+        removeFiles();
+
+        m_board = KI_TEST::ReadBoardFromFileOrStream( KI_TEST::GetPcbnewTestDataDir() + aName
+                                                      + ".kicad_pcb" );
+
+        BOOST_REQUIRE( m_board );
+
+        m_fileName = wxFileName::CreateTempFileName( wxT( "qa_zonecache" ) );
+
+        PCB_IO().Save( m_fileName, m_board.get() );
+
+        // Written whatever the ZoneFillCache advanced setting is
+        BOOST_REQUIRE( ZONE_FILL_CACHE::Save( m_board.get(), m_fileName ) );
+    }
+
+    ~ZONE_FILL_CACHE_FIXTURE()
+    {
+        removeFiles();
+    }
+
+    void removeFiles()
+    {
+        if( !m_fileName.IsEmpty() )
+        {
+            wxRemoveFile( ZONE_FILL_CACHE::CacheFileName( m_fileName ) );
+            wxRemoveFile( m_fileName );
+        }
+    }
+
+    /**
+     * Parse the saved board as PCB_IO::Load() does with a cache: the fills held by \a aCache
+     * are skipped and then applied from it.
+     *
+     * @return the number of zone fills taken from the cache.
+     */
+    size_t loadBoard( ZONE_FILL_CACHE& aCache, std::unique_ptr<BOARD>& aBoard )
+    {
+        FILE_LINE_READER reader( m_fileName );
+        PCB_PARSER       parser( &reader );
+
+        parser.SetZoneFillCache( &aCache );
+        aBoard.reset( static_cast<BOARD*>( parser.Parse() ) );
+
+        BOOST_REQUIRE( aBoard );
+
+        aCache.Apply( parser.GetSkippedZoneFills() );
+
+        return parser.GetSkippedZoneFills().size();
+    }
+
+    std::unique_ptr<BOARD> m_board;
+    wxString               m_fileName;
+};
+
+
+/**
+ * Check the zone fills of \a aLoaded are those of \a aSaved.  The fills \a aCache holds must
+ * also come triangulated as \a aSaved was when the cache was written, and with their area.
+ */
+static void checkFills( BOARD* aSaved, BOARD* aLoaded, const ZONE_FILL_CACHE& aCache )
+{
+    BOOST_REQUIRE_EQUAL( aSaved->Zones().size(), aLoaded->Zones().size() );
+
+    for( size_t ii = 0; ii < aSaved->Zones().size(); ++ii )
+    {
+        ZONE* saved = aSaved->Zones()[ii];
+        ZONE* loaded = aLoaded->Zones()[ii];
+
+        BOOST_REQUIRE( saved->m_Uuid == loaded->m_Uuid );
+
+        bool cached = false;
+
+        for( PCB_LAYER_ID layer : saved->GetLayerSet().Seq() )
+        {
+            BOOST_TEST_CONTEXT( "Zone " << ii << " on " << LSET::Name( layer ) )
+            {
+                const SHAPE_POLY_SET& savedFill = saved->GetFilledPolysList( layer );
+                const SHAPE_POLY_SET& loadedFill = loaded->GetFilledPolysList( layer );
+
+                BOOST_REQUIRE_EQUAL( savedFill.OutlineCount(), loadedFill.OutlineCount() );
+                BOOST_CHECK( savedFill.GetHash() == loadedFill.GetHash() );
+
+                for( int jj = 0; jj < savedFill.OutlineCount(); ++jj )
+                {
+                    BOOST_CHECK_EQUAL( saved->IsIsland( layer, jj ),
+                                       loaded->IsIsland( layer, jj ) );
+                }
+
+                if( !aCache.Contains( saved->m_Uuid, layer ) )
+                    continue;
+
+                cached = true;
+
+                BOOST_REQUIRE( loadedFill.IsTriangulationUpToDate() );
+                BOOST_REQUIRE_EQUAL( savedFill.TriangulatedPolyCount(),
+                                     loadedFill.TriangulatedPolyCount() );
+
+                for( unsigned kk = 0; kk < savedFill.TriangulatedPolyCount(); ++kk )
+                {
+                    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* a =
+                            savedFill.TriangulatedPolygon( kk );
+                    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* b =
+                            loadedFill.TriangulatedPolygon( kk );
+
+                    BOOST_CHECK( a->Vertices() == b->Vertices() );
+                    BOOST_REQUIRE_EQUAL( a->GetTriangleCount(), b->GetTriangleCount() );
+
+                    for( size_t tt = 0; tt < a->GetTriangleCount(); ++tt )
+                    {
+                        BOOST_CHECK_EQUAL( a->Triangles()[tt].a, b->Triangles()[tt].a );
+                        BOOST_CHECK_EQUAL( a->Triangles()[tt].b, b->Triangles()[tt].b );
+                        BOOST_CHECK_EQUAL( a->Triangles()[tt].c, b->Triangles()[tt].c );
+                    }
+                }
+            }
+        }
+
+        // Apply() recalculates the area from the cached fills
+        if( cached )
+            BOOST_CHECK_CLOSE( saved->CalculateFilledArea(), loaded->GetFilledArea(), 1e-6 );
+    }
+}
+
+
+static std::string readFile( const wxString& aPath )
+{
+    wxFFile     file( aPath, wxT( "rb" ) );
+    std::string data( (size_t) file.Length(), '\0' );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    BOOST_REQUIRE( file.Read( &data[0], data.size() ) == data.size() );
+
+    return data;
+}
+
+
+static void writeFile( const wxString& aPath, const std::string& aData )
+{
+    wxFFile file( aPath, wxT( "wb" ) );
+
+    BOOST_REQUIRE( file.IsOpened() );
+    BOOST_REQUIRE( file.Write( aData.data(), aData.size() ) );
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFillCache, ZONE_FILL_CACHE_FIXTURE )
+
+
+/**
+ * Fills reloaded from the cache are the saved fills, with their islands, triangulation and
+ * filled area
+ */
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    // issue6284 has island fills
+    for( const std::string& name : { "issue6284", "issue3812" } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            saveBoard( name );
+
+            ZONE_FILL_CACHE        cache;
+            std::unique_ptr<BOARD> loaded;
+
+            BOOST_REQUIRE( cache.Load( m_fileName ) );
+            BOOST_CHECK( loadBoard( cache, loaded ) > 0 );
+
+            checkFills( m_board.get(), loaded.get(), cache );
+        }
+    }
+}
+
+
+/**
+ * A cache which does not belong to the board file, or is truncated, is not read, and the
+ * fills are parsed from the board file instead
+ */
+BOOST_AUTO_TEST_CASE( StaleOrTruncated )
+{
+    saveBoard( "issue6284" );
+
+    wxString    cacheFile = ZONE_FILL_CACHE::CacheFileName( m_fileName );
+    std::string cacheData = readFile( cacheFile );
+    std::string boardData = readFile( m_fileName );
+
+    BOOST_REQUIRE( cacheData.size() > 100 );
+
+    auto checkIgnored =
+            [&]()
+            {
+                ZONE_FILL_CACHE        cache;
+                std::unique_ptr<BOARD> loaded;
+
+                BOOST_CHECK( !cache.Load( m_fileName ) );
+
+                for( ZONE* zone : m_board->Zones() )
+                {
+                    for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                        BOOST_CHECK( !cache.Contains( zone->m_Uuid, layer ) );
+                }
+
+                BOOST_CHECK_EQUAL( loadBoard( cache, loaded ), 0 );
+                checkFills( m_board.get(), loaded.get(), cache );
+            };
+
+    // The board file changed after the cache was written
+    BOOST_TEST_CONTEXT( "Stale" )
+    {
+        writeFile( m_fileName, boardData + "\n" );
+        checkIgnored();
+        writeFile( m_fileName, boardData );
+    }
+
+    // Cut in the header, and in the middle and at the end of the entries
+    for( size_t length : { (size_t) 20, cacheData.size() / 2, cacheData.size() - 1 } )
+    {
+        BOOST_TEST_CONTEXT( "Truncated to " << length << " bytes" )
+        {
+            writeFile( cacheFile, cacheData.substr( 0, length ) );
+            checkIgnored();
+        }
+    }
+
+    // Restored, the cache is read again
+    writeFile( cacheFile, cacheData );
+
+    ZONE_FILL_CACHE cache;
+
+    BOOST_CHECK( cache.Load( m_fileName ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <pcb_track.h>
+#include <plugins/kicad/kicad_plugin.h>
+#include <richio.h>
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+BOOST_AUTO_TEST_SUITE( BoardFileGzip )
+
+
+/**
+ * Boards saved under a ".gz" name, or under the temporary name an editor save writes first,
+ * are compressed and read back
+ */
+BOOST_AUTO_TEST_CASE( SaveAndLoadCompressed )
+{
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            KI_TEST::GetPcbnewTestDataDir() + "complex_hierarchy.kicad_pcb" );
+
+    BOOST_REQUIRE( board );
+
+    wxFileName dir( wxFileName::CreateTempFileName( wxT( "qa_gzip" ) ) );
+
+    // Named as in PCB_EDIT_FRAME::SavePcbFile()
+    for( const wxString& name : { wxT( "board.kicad_pcb.gz" ), wxT( ".board.kicad_pcb.gz$" ) } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            wxString fileName = dir.GetPathWithSep() + name;
+            PCB_IO   io;
+
+            io.Save( fileName, board.get() );
+
+            BOOST_CHECK( GZIP_FILE_LINE_READER::IsGzipFile( fileName ) );
+
+            std::unique_ptr<BOARD> loaded( io.Load( fileName, nullptr ) );
+
+            BOOST_REQUIRE( loaded );
+            BOOST_CHECK_EQUAL( loaded->Footprints().size(), board->Footprints().size() );
+            BOOST_CHECK_EQUAL( loaded->Tracks().size(), board->Tracks().size() );
+            BOOST_CHECK_EQUAL( loaded->Zones().size(), board->Zones().size() );
+            BOOST_CHECK_EQUAL( loaded->GetNetCount(), board->GetNetCount() );
+
+            wxRemoveFile( fileName );
+        }
+    }
+
+    wxRemoveFile( dir.GetFullPath() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,161 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <macros.h>
+#include <md5_hash.h>
+#include <netinfo.h>
+#include <pcb_group.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <plugins/kicad/pcb_parser.h>
+#include <richio.h>
+
+
+/**
+ * Parse a board from the QA data directory, on worker threads or not.
+ */
+static std::unique_ptr<BOARD> parseBoard( const std::string& aName, bool aParallel )
+{
+    FILE_LINE_READER reader( KI_TEST::GetPcbnewTestDataDir() + aName + ".kicad_pcb" );
+    PCB_PARSER       parser( &reader );
+
+    parser.SetParallelLoad( aParallel );
+
+    return std::unique_ptr<BOARD>( static_cast<BOARD*>( parser.Parse() ) );
+}
+
+
+/**
+ * Describe an item by what the parser reads into it, including the net and the zone fills.
+ */
+static std::string describe( BOARD_ITEM* aItem )
+{
+    std::string desc = TO_UTF8( aItem->GetClass() );
+
+    desc += " " + aItem->GetLayerSet().FmtHex();
+    desc += TO_UTF8( wxString::Format( " %d,%d", aItem->GetPosition().x,
+                                       aItem->GetPosition().y ) );
+
+    if( BOARD_CONNECTED_ITEM* cItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
+    {
+        desc += TO_UTF8( wxString::Format( " net %d '%s'", cItem->GetNetCode(),
+                                           cItem->GetNetname() ) );
+    }
+
+    if( ZONE* zone = dynamic_cast<ZONE*>( aItem ) )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            MD5_HASH hash = zone->GetFilledPolysList( layer ).GetHash();
+
+            desc += " fill " + hash.Format( true );
+        }
+    }
+
+    return desc;
+}
+
+
+/**
+ * List every item of \a aBoard, footprint children included, as KIID and description in
+ * board order.
+ */
+static std::vector<std::pair<wxString, std::string>> listItems( BOARD* aBoard )
+{
+    std::vector<std::pair<wxString, std::string>> items;
+
+    auto add =
+            [&]( BOARD_ITEM* aItem )
+            {
+                items.emplace_back( aItem->m_Uuid.AsString(), describe( aItem ) );
+            };
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        add( footprint );
+        footprint->RunOnChildren( add );
+    }
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+        add( track );
+
+    for( ZONE* zone : aBoard->Zones() )
+        add( zone );
+
+    for( BOARD_ITEM* drawing : aBoard->Drawings() )
+        add( drawing );
+
+    for( PCB_GROUP* group : aBoard->Groups() )
+        add( group );
+
+    return items;
+}
+
+
+BOOST_AUTO_TEST_SUITE( BoardParallelLoad )
+
+
+BOOST_AUTO_TEST_CASE( SameAsSerialLoad )
+{
+    // Boards large enough to be split into several batches of deferred items
+    for( const std::string& name : { "issue3812", "issue6284", "complex_hierarchy" } )
+    {
+        BOOST_TEST_CONTEXT( name )
+        {
+            std::unique_ptr<BOARD> serial = parseBoard( name, false );
+            std::unique_ptr<BOARD> parallel = parseBoard( name, true );
+
+            BOOST_REQUIRE( serial && parallel );
+
+            std::vector<std::pair<wxString, std::string>> serialItems = listItems( serial.get() );
+            std::vector<std::pair<wxString, std::string>> parallelItems =
+                    listItems( parallel.get() );
+
+            BOOST_REQUIRE_EQUAL( serialItems.size(), parallelItems.size() );
+
+            for( size_t ii = 0; ii < serialItems.size(); ++ii )
+            {
+                BOOST_CHECK_EQUAL( serialItems[ii].first, parallelItems[ii].first );
+                BOOST_CHECK_EQUAL( serialItems[ii].second, parallelItems[ii].second );
+            }
+
+            BOOST_REQUIRE_EQUAL( serial->GetNetCount(), parallel->GetNetCount() );
+
+            for( NETINFO_ITEM* net : serial->GetNetInfo() )
+            {
+                NETINFO_ITEM* other = parallel->FindNet( net->GetNetCode() );
+
+                BOOST_REQUIRE( other );
+                BOOST_CHECK_EQUAL( net->GetNetname(), other->GetNetname() );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <qa/pcbnew/board_test_utils.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_data.h>
+#include <settings/settings_manager.h>
+
+
+struct RATSNEST_TEST_FIXTURE
+{
+    RATSNEST_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( IncrementalUpdateAfterTrackDeletion, RATSNEST_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue832", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    // Use the net with the most tracks, which is large enough to be updated incrementally
+    std::map<int, std::vector<PCB_TRACK*>> netTracks;
+    int                                    bigNet = 0;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() == PCB_TRACE_T && track->GetNetCode() > 0 )
+            netTracks[ track->GetNetCode() ].push_back( track );
+    }
+
+    for( const std::pair<const int, std::vector<PCB_TRACK*>>& entry : netTracks )
+    {
+        if( !bigNet || entry.second.size() > netTracks[ bigNet ].size() )
+            bigNet = entry.first;
+    }
+
+    BOOST_REQUIRE( bigNet > 0 );
+
+    std::vector<PCB_TRACK*>                 tracks = netTracks[ bigNet ];
+    std::vector<std::unique_ptr<PCB_TRACK>> removed;
+    int                                     splits = 0;
+
+    for( size_t ii = 0; ii < tracks.size() && removed.size() < 8; ii += 7 )
+    {
+        unsigned int before = connectivity->GetUnconnectedCount();
+
+        m_board->Remove( tracks[ii] );
+        removed.emplace_back( tracks[ii] );
+        connectivity->RecalculateRatsnest();
+
+        CONNECTIVITY_DATA fresh;
+        fresh.Build( m_board.get() );
+        fresh.RecalculateRatsnest();
+
+        BOOST_TEST_CONTEXT( "Deleted track " << ii )
+        {
+            BOOST_CHECK_EQUAL( connectivity->GetUnconnectedCount(),
+                               fresh.GetUnconnectedCount() );
+        }
+
+        if( connectivity->GetUnconnectedCount() > before )
+            splits++;
+    }
+
+    // At least one of the deleted tracks must have split a cluster, needing a new airwire
+    BOOST_CHECK( splits > 0 );
+}
@@ -0,0 +1,433 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file drc_tool.cpp
+ * Headless DRC runner: loads a board (and optionally its project and custom rules), refills
+ * the zones, runs all DRC test providers and reports the violations together with the
+ * per-provider run-time statistics.  Exits with a non-zero code when there are violations.
+ *
+ * This is a QA utility, run as "qa_pcbnew_tools drc [options] <board>" from the build tree.
+ * It is only built with KICAD_BUILD_QA_TESTS or as the qa_pcbnew_tools target, and is not
+ * installed, so a CI pipeline using it has to build KiCad itself.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <macros.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <board_commit.h>
+#include <board_design_settings.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_rule.h>
+#include <settings/settings_manager.h>
+#include <tool/tool_manager.h>
+#include <widgets/ui_common.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+#include <zone_filler.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+#include <qa_utils/utility_registry.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "rules", _( "custom design rules file (.kicad_dru)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "p", "project", _( "project file (.kicad_pro)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "f", "format", _( "report format: 'text' (default) or 'json'" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "o", "output", _( "report file (default: stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_SWITCH, "n", "no-refill", _( "do not refill zones before testing" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "a", "all-track-errors", _( "report all errors for each track" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "P", "profile-rules", _( "report the evaluation cost of each rule" ).mb_str() },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board file (.kicad_pcb)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MANDATORY },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum DRC_RET_CODES
+{
+    DRC_VIOLATIONS_FOUND = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    DRC_LOAD_FAILED,
+    DRC_RULES_INVALID,
+    DRC_REPORT_FAILED
+};
+
+
+/**
+ * A violation as collected from the DRC engine, together with the severity it had at the
+ * time of the run.
+ */
+struct DRC_TOOL_VIOLATION
+{
+    std::shared_ptr<DRC_ITEM> m_item;
+    wxPoint                   m_pos;
+    SEVERITY                  m_severity;
+};
+
+
+/**
+ * Fill all the board zones, the same way ZONE_FILLER_TOOL::FillAllZones() does in the GUI.
+ */
+static void fillZones( BOARD* aBoard )
+{
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( aBoard, nullptr, nullptr, nullptr, nullptr );
+
+    BOARD_COMMIT       commit( &toolMgr );
+    ZONE_FILLER        filler( aBoard, &commit );
+    std::vector<ZONE*> toFill;
+
+    for( ZONE* zone : aBoard->Zones() )
+        toFill.push_back( zone );
+
+    if( filler.Fill( toFill ) )
+        commit.Push( _( "Fill Zone(s)" ), false, false );
+}
+
+
+static std::string formatText( BOARD* aBoard, const std::vector<DRC_TOOL_VIOLATION>& aViolations,
+                               DRC_ENGINE& aEngine, double aFillTime, double aTotalTime )
+{
+    std::map<KIID, EDA_ITEM*> itemMap;
+    aBoard->FillItemMap( itemMap );
+
+    wxString out;
+
+    out << wxString::Format( "** Drc report for %s **\n", aBoard->GetFileName() );
+    out << wxString::Format( "\n** Found %d DRC violations **\n", (int) aViolations.size() );
+
+    for( const DRC_TOOL_VIOLATION& violation : aViolations )
+    {
+        out << violation.m_item->ShowReport( EDA_UNITS::MILLIMETRES, violation.m_severity,
+                                             itemMap );
+    }
+
+    out << "\n** Test provider statistics **\n";
+    out << wxString::Format( "%-32s %12s %10s %10s %14s\n",
+                             "provider", "time (ms)", "items", "errors", "EvalRules()" );
+
+    for( const DRC_PROVIDER_STATS& stats : aEngine.GetProviderStats() )
+    {
+        out << wxString::Format( "%-32s %12.2f %10d %10d %14llu\n",
+                                 stats.m_Name,
+                                 stats.m_WallTime,
+                                 stats.m_ItemCount,
+                                 stats.m_ViolationCount,
+                                 (unsigned long long) stats.m_EvalRulesCount );
+    }
+
+    std::vector<DRC_RULE_STATS> ruleStats = aEngine.GetRuleStats();
+
+    if( !ruleStats.empty() )
+    {
+        out << "\n** Rule evaluation cost **\n";
+        out << wxString::Format( "%-32s %14s %14s %12s\n",
+                                 "rule", "evaluations", "matches", "time (ms)" );
+
+        for( const DRC_RULE_STATS& stats : ruleStats )
+        {
+            out << wxString::Format( "%-32s %14llu %14llu %12.3f\n",
+                                     stats.m_Name,
+                                     (unsigned long long) stats.m_EvalCount,
+                                     (unsigned long long) stats.m_MatchCount,
+                                     stats.m_EvalTime );
+        }
+    }
+
+    out << wxString::Format( "\nZone fill: %.2f ms; total: %.2f ms; EvalRules() calls: %llu\n",
+                             aFillTime,
+                             aTotalTime,
+                             (unsigned long long) aEngine.GetEvalRulesCount() );
+
+    out << "\n** End of Report **\n";
+
+    return std::string( out.ToUTF8() );
+}
+
+
+static std::string formatJson( BOARD* aBoard, const std::vector<DRC_TOOL_VIOLATION>& aViolations,
+                               DRC_ENGINE& aEngine, double aFillTime, double aTotalTime )
+{
+    nlohmann::json js;
+    nlohmann::json violations = nlohmann::json::array();
+    nlohmann::json providers = nlohmann::json::array();
+
+    auto itemDesc =
+            [&]( const KIID& aId ) -> nlohmann::json
+            {
+                nlohmann::json item;
+                BOARD_ITEM*    boardItem = aBoard->GetItem( aId );
+
+                item["uuid"] = TO_UTF8( aId.AsString() );
+
+                if( boardItem )
+                {
+                    wxPoint pos = boardItem->GetPosition();
+
+                    item["description"] =
+                            TO_UTF8( boardItem->GetSelectMenuText( EDA_UNITS::MILLIMETRES ) );
+                    item["pos"] = { { "x", pos.x / IU_PER_MM }, { "y", pos.y / IU_PER_MM } };
+                }
+
+                return item;
+            };
+
+    for( const DRC_TOOL_VIOLATION& violation : aViolations )
+    {
+        const std::shared_ptr<DRC_ITEM>& drcItem = violation.m_item;
+        nlohmann::json                   entry;
+        nlohmann::json                   items = nlohmann::json::array();
+
+        entry["type"] = TO_UTF8( drcItem->GetSettingsKey() );
+        entry["code"] = drcItem->GetErrorCode();
+        entry["severity"] = TO_UTF8( SeverityToString( violation.m_severity ) );
+        entry["description"] = TO_UTF8( drcItem->GetErrorMessage() );
+        entry["pos"] = { { "x", violation.m_pos.x / IU_PER_MM },
+                         { "y", violation.m_pos.y / IU_PER_MM } };
+
+        if( drcItem->GetViolatingRule() )
+            entry["rule"] = TO_UTF8( drcItem->GetViolatingRule()->m_Name );
+
+        if( drcItem->GetViolatingTest() )
+            entry["provider"] = TO_UTF8( drcItem->GetViolatingTest()->GetName() );
+
+        if( drcItem->GetMainItemID() != niluuid )
+            items.push_back( itemDesc( drcItem->GetMainItemID() ) );
+
+        if( drcItem->GetAuxItemID() != niluuid )
+            items.push_back( itemDesc( drcItem->GetAuxItemID() ) );
+
+        entry["items"] = items;
+        violations.push_back( entry );
+    }
+
+    for( const DRC_PROVIDER_STATS& stats : aEngine.GetProviderStats() )
+    {
+        providers.push_back( { { "name", TO_UTF8( stats.m_Name ) },
+                               { "time_ms", stats.m_WallTime },
+                               { "items", stats.m_ItemCount },
+                               { "violations", stats.m_ViolationCount },
+                               { "eval_rules_calls", stats.m_EvalRulesCount } } );
+    }
+
+    if( aEngine.GetRuleProfiling() )
+    {
+        nlohmann::json rules = nlohmann::json::array();
+
+        for( const DRC_RULE_STATS& stats : aEngine.GetRuleStats() )
+        {
+            rules.push_back( { { "name", TO_UTF8( stats.m_Name ) },
+                               { "condition", TO_UTF8( stats.m_Condition ) },
+                               { "implicit", stats.m_Implicit },
+                               { "evaluations", stats.m_EvalCount },
+                               { "matches", stats.m_MatchCount },
+                               { "time_ms", stats.m_EvalTime } } );
+        }
+
+        js["rules"] = rules;
+    }
+
+    js["source"] = TO_UTF8( aBoard->GetFileName() );
+    js["coordinate_units"] = "mm";
+    js["violations"] = violations;
+    js["providers"] = providers;
+    js["zone_fill_time_ms"] = aFillTime;
+    js["total_time_ms"] = aTotalTime;
+    js["eval_rules_calls"] = aEngine.GetEvalRulesCount();
+
+    return js.dump( 2 ) + "\n";
+}
+
+
+int drc_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program runs the design rule checks on a KiCad PCB file without the "
+               "graphical user interface.  It exits with a non-zero code if any violation "
+               "is found." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString format = "text";
+    wxString outputPath;
+    wxString rulesPath;
+    wxString projectPath;
+
+    cl_parser.Found( "format", &format );
+    cl_parser.Found( "output", &outputPath );
+
+    if( format != "text" && format != "json" )
+    {
+        std::cerr << "Unknown report format: " << format << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxFileName boardFile( cl_parser.GetParam( 0 ) );
+    boardFile.MakeAbsolute();
+
+    if( !cl_parser.Found( "project", &projectPath ) )
+    {
+        wxFileName proFile( boardFile );
+        proFile.SetExt( ProjectFileExtension );
+
+        if( proFile.FileExists() )
+            projectPath = proFile.GetFullPath();
+    }
+
+    if( !cl_parser.Found( "rules", &rulesPath ) )
+    {
+        wxFileName ruleFile( boardFile );
+        ruleFile.SetExt( DesignRulesFileExtension );
+
+        if( ruleFile.FileExists() )
+            rulesPath = ruleFile.GetFullPath();
+    }
+
+    PROF_COUNTER totalTimer;
+
+    SETTINGS_MANAGER settingsManager( true /* headless */ );
+
+    if( !projectPath.IsEmpty() )
+        settingsManager.LoadProject( projectPath );
+
+    std::unique_ptr<BOARD> board =
+            KI_TEST::ReadBoardFromFileOrStream( std::string( boardFile.GetFullPath().ToUTF8() ) );
+
+    if( !board )
+    {
+        std::cerr << "Failed to load board: " << boardFile.GetFullPath() << std::endl;
+        return DRC_LOAD_FAILED;
+    }
+
+    board->SetFileName( boardFile.GetFullPath() );
+
+    if( !projectPath.IsEmpty() )
+        board->SetProject( &settingsManager.Prj() );
+
+    board->BuildConnectivity();
+
+    BOARD_DESIGN_SETTINGS&      bds = board->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = std::make_shared<DRC_ENGINE>( board.get(), &bds );
+
+    bds.m_DRCEngine = drcEngine;
+
+    try
+    {
+        drcEngine->InitEngine( rulesPath.IsEmpty() ? wxFileName() : wxFileName( rulesPath ) );
+    }
+    catch( PARSE_ERROR& pe )
+    {
+        std::cerr << "Invalid design rules: " << pe.What() << std::endl;
+        return DRC_RULES_INVALID;
+    }
+
+    double fillTime = 0.0;
+
+    if( !cl_parser.Found( "no-refill" ) )
+    {
+        PROF_COUNTER fillTimer;
+        fillZones( board.get() );
+        fillTime = fillTimer.msecs();
+    }
+
+    drcEngine->SetRuleProfiling( cl_parser.Found( "profile-rules" ) );
+
+    std::vector<DRC_TOOL_VIOLATION> violations;
+
+    drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, wxPoint aPos )
+            {
+                SEVERITY severity = bds.GetSeverity( aItem->GetErrorCode() );
+
+                if( severity != RPT_SEVERITY_IGNORE )
+                    violations.push_back( { aItem, aPos, severity } );
+            } );
+
+    drcEngine->RunTests( EDA_UNITS::MILLIMETRES, cl_parser.Found( "all-track-errors" ), false );
+    drcEngine->ClearViolationHandler();
+
+    double      totalTime = totalTimer.msecs();
+    std::string report;
+
+    if( format == "json" )
+        report = formatJson( board.get(), violations, *drcEngine, fillTime, totalTime );
+    else
+        report = formatText( board.get(), violations, *drcEngine, fillTime, totalTime );
+
+    if( outputPath.IsEmpty() )
+    {
+        std::cout << report;
+    }
+    else
+    {
+        std::ofstream out( outputPath.ToStdString() );
+
+        if( !out )
+        {
+            std::cerr << "Failed to write report: " << outputPath << std::endl;
+            return DRC_REPORT_FAILED;
+        }
+
+        out << report;
+    }
+
+    // The board must not outlive the project owned by the settings manager
+    board->SetProject( nullptr );
+
+    if( !violations.empty() )
+        return DRC_VIOLATIONS_FOUND;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register(
+        { "drc", "Run the design rule checks on a KiCad PCB file", drc_main_func } );